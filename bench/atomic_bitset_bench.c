@@ -0,0 +1,195 @@
+/*******************************************************************************
+***************************** - ATOMIC BIT SET - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of slot claims / sec from 1 to N threads:
+*					mutex around a bit set, packed and padded atomic bit sets
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/atomic_bitset.c src/bitset.c src/bitarray.c
+*					bench/atomic_bitset_bench.c -I ./include -I ../ -pthread
+*	RUN				./a.out [max_threads]
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* clock_gettime */
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* atoi */
+#include <pthread.h>	/* pthread_create, pthread_join, pthread_mutex_t */
+#include <time.h>		/* clock_gettime */
+
+#include "bitset.h"
+#include "atomic_bitset.h"
+
+#define SLOTS_NUM			4096LU
+#define CLAIMS_PER_THREAD	1000000LU
+#define HELD_SLOTS			8			/* slots each thread holds at a time */
+#define MAX_THREADS			64
+#define DEFAULT_THREADS		16
+
+typedef enum variant { LOCKED, PACKED, PADDED } variant_ty;
+
+typedef struct locked_bitset
+{
+	bitset_ty *m_bitset;
+	pthread_mutex_t m_lock;
+} locked_bitset_ty;
+
+typedef struct worker
+{
+	variant_ty m_variant;
+	void *m_set;
+	size_t m_hint;
+} worker_ty;
+
+static double RunIMP(variant_ty variant_, void *set_, size_t n_threads_);
+static void *WorkerIMP(void *param_);
+static size_t ClaimIMP(const worker_ty *worker_);
+static void ReleaseIMP(const worker_ty *worker_, size_t slot_);
+
+
+int main(int argc, char *argv[])
+{
+	locked_bitset_ty locked;
+	atomic_bitset_ty *packed = AtomicBitSetCreate(SLOTS_NUM, ATOMIC_BITSET_PACKED);
+	atomic_bitset_ty *padded = AtomicBitSetCreate(SLOTS_NUM, ATOMIC_BITSET_PADDED);
+	size_t max_threads = (argc > 1) ? (size_t)atoi(argv[1]) : DEFAULT_THREADS;
+	size_t n_threads = 0;
+
+	locked.m_bitset = BitSetCreate(SLOTS_NUM);
+	pthread_mutex_init(&locked.m_lock, NULL);
+
+	if (NULL == packed || NULL == padded || NULL == locked.m_bitset)
+	{
+		puts("Memory Allocation Failed");
+		return 1;
+	}
+
+	if (0 == max_threads || max_threads > MAX_THREADS)
+	{
+		max_threads = MAX_THREADS;
+	}
+
+	printf("\n\t--- Bench Atomic Bit Set (%lu slots, %lu claims per thread) ---\n\n",
+	       SLOTS_NUM, CLAIMS_PER_THREAD);
+	puts("threads\t  mutex Mclaims/s\t packed Mclaims/s\t padded Mclaims/s");
+
+	for (n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+	{
+		printf("%lu\t%18.2f\t%18.2f\t%18.2f\n", n_threads,
+		       RunIMP(LOCKED, &locked, n_threads),
+		       RunIMP(PACKED, packed, n_threads),
+		       RunIMP(PADDED, padded, n_threads));
+	}
+
+	pthread_mutex_destroy(&locked.m_lock);
+	BitSetDestroy(locked.m_bitset);
+	AtomicBitSetDestroy(packed);
+	AtomicBitSetDestroy(padded);
+
+	return 0;
+}
+
+
+/* Returns millions of claims per second */
+static double RunIMP(variant_ty variant_, void *set_, size_t n_threads_)
+{
+	pthread_t threads[MAX_THREADS];
+	worker_ty workers[MAX_THREADS];
+	struct timespec start;
+	struct timespec end;
+	double seconds = 0;
+	size_t i = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		workers[i].m_variant = variant_;
+		workers[i].m_set = set_;
+		workers[i].m_hint = i * SLOTS_NUM / n_threads_;
+		pthread_create(&threads[i], NULL, WorkerIMP, &workers[i]);
+	}
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	seconds = (double)(end.tv_sec - start.tv_sec) + 
+	          (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	return (double)(n_threads_ * CLAIMS_PER_THREAD) / seconds / 1e6;
+}
+
+
+/* Claim a slot, release the one claimed HELD_SLOTS claims ago */
+static void *WorkerIMP(void *param_)
+{
+	worker_ty *worker = (worker_ty *)param_;
+	size_t held[HELD_SLOTS];
+	size_t i = 0;
+
+	for (i = 0; i < HELD_SLOTS; ++i)
+	{
+		held[i] = ClaimIMP(worker);
+	}
+
+	for (i = HELD_SLOTS; i < CLAIMS_PER_THREAD; ++i)
+	{
+		ReleaseIMP(worker, held[i % HELD_SLOTS]);
+		held[i % HELD_SLOTS] = ClaimIMP(worker);
+	}
+
+	for (i = 0; i < HELD_SLOTS; ++i)
+	{
+		ReleaseIMP(worker, held[i]);
+	}
+
+	return NULL;
+}
+
+
+static size_t ClaimIMP(const worker_ty *worker_)
+{
+	locked_bitset_ty *locked = NULL;
+	size_t slot = 0;
+
+	if (LOCKED != worker_->m_variant)
+	{
+		return AtomicBitSetClaimFrom((atomic_bitset_ty *)worker_->m_set, worker_->m_hint);
+	}
+
+	locked = (locked_bitset_ty *)worker_->m_set;
+
+	pthread_mutex_lock(&locked->m_lock);
+	slot = BitSetFindNextClear(locked->m_bitset, worker_->m_hint);
+	if (SLOTS_NUM == slot)
+	{
+		slot = BitSetFindFirstClear(locked->m_bitset);
+	}
+	BitSetSetOn(locked->m_bitset, slot);
+	pthread_mutex_unlock(&locked->m_lock);
+
+	return slot;
+}
+
+
+static void ReleaseIMP(const worker_ty *worker_, size_t slot_)
+{
+	locked_bitset_ty *locked = NULL;
+
+	if (LOCKED != worker_->m_variant)
+	{
+		AtomicBitSetRelease((atomic_bitset_ty *)worker_->m_set, slot_);
+		return;
+	}
+
+	locked = (locked_bitset_ty *)worker_->m_set;
+
+	pthread_mutex_lock(&locked->m_lock);
+	BitSetSetOff(locked->m_bitset, slot_);
+	pthread_mutex_unlock(&locked->m_lock);
+}
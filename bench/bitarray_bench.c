@@ -0,0 +1,151 @@
+/*******************************************************************************
+****************************** - BIT ARRAY -  **********************************
+***************************** Data Structures **********************************
+*
+*	DESCRIPTION		Benchmark of the BitArrCountOn / BitArrMirror backends
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/bitarray.c bench/bitarray_bench.c -I ./include -I ../
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* malloc, free */
+#include <time.h>		/* clock */
+
+#include "bitarray.h"
+
+#define WORDS_TOTAL		100000000LU		/* 1e8 words per variant */
+#define BUFFER_WORDS	(1LU << 16)		/* 512KB, stays in L2 */
+#define BIT_ARR_SIZE	64
+
+typedef size_t (*count_func_ty)(bit_array_ty bit_arr);
+typedef bit_array_ty (*mirror_func_ty)(bit_array_ty bit_arr);
+
+static void FillRandomIMP(bit_array_ty *words_, size_t n_words_);
+static void BenchCountIMP(const char *name_, count_func_ty count_, const bit_array_ty *words_);
+static void BenchMirrorIMP(const char *name_, mirror_func_ty mirror_, const bit_array_ty *words_);
+
+/* The bit by bit versions, as a baseline */
+static size_t CountOnLoopIMP(bit_array_ty bit_arr_);
+static bit_array_ty MirrorLoopIMP(bit_array_ty bit_arr_);
+
+
+int main(void)
+{
+	bit_array_ty *words = (bit_array_ty *)malloc(BUFFER_WORDS * sizeof(bit_array_ty));
+
+	if (NULL == words)
+	{
+		puts("Memory Allocation Failed");
+		return 1;
+	}
+
+	FillRandomIMP(words, BUFFER_WORDS);
+
+	printf("\n\t--- Bench BitArray (%lu words, backend: %s) ---\n\n", 
+	       WORDS_TOTAL, BitArrBackend());
+
+	BenchCountIMP("CountOn loop", CountOnLoopIMP, words);
+	BenchCountIMP("CountOn LUT", BitArrCountOnLUT, words);
+	BenchCountIMP("CountOn dispatch", BitArrCountOn, words);
+
+	BenchMirrorIMP("Mirror loop", MirrorLoopIMP, words);
+	BenchMirrorIMP("Mirror LUT", BitArrMirrorLUT, words);
+	BenchMirrorIMP("Mirror dispatch", BitArrMirror, words);
+
+	free(words);
+
+	return 0;
+}
+
+
+static void BenchCountIMP(const char *name_, count_func_ty count_, const bit_array_ty *words_)
+{
+	size_t checksum = 0;
+	size_t done = 0;
+	size_t i = 0;
+	clock_t start = clock();
+	double seconds = 0;
+
+	for (done = 0; done < WORDS_TOTAL; done += BUFFER_WORDS)
+	{
+		for (i = 0; i < BUFFER_WORDS; ++i)
+		{
+			checksum += count_(words_[i]);
+		}
+	}
+
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf("%-20s %8.3f sec  %8.1f Mwords/sec  (checksum %lu)\n", 
+	       name_, seconds, (double)done / seconds / 1e6, checksum);
+}
+
+
+static void BenchMirrorIMP(const char *name_, mirror_func_ty mirror_, const bit_array_ty *words_)
+{
+	bit_array_ty checksum = 0;
+	size_t done = 0;
+	size_t i = 0;
+	clock_t start = clock();
+	double seconds = 0;
+
+	for (done = 0; done < WORDS_TOTAL; done += BUFFER_WORDS)
+	{
+		for (i = 0; i < BUFFER_WORDS; ++i)
+		{
+			checksum += mirror_(words_[i]);
+		}
+	}
+
+	seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf("%-20s %8.3f sec  %8.1f Mwords/sec  (checksum %lx)\n", 
+	       name_, seconds, (double)done / seconds / 1e6, checksum);
+}
+
+
+/* xorshift64 */
+static void FillRandomIMP(bit_array_ty *words_, size_t n_words_)
+{
+	bit_array_ty state = 0x9E3779B97F4A7C15LU;
+	size_t i = 0;
+
+	for (i = 0; i < n_words_; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		words_[i] = state;
+	}
+}
+
+
+static size_t CountOnLoopIMP(bit_array_ty bit_arr_)
+{
+	size_t counter = 0;
+
+	while (bit_arr_ > 0)
+	{
+		counter += (bit_arr_ & 1);
+		bit_arr_ >>= 1;
+	}
+
+	return counter;
+}
+
+
+static bit_array_ty MirrorLoopIMP(bit_array_ty bit_arr_)
+{
+	bit_array_ty reversed = 0;
+	size_t i = 0;
+
+	for (i = 0; i < BIT_ARR_SIZE; ++i)
+	{
+		reversed = (reversed << 1) | (bit_arr_ & 1);
+		bit_arr_ >>= 1;
+	}
+
+	return reversed;
+}
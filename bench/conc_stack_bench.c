@@ -0,0 +1,155 @@
+/*******************************************************************************
+***************************** - CONCURRENT STACK - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of push / pop pairs per second from 1 to N
+*					threads: mutex around a stack, lock-free stack
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/conc_stack.c src/stack.c
+*					bench/conc_stack_bench.c -I ./include -I ../ -pthread
+*	RUN				./a.out [max_threads]
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* clock_gettime */
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* atoi */
+#include <pthread.h>	/* pthread_create, pthread_join, pthread_mutex_t */
+#include <time.h>		/* clock_gettime */
+
+#include "stack.h"
+#include "conc_stack.h"
+
+#define PAIRS_PER_THREAD	1000000LU
+#define MAX_THREADS			64
+#define DEFAULT_THREADS		64
+
+typedef enum variant { LOCKED, LOCK_FREE } variant_ty;
+
+typedef struct locked_stack
+{
+	stack_ty *m_stack;
+	pthread_mutex_t m_lock;
+} locked_stack_ty;
+
+typedef struct worker
+{
+	variant_ty m_variant;
+	void *m_stack;
+	size_t m_id;
+} worker_ty;
+
+static double RunIMP(variant_ty variant_, size_t n_threads_);
+static void *WorkerIMP(void *param_);
+
+
+int main(int argc, char *argv[])
+{
+	size_t max_threads = (argc > 1) ? (size_t)atoi(argv[1]) : DEFAULT_THREADS;
+	size_t n_threads = 0;
+
+	if (0 == max_threads || max_threads > MAX_THREADS)
+	{
+		max_threads = MAX_THREADS;
+	}
+
+	printf("\n\t--- Bench Concurrent Stack (%lu push / pop pairs per thread) ---\n\n",
+	       PAIRS_PER_THREAD);
+	puts("threads\t  mutex Mpairs/s\tlock-free Mpairs/s");
+
+	for (n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+	{
+		printf("%lu\t%16.2f\t%18.2f\n", n_threads,
+		       RunIMP(LOCKED, n_threads), RunIMP(LOCK_FREE, n_threads));
+	}
+
+	return 0;
+}
+
+
+/* Returns millions of push / pop pairs per second, on a fresh stack */
+static double RunIMP(variant_ty variant_, size_t n_threads_)
+{
+	pthread_t threads[MAX_THREADS];
+	worker_ty workers[MAX_THREADS];
+	locked_stack_ty locked;
+	conc_stack_ty *lock_free = NULL;
+	struct timespec start;
+	struct timespec end;
+	double seconds = 0;
+	size_t i = 0;
+
+	locked.m_stack = StackCreate(MAX_THREADS);
+	pthread_mutex_init(&locked.m_lock, NULL);
+	lock_free = ConcStackCreate(MAX_THREADS);
+
+	if (NULL == locked.m_stack || NULL == lock_free)
+	{
+		puts("Memory Allocation Failed");
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		workers[i].m_variant = variant_;
+		workers[i].m_stack = (LOCKED == variant_) ? (void *)&locked : (void *)lock_free;
+		workers[i].m_id = i;
+		pthread_create(&threads[i], NULL, WorkerIMP, &workers[i]);
+	}
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	seconds = (double)(end.tv_sec - start.tv_sec) +
+	          (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	if (!((LOCKED == variant_) ? StackIsEmpty(locked.m_stack) : ConcStackIsEmpty(lock_free)))
+	{
+		puts("Elements were lost");
+	}
+
+	pthread_mutex_destroy(&locked.m_lock);
+	StackDestory(locked.m_stack);
+	ConcStackDestroy(lock_free);
+
+	return (double)(n_threads_ * PAIRS_PER_THREAD) / seconds / 1e6;
+}
+
+
+/* Every thread pushes then pops, as threads sharing a free-list do */
+static void *WorkerIMP(void *param_)
+{
+	worker_ty *worker = (worker_ty *)param_;
+	locked_stack_ty *locked = (locked_stack_ty *)worker->m_stack;
+	void *element = (void *)(worker->m_id + 1);
+	size_t i = 0;
+
+	for (i = 0; i < PAIRS_PER_THREAD; ++i)
+	{
+		if (LOCKED == worker->m_variant)
+		{
+			pthread_mutex_lock(&locked->m_lock);
+			StackPush(locked->m_stack, element);
+			pthread_mutex_unlock(&locked->m_lock);
+
+			pthread_mutex_lock(&locked->m_lock);
+			element = StackPeek(locked->m_stack);
+			StackPop(locked->m_stack);
+			pthread_mutex_unlock(&locked->m_lock);
+		}
+		else
+		{
+			ConcStackPush((conc_stack_ty *)worker->m_stack, element);
+			ConcStackPop((conc_stack_ty *)worker->m_stack, &element);
+		}
+	}
+
+	return NULL;
+}
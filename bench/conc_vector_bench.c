@@ -0,0 +1,151 @@
+/*******************************************************************************
+**************************** - CONCURRENT VECTOR - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of pushes / sec from 1 to N threads:
+*					mutex around a vector, lock-free concurrent vector
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/conc_vector.c src/vector.c
+*					bench/conc_vector_bench.c -I ./include -I ../ -pthread
+*	RUN				./a.out [max_threads]
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* clock_gettime */
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* atoi */
+#include <pthread.h>	/* pthread_create, pthread_join, pthread_mutex_t */
+#include <time.h>		/* clock_gettime */
+
+#include "vector.h"
+#include "conc_vector.h"
+
+#define PUSHES_PER_THREAD	1000000LU
+#define MAX_THREADS			64
+#define DEFAULT_THREADS		16
+
+typedef enum variant { LOCKED, LOCK_FREE } variant_ty;
+
+typedef struct locked_vector
+{
+	vector_ty *m_vector;
+	pthread_mutex_t m_lock;
+} locked_vector_ty;
+
+typedef struct worker
+{
+	variant_ty m_variant;
+	void *m_vector;
+	size_t m_id;
+} worker_ty;
+
+static double RunIMP(variant_ty variant_, size_t n_threads_);
+static void *WorkerIMP(void *param_);
+
+
+int main(int argc, char *argv[])
+{
+	size_t max_threads = (argc > 1) ? (size_t)atoi(argv[1]) : DEFAULT_THREADS;
+	size_t n_threads = 0;
+
+	if (0 == max_threads || max_threads > MAX_THREADS)
+	{
+		max_threads = MAX_THREADS;
+	}
+
+	printf("\n\t--- Bench Concurrent Vector (%lu pushes per thread) ---\n\n",
+	       PUSHES_PER_THREAD);
+	puts("threads\t  mutex Mpushes/s\tlock-free Mpushes/s");
+
+	for (n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+	{
+		printf("%lu\t%18.2f\t%18.2f\n", n_threads,
+		       RunIMP(LOCKED, n_threads), RunIMP(LOCK_FREE, n_threads));
+	}
+
+	return 0;
+}
+
+
+/* Returns millions of pushes per second, into a fresh vector */
+static double RunIMP(variant_ty variant_, size_t n_threads_)
+{
+	pthread_t threads[MAX_THREADS];
+	worker_ty workers[MAX_THREADS];
+	locked_vector_ty locked;
+	conc_vector_ty *lock_free = NULL;
+	struct timespec start;
+	struct timespec end;
+	double seconds = 0;
+	size_t i = 0;
+
+	locked.m_vector = VectorCreate(1, 0);
+	pthread_mutex_init(&locked.m_lock, NULL);
+	lock_free = ConcVectorCreate(sizeof(void *));
+
+	if (NULL == locked.m_vector || NULL == lock_free)
+	{
+		puts("Memory Allocation Failed");
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		workers[i].m_variant = variant_;
+		workers[i].m_vector = (LOCKED == variant_) ? (void *)&locked : (void *)lock_free;
+		workers[i].m_id = i;
+		pthread_create(&threads[i], NULL, WorkerIMP, &workers[i]);
+	}
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	seconds = (double)(end.tv_sec - start.tv_sec) +
+	          (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	if (n_threads_ * PUSHES_PER_THREAD != ((LOCKED == variant_) ?
+	    VectorSize(locked.m_vector) : ConcVectorSize(lock_free)))
+	{
+		puts("Pushes were lost");
+	}
+
+	pthread_mutex_destroy(&locked.m_lock);
+	VectorDestroy(locked.m_vector);
+	ConcVectorDestroy(lock_free);
+
+	return (double)(n_threads_ * PUSHES_PER_THREAD) / seconds / 1e6;
+}
+
+
+static void *WorkerIMP(void *param_)
+{
+	worker_ty *worker = (worker_ty *)param_;
+	locked_vector_ty *locked = (locked_vector_ty *)worker->m_vector;
+	void *element = NULL;
+	size_t i = 0;
+
+	for (i = 0; i < PUSHES_PER_THREAD; ++i)
+	{
+		element = (void *)(worker->m_id * PUSHES_PER_THREAD + i);
+
+		if (LOCKED == worker->m_variant)
+		{
+			pthread_mutex_lock(&locked->m_lock);
+			VectorPushBack(locked->m_vector, element);
+			pthread_mutex_unlock(&locked->m_lock);
+		}
+		else
+		{
+			ConcVectorPushBack((conc_vector_ty *)worker->m_vector, &element);
+		}
+	}
+
+	return NULL;
+}
@@ -0,0 +1,276 @@
+/*******************************************************************************
+****************************** - FORK JOIN - ***********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of a parallel tree sum on the fork-join pool,
+*					from 1 to N worker threads, against a serial AVLForEach
+*					over the same keys
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/fork_join.c src/work_deque.c src/bst_rec.c
+*					src/dlinked_list.c bench/fork_join_bench.c
+*					-I ./include -I ../ -pthread
+*	RUN				./a.out [max_threads]
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* clock_gettime */
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* malloc, free, atoi */
+#include <time.h>		/* clock_gettime */
+
+#include "bst_rec.h"
+#include "fork_join.h"
+
+#define NODES				(1LU << 20)
+#define WORK_ROUNDS			32			/* Mixing rounds per node visit */
+#define FORK_DEPTH			12			/* Subtrees below it are summed serially */
+#define MAX_THREADS			64
+#define DEFAULT_THREADS		64
+
+/* avl_ty hides its nodes, so the parallel sum walks a tree of the same
+	shape built here: balanced, keys in order */
+typedef struct tree_node
+{
+	struct tree_node *m_children[2];
+	size_t m_key;
+} tree_node_ty;
+
+typedef struct subtree
+{
+	const tree_node_ty *m_root;
+	size_t m_depth;
+	size_t m_sum;
+} subtree_ty;
+
+static double SerialAVLIMP(const size_t *keys_, size_t *sum_);
+static double ParallelIMP(const tree_node_ty *root_, size_t n_threads_, size_t *sum_);
+static tree_node_ty *BuildIMP(tree_node_ty *nodes_, size_t from_, size_t to_);
+static void SumTaskIMP(fork_join_worker_ty *worker_, void *param_);
+static size_t SumSerialIMP(const tree_node_ty *root_);
+static int SumEachIMP(void *data_, const void *param_);
+static int CmpKeysIMP(const void *a_, const void *b_, const void *param_);
+static size_t WorkIMP(size_t key_);
+static double SecondsIMP(const struct timespec *start_);
+
+
+int main(int argc, char *argv[])
+{
+	size_t max_threads = (argc > 1) ? (size_t)atoi(argv[1]) : DEFAULT_THREADS;
+	size_t *keys = (size_t *)malloc(NODES * sizeof(size_t));
+	tree_node_ty *nodes = (tree_node_ty *)malloc(NODES * sizeof(tree_node_ty));
+	tree_node_ty *root = NULL;
+	size_t expected = 0;
+	size_t sum = 0;
+	size_t n_threads = 0;
+	double serial = 0;
+	double one_thread = 0;
+	double seconds = 0;
+	size_t i = 0;
+
+	if (0 == max_threads || max_threads > MAX_THREADS)
+	{
+		max_threads = MAX_THREADS;
+	}
+
+	if (NULL == keys || NULL == nodes)
+	{
+		puts("Memory Allocation Failed");
+		return 1;
+	}
+
+	/* Keys 1 .. NODES in a scrambled insertion order */
+	for (i = 0; i < NODES; ++i)
+	{
+		keys[i] = ((i * 2654435761LU) & (NODES - 1)) + 1;
+	}
+
+	root = BuildIMP(nodes, 1, NODES + 1);
+
+	printf("\n\t--- Bench Fork Join Tree Sum (%lu nodes, %d rounds of work each) ---\n\n",
+	       NODES, WORK_ROUNDS);
+
+	serial = SerialAVLIMP(keys, &expected);
+	printf("serial AVLForEach\t%8.2f ms\n\n", serial * 1e3);
+	puts("threads\t        ms\tMnodes/s\tspeedup");
+
+	for (n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+	{
+		seconds = ParallelIMP(root, n_threads, &sum);
+		one_thread = (1 == n_threads) ? seconds : one_thread;
+
+		printf("%lu\t%10.2f\t%8.2f\t%7.2f%s\n", n_threads, seconds * 1e3,
+		       (double)NODES / seconds / 1e6, one_thread / seconds,
+		       (expected == sum) ? "" : "\tWRONG SUM");
+	}
+
+	free(nodes);
+	free(keys);
+
+	return 0;
+}
+
+
+/* Times AVLForEach alone, the tree is built beforehand */
+static double SerialAVLIMP(const size_t *keys_, size_t *sum_)
+{
+	avl_ty *avl = AVLCreate(CmpKeysIMP, NULL);
+	struct timespec start;
+	double seconds = 0;
+	size_t i = 0;
+
+	if (NULL == avl)
+	{
+		puts("Memory Allocation Failed");
+		return 0;
+	}
+
+	for (i = 0; i < NODES; ++i)
+	{
+		AVLInsert(avl, (void *)&keys_[i]);
+	}
+
+	*sum_ = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	AVLForEach(avl, IN, SumEachIMP, sum_);
+	seconds = SecondsIMP(&start);
+
+	AVLDestory(avl);
+
+	return seconds;
+}
+
+
+/* Times one run on a fresh pool, thread start up not included */
+static double ParallelIMP(const tree_node_ty *root_, size_t n_threads_, size_t *sum_)
+{
+	fork_join_ty *pool = ForkJoinCreate(n_threads_);
+	subtree_ty whole;
+	struct timespec start;
+	double seconds = 0;
+
+	if (NULL == pool)
+	{
+		puts("Memory Allocation Failed");
+		return 0;
+	}
+
+	whole.m_root = root_;
+	whole.m_depth = 0;
+	whole.m_sum = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	ForkJoinRun(pool, SumTaskIMP, &whole);
+	seconds = SecondsIMP(&start);
+
+	*sum_ = whole.m_sum;
+	ForkJoinDestroy(pool);
+
+	return seconds;
+}
+
+
+/* Balanced tree over keys [from_, to_) */
+static tree_node_ty *BuildIMP(tree_node_ty *nodes_, size_t from_, size_t to_)
+{
+	size_t middle = from_ + (to_ - from_) / 2;
+	tree_node_ty *node = NULL;
+
+	if (from_ >= to_)
+	{
+		return NULL;
+	}
+
+	/* Key k lives at nodes_[k - 1] */
+	node = &nodes_[middle - 1];
+	node->m_key = middle;
+	node->m_children[0] = BuildIMP(nodes_, from_, middle);
+	node->m_children[1] = BuildIMP(nodes_, middle + 1, to_);
+
+	return node;
+}
+
+
+/* Forks the left subtree, walks the right one, joins */
+static void SumTaskIMP(fork_join_worker_ty *worker_, void *param_)
+{
+	subtree_ty *subtree = (subtree_ty *)param_;
+	fork_join_task_ty task;
+	subtree_ty left;
+	subtree_ty right;
+
+	if (NULL == subtree->m_root || FORK_DEPTH <= subtree->m_depth)
+	{
+		subtree->m_sum = SumSerialIMP(subtree->m_root);
+		return;
+	}
+
+	left.m_root = subtree->m_root->m_children[0];
+	left.m_depth = subtree->m_depth + 1;
+	right.m_root = subtree->m_root->m_children[1];
+	right.m_depth = subtree->m_depth + 1;
+
+	ForkJoinFork(worker_, &task, SumTaskIMP, &left);
+	SumTaskIMP(worker_, &right);
+	ForkJoinJoin(worker_, &task);
+
+	subtree->m_sum = WorkIMP(subtree->m_root->m_key) + left.m_sum + right.m_sum;
+}
+
+
+static size_t SumSerialIMP(const tree_node_ty *root_)
+{
+	if (NULL == root_)
+	{
+		return 0;
+	}
+
+	return SumSerialIMP(root_->m_children[0]) + WorkIMP(root_->m_key) +
+	       SumSerialIMP(root_->m_children[1]);
+}
+
+
+static int SumEachIMP(void *data_, const void *param_)
+{
+	*(size_t *)param_ += WorkIMP(*(size_t *)data_);
+
+	return 0;
+}
+
+
+static int CmpKeysIMP(const void *a_, const void *b_, const void *param_)
+{
+	(void)param_;
+
+	return (*(const size_t *)a_ > *(const size_t *)b_) -
+	       (*(const size_t *)a_ < *(const size_t *)b_);
+}
+
+
+/* Stands for the work a ForEach callback does on an element */
+static size_t WorkIMP(size_t key_)
+{
+	int i = 0;
+
+	for (i = 0; i < WORK_ROUNDS; ++i)
+	{
+		key_ ^= key_ << 13;
+		key_ ^= key_ >> 7;
+		key_ ^= key_ << 17;
+	}
+
+	return key_;
+}
+
+
+static double SecondsIMP(const struct timespec *start_)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	return (double)(end.tv_sec - start_->tv_sec) +
+	       (double)(end.tv_nsec - start_->tv_nsec) / 1e9;
+}
@@ -0,0 +1,165 @@
+/*******************************************************************************
+************************** - MULTI PRODUCER QUEUE - ****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of enqueue / dequeue pairs per second from 1 to N
+*					threads: mutex around a linked list queue, MPMC queue
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/mpmc_queue.c src/queue.c src/linked_list.c
+*					bench/mpmc_queue_bench.c -I ./include -I ../ -pthread
+*	RUN				./a.out [max_threads]
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* clock_gettime */
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* atoi */
+#include <pthread.h>	/* pthread_create, pthread_join, pthread_mutex_t */
+#include <time.h>		/* clock_gettime */
+
+#include "queue.h"
+#include "mpmc_queue.h"
+
+#define PAIRS_PER_THREAD	1000000LU
+#define CAPACITY			1024LU
+#define MAX_THREADS			64
+#define DEFAULT_THREADS		64
+
+typedef enum variant { LOCKED, LOCK_FREE } variant_ty;
+
+typedef struct locked_queue
+{
+	queue_ty *m_queue;
+	pthread_mutex_t m_lock;
+} locked_queue_ty;
+
+typedef struct worker
+{
+	variant_ty m_variant;
+	void *m_queue;
+	size_t m_id;
+	size_t m_checksum;
+} worker_ty;
+
+static double RunIMP(variant_ty variant_, size_t n_threads_);
+static void *WorkerIMP(void *param_);
+
+
+int main(int argc, char *argv[])
+{
+	size_t max_threads = (argc > 1) ? (size_t)atoi(argv[1]) : DEFAULT_THREADS;
+	size_t n_threads = 0;
+
+	if (0 == max_threads || max_threads > MAX_THREADS)
+	{
+		max_threads = MAX_THREADS;
+	}
+
+	printf("\n\t--- Bench MPMC Queue (%lu enqueue / dequeue pairs per thread) ---\n\n",
+	       PAIRS_PER_THREAD);
+	puts("threads\tmutex + list Mpairs/s\t  MPMC Mpairs/s");
+
+	for (n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+	{
+		printf("%lu\t%21.2f\t%15.2f\n", n_threads,
+		       RunIMP(LOCKED, n_threads), RunIMP(LOCK_FREE, n_threads));
+	}
+
+	return 0;
+}
+
+
+/* Returns millions of enqueue / dequeue pairs per second, on a fresh queue */
+static double RunIMP(variant_ty variant_, size_t n_threads_)
+{
+	pthread_t threads[MAX_THREADS];
+	worker_ty workers[MAX_THREADS];
+	locked_queue_ty locked;
+	mpmc_queue_ty *lock_free = NULL;
+	struct timespec start;
+	struct timespec end;
+	double seconds = 0;
+	size_t checksum = 0;
+	size_t i = 0;
+
+	locked.m_queue = QueueCreate();
+	pthread_mutex_init(&locked.m_lock, NULL);
+	lock_free = MpmcQueueCreate(CAPACITY);
+
+	if (NULL == locked.m_queue || NULL == lock_free)
+	{
+		puts("Memory Allocation Failed");
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		workers[i].m_variant = variant_;
+		workers[i].m_queue = (LOCKED == variant_) ? (void *)&locked : (void *)lock_free;
+		workers[i].m_id = i;
+		workers[i].m_checksum = 0;
+		pthread_create(&threads[i], NULL, WorkerIMP, &workers[i]);
+	}
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		pthread_join(threads[i], NULL);
+		checksum += workers[i].m_checksum;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	seconds = (double)(end.tv_sec - start.tv_sec) +
+	          (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+	/* Every thread enqueued id + 1 on each pair */
+	if (checksum != PAIRS_PER_THREAD * n_threads_ * (n_threads_ + 1) / 2)
+	{
+		puts("Elements were lost");
+	}
+
+	pthread_mutex_destroy(&locked.m_lock);
+	QueueDestroy(locked.m_queue);
+	MpmcQueueDestroy(lock_free);
+
+	return (double)(n_threads_ * PAIRS_PER_THREAD) / seconds / 1e6;
+}
+
+
+/* Every thread enqueues then dequeues, taking whichever element is at the
+	front, as the threads of a work queue do */
+static void *WorkerIMP(void *param_)
+{
+	worker_ty *worker = (worker_ty *)param_;
+	locked_queue_ty *locked = (locked_queue_ty *)worker->m_queue;
+	void *element = (void *)(worker->m_id + 1);
+	size_t i = 0;
+
+	for (i = 0; i < PAIRS_PER_THREAD; ++i)
+	{
+		if (LOCKED == worker->m_variant)
+		{
+			pthread_mutex_lock(&locked->m_lock);
+			QueueEnqueue(locked->m_queue, (void *)(worker->m_id + 1));
+			pthread_mutex_unlock(&locked->m_lock);
+
+			/* The own enqueue above keeps the queue from being empty */
+			pthread_mutex_lock(&locked->m_lock);
+			element = QueuePeek(locked->m_queue);
+			QueueDequeue(locked->m_queue);
+			pthread_mutex_unlock(&locked->m_lock);
+		}
+		else
+		{
+			MpmcQueueEnqueue((mpmc_queue_ty *)worker->m_queue, (void *)(worker->m_id + 1));
+			element = MpmcQueueDequeue((mpmc_queue_ty *)worker->m_queue);
+		}
+
+		worker->m_checksum += (size_t)element;
+	}
+
+	return NULL;
+}
@@ -0,0 +1,153 @@
+/*******************************************************************************
+******************************** - QUEUE - *************************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of enqueue / dequeue throughput, linked list
+*					queue against ring buffer queue
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/queue.c src/linked_list.c bench/queue_bench.c
+*					-I ./include -I ../
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts */
+#include <time.h>		/* clock */
+
+#include "queue.h"
+
+#define OPERATIONS		10000000LU
+#define DEPTHS_NUM		3
+
+typedef enum kind { LIST, RING } kind_ty;
+
+static const char *kind_names[] = { "QueueCreate", "QueueCreateRing(16)" };
+
+static double SteadyIMP(kind_ty kind_, size_t depth_, size_t *checksum_);
+static double BurstIMP(kind_ty kind_, size_t burst_, size_t *checksum_);
+static queue_ty *CreateIMP(kind_ty kind_);
+
+
+int main(void)
+{
+	size_t depths[DEPTHS_NUM] = { 1, 1000, 100000 };
+	size_t checksum = 0;
+	size_t i = 0;
+	int kind = 0;
+
+	printf("\n\t--- Bench Queue (%lu enqueue / dequeue pairs) ---\n\n", OPERATIONS);
+
+	puts("Steady: one in, one out, over a standing depth");
+	puts("queue\t\t\t  Mpairs/s 1\tMpairs/s 1000\tMpairs/s 100000");
+
+	for (kind = LIST; kind <= RING; ++kind)
+	{
+		printf("%-20s", kind_names[kind]);
+
+		for (i = 0; i < DEPTHS_NUM; ++i)
+		{
+			printf("\t%12.1f", SteadyIMP((kind_ty)kind, depths[i], &checksum));
+		}
+		puts("");
+	}
+
+	puts("\nBurst: enqueue a burst, then dequeue it all");
+	puts("queue\t\t\t  Mpairs/s 1\tMpairs/s 1000\tMpairs/s 100000");
+
+	for (kind = LIST; kind <= RING; ++kind)
+	{
+		printf("%-20s", kind_names[kind]);
+
+		for (i = 0; i < DEPTHS_NUM; ++i)
+		{
+			printf("\t%12.1f", BurstIMP((kind_ty)kind, depths[i], &checksum));
+		}
+		puts("");
+	}
+
+	/* Keeps the loops from being optimized out */
+	if (0 == checksum)
+	{
+		puts("checksum 0");
+	}
+
+	return 0;
+}
+
+
+static double SteadyIMP(kind_ty kind_, size_t depth_, size_t *checksum_)
+{
+	queue_ty *queue = CreateIMP(kind_);
+	clock_t start = 0;
+	size_t i = 0;
+
+	if (NULL == queue)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < depth_; ++i)
+	{
+		QueueEnqueue(queue, (void *)i);
+	}
+
+	start = clock();
+	for (i = 0; i < OPERATIONS; ++i)
+	{
+		QueueEnqueue(queue, (void *)i);
+		*checksum_ += (size_t)QueuePeek(queue);
+		QueueDequeue(queue);
+	}
+
+	start = clock() - start;
+	QueueDestroy(queue);
+
+	return (double)OPERATIONS / ((double)start / CLOCKS_PER_SEC) / 1e6;
+}
+
+
+static double BurstIMP(kind_ty kind_, size_t burst_, size_t *checksum_)
+{
+	queue_ty *queue = CreateIMP(kind_);
+	clock_t start = 0;
+	size_t round = 0;
+	size_t i = 0;
+
+	if (NULL == queue)
+	{
+		return 0;
+	}
+
+	start = clock();
+	for (round = 0; round < OPERATIONS / burst_; ++round)
+	{
+		for (i = 0; i < burst_; ++i)
+		{
+			QueueEnqueue(queue, (void *)i);
+		}
+
+		while (!QueueIsEmpty(queue))
+		{
+			*checksum_ += (size_t)QueuePeek(queue);
+			QueueDequeue(queue);
+		}
+	}
+
+	start = clock() - start;
+	QueueDestroy(queue);
+
+	return (double)OPERATIONS / ((double)start / CLOCKS_PER_SEC) / 1e6;
+}
+
+
+static queue_ty *CreateIMP(kind_ty kind_)
+{
+	queue_ty *queue = (LIST == kind_) ? QueueCreate() : QueueCreateRing(16);
+
+	if (NULL == queue)
+	{
+		puts("Memory Allocation Failed");
+	}
+
+	return queue;
+}
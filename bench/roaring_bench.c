@@ -0,0 +1,217 @@
+/*******************************************************************************
+***************************** - ROARING BITMAP - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of memory and union / intersection / cardinality
+*					throughput, roaring bitmap against a plain bit set
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/roaring.c src/bitset.c src/bitarray.c
+*					bench/roaring_bench.c -I ./include -I ../
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts */
+#include <time.h>		/* clock */
+
+#include "bitset.h"
+#include "roaring.h"
+
+#define UNIVERSE		(1LU << 26)		/* 1024 chunks, 8MB plain bit set */
+#define CHUNK_VALUES	65536LU
+#define REPEATS			20
+
+typedef enum pattern { SPARSE, DENSE, RUNS, MIXED } pattern_ty;
+
+static const char *pattern_names[] = { "sparse 0.1%", "dense 50%", "runs", "mixed" };
+
+static void BenchPatternIMP(pattern_ty pattern_);
+static void FillIMP(pattern_ty pattern_, size_t variant_, bitset_ty *bitset_,
+                    roaring_ty *roaring_);
+static int PickIMP(pattern_ty pattern_, size_t value_, size_t variant_,
+                   unsigned long *seed_);
+static unsigned long NextRandomIMP(unsigned long *seed_);
+static double OpsPerSecIMP(clock_t start_, clock_t end_);
+
+
+int main(void)
+{
+	printf("\n\t--- Bench Roaring Bitmap (%lu values, %d repeats) ---\n\n",
+	       UNIVERSE, REPEATS);
+	puts("pattern\t\t   set MB\t  roar MB\t"
+	     "   set or/s\t  roar or/s\t  set and/s\t roar and/s\t"
+	     " set card/s\troar card/s");
+
+	BenchPatternIMP(SPARSE);
+	BenchPatternIMP(DENSE);
+	BenchPatternIMP(RUNS);
+	BenchPatternIMP(MIXED);
+
+	return 0;
+}
+
+
+static void BenchPatternIMP(pattern_ty pattern_)
+{
+	bitset_ty *set1 = BitSetCreate(UNIVERSE);
+	bitset_ty *set2 = BitSetCreate(UNIVERSE);
+	bitset_ty *set_result = BitSetCreate(UNIVERSE);
+	roaring_ty *roar1 = RoaringCreate();
+	roaring_ty *roar2 = RoaringCreate();
+	roaring_ty *roar_result = NULL;
+	double rates[6];
+	size_t checksum = 0;
+	clock_t start = 0;
+	int i = 0;
+
+	if (NULL == set1 || NULL == set2 || NULL == set_result ||
+	    NULL == roar1 || NULL == roar2)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	FillIMP(pattern_, 1, set1, roar1);
+	FillIMP(pattern_, 2, set2, roar2);
+
+	/* The plain bit set writes into a preallocated result, the roaring
+		bitmap allocates its result as a real caller would */
+	start = clock();
+	for (i = 0; i < REPEATS; ++i)
+	{
+		BitSetResetAll(set_result);
+		BitSetOr(set_result, set1);
+		BitSetOr(set_result, set2);
+		checksum += BitSetGetArray(set_result)[i];
+	}
+	rates[0] = OpsPerSecIMP(start, clock());
+
+	start = clock();
+	for (i = 0; i < REPEATS; ++i)
+	{
+		roar_result = RoaringOr(roar1, roar2);
+		checksum += RoaringContains(roar_result, (size_t)i);
+		RoaringDestroy(roar_result);
+	}
+	rates[1] = OpsPerSecIMP(start, clock());
+
+	start = clock();
+	for (i = 0; i < REPEATS; ++i)
+	{
+		BitSetResetAll(set_result);
+		BitSetOr(set_result, set1);
+		BitSetAnd(set_result, set2);
+		checksum += BitSetGetArray(set_result)[i];
+	}
+	rates[2] = OpsPerSecIMP(start, clock());
+
+	start = clock();
+	for (i = 0; i < REPEATS; ++i)
+	{
+		roar_result = RoaringAnd(roar1, roar2);
+		checksum += RoaringContains(roar_result, (size_t)i);
+		RoaringDestroy(roar_result);
+	}
+	rates[3] = OpsPerSecIMP(start, clock());
+
+	start = clock();
+	for (i = 0; i < REPEATS; ++i)
+	{
+		checksum += BitSetCountOn(set1);
+	}
+	rates[4] = OpsPerSecIMP(start, clock());
+
+	start = clock();
+	for (i = 0; i < REPEATS; ++i)
+	{
+		checksum += RoaringCardinality(roar1);
+	}
+	rates[5] = OpsPerSecIMP(start, clock());
+
+	printf("%-12s\t%9.3f\t%9.3f\t%11.0f\t%11.0f\t%11.0f\t%11.0f\t%11.0f\t%11.0f\n",
+	       pattern_names[pattern_],
+	       (double)(BitSetWordsCount(set1) * sizeof(bit_array_ty)) / (1 << 20),
+	       (double)RoaringMemoryUsage(roar1) / (1 << 20),
+	       rates[0], rates[1], rates[2], rates[3], rates[4], rates[5]);
+
+	/* Keeps the loops from being optimized out */
+	if (0 == checksum)
+	{
+		puts("checksum 0");
+	}
+
+	BitSetDestroy(set1);
+	BitSetDestroy(set2);
+	BitSetDestroy(set_result);
+	RoaringDestroy(roar1);
+	RoaringDestroy(roar2);
+}
+
+/* variant_ shifts the runs and the chunk patterns between the two inputs */
+static void FillIMP(pattern_ty pattern_, size_t variant_, bitset_ty *bitset_,
+                    roaring_ty *roaring_)
+{
+	unsigned long seed = 88172645463325252LU * variant_;
+	size_t value = 0;
+
+	for (value = 0; value < UNIVERSE; ++value)
+	{
+		if (PickIMP(pattern_, value, variant_, &seed))
+		{
+			BitSetSetOn(bitset_, value);
+			RoaringAdd(roaring_, value);
+		}
+	}
+
+	RoaringRunOptimize(roaring_);
+}
+
+static int PickIMP(pattern_ty pattern_, size_t value_, size_t variant_,
+                   unsigned long *seed_)
+{
+	switch (pattern_)
+	{
+		case SPARSE:
+			return (0 == NextRandomIMP(seed_) % 1000);
+
+		case DENSE:
+			return (int)(NextRandomIMP(seed_) & 1);
+
+		case RUNS:
+			return ((value_ + variant_ * 1000) / 5000) % 2;
+
+		case MIXED:
+			/* Each chunk takes one of the patterns above, a quarter are empty */
+			switch ((value_ / CHUNK_VALUES * 7 + variant_) % 4)
+			{
+				case 0:
+					return PickIMP(SPARSE, value_, variant_, seed_);
+
+				case 1:
+					return PickIMP(DENSE, value_, variant_, seed_);
+
+				case 2:
+					return PickIMP(RUNS, value_, variant_, seed_);
+
+				default:
+					return 0;
+			}
+	}
+
+	return 0;
+}
+
+/* xorshift64 */
+static unsigned long NextRandomIMP(unsigned long *seed_)
+{
+	*seed_ ^= *seed_ << 13;
+	*seed_ ^= *seed_ >> 7;
+	*seed_ ^= *seed_ << 17;
+
+	return *seed_;
+}
+
+static double OpsPerSecIMP(clock_t start_, clock_t end_)
+{
+	return (double)REPEATS / ((double)(end_ - start_ + 1) / CLOCKS_PER_SEC);
+}
@@ -0,0 +1,330 @@
+/*******************************************************************************
+************************* - SINGLE PRODUCER QUEUE - ****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of one producer thread passing pointers to one
+*					consumer thread: throughput of a mutex around a queue
+*					against the SPSC queue (single and batched), and round
+*					trip latency percentiles of the SPSC queue
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/spsc_queue.c src/queue.c src/linked_list.c
+*					bench/spsc_queue_bench.c -I ./include -I ../ -pthread
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* clock_gettime */
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* malloc, free, qsort */
+#include <pthread.h>	/* pthread_create, pthread_join, pthread_mutex_t */
+#include <time.h>		/* clock_gettime */
+#include <sched.h>		/* sched_yield */
+
+#include "queue.h"
+#include "spsc_queue.h"
+
+#define TRANSFERS			10000000LU
+#define CAPACITY			1024LU
+#define BATCH				32LU
+#define SAMPLES				100000LU
+#define SPINS_BEFORE_YIELD	1024LU
+
+typedef enum variant { LOCKED, SINGLE, BATCHED } variant_ty;
+
+static const char *variant_names[] = { "mutex + QueueCreateRing", "SPSC one by one",
+                                       "SPSC batches of 32" };
+
+typedef struct channel
+{
+	variant_ty m_variant;
+	spsc_queue_ty *m_queue;
+	queue_ty *m_locked_queue;
+	pthread_mutex_t m_lock;
+	size_t m_checksum;
+} channel_ty;
+
+static double ThroughputIMP(variant_ty variant_);
+static void *ProduceIMP(void *param_);
+static void *ConsumeIMP(void *param_);
+static void LatencyIMP(void);
+static void *EchoIMP(void *param_);
+static void WaitIMP(size_t *spins_);
+static size_t NowIMP(void);
+static int CmpSizeIMP(const void *a_, const void *b_);
+
+
+int main(void)
+{
+	int variant = 0;
+
+	printf("\n\t--- Bench SPSC Queue (%lu transfers, capacity %lu) ---\n\n",
+	       TRANSFERS, CAPACITY);
+	puts("queue\t\t\t\tMtransfers/s");
+
+	for (variant = LOCKED; variant <= BATCHED; ++variant)
+	{
+		printf("%-28s\t%12.2f\n", variant_names[variant],
+		       ThroughputIMP((variant_ty)variant));
+	}
+
+	LatencyIMP();
+
+	return 0;
+}
+
+
+/* Returns millions of transfers per second from the producer to the consumer */
+static double ThroughputIMP(variant_ty variant_)
+{
+	channel_ty channel;
+	pthread_t producer;
+	pthread_t consumer;
+	size_t start = 0;
+	double seconds = 0;
+
+	channel.m_variant = variant_;
+	channel.m_queue = SpscQueueCreate(CAPACITY);
+	channel.m_locked_queue = QueueCreateRing(CAPACITY);
+	channel.m_checksum = 0;
+	pthread_mutex_init(&channel.m_lock, NULL);
+
+	if (NULL == channel.m_queue || NULL == channel.m_locked_queue)
+	{
+		puts("Memory Allocation Failed");
+		return 0;
+	}
+
+	start = NowIMP();
+
+	pthread_create(&consumer, NULL, ConsumeIMP, &channel);
+	pthread_create(&producer, NULL, ProduceIMP, &channel);
+	pthread_join(producer, NULL);
+	pthread_join(consumer, NULL);
+
+	seconds = (double)(NowIMP() - start) / 1e9;
+
+	if (TRANSFERS * (TRANSFERS - 1) / 2 != channel.m_checksum)
+	{
+		puts("Transfers were lost");
+	}
+
+	pthread_mutex_destroy(&channel.m_lock);
+	QueueDestroy(channel.m_locked_queue);
+	SpscQueueDestroy(channel.m_queue);
+
+	return (double)TRANSFERS / seconds / 1e6;
+}
+
+
+static void *ProduceIMP(void *param_)
+{
+	channel_ty *channel = (channel_ty *)param_;
+	void *batch[BATCH];
+	size_t next = 0;
+	size_t last = 0;
+	size_t spins = 0;
+	size_t i = 0;
+
+	while (next < TRANSFERS)
+	{
+		if (last == next)
+		{
+			WaitIMP(&spins);
+		}
+
+		last = next;
+
+		switch (channel->m_variant)
+		{
+			case LOCKED:
+				pthread_mutex_lock(&channel->m_lock);
+				next += (0 == QueueEnqueue(channel->m_locked_queue, (void *)next));
+				pthread_mutex_unlock(&channel->m_lock);
+				break;
+
+			case SINGLE:
+				next += (0 == SpscQueueEnqueue(channel->m_queue, (void *)next));
+				break;
+
+			default:
+				for (i = 0; i < BATCH; ++i)
+				{
+					batch[i] = (void *)(next + i);
+				}
+
+				next += SpscQueueEnqueueN(channel->m_queue, batch,
+				                          (TRANSFERS - next < BATCH) ? TRANSFERS - next : BATCH);
+				break;
+		}
+	}
+
+	return NULL;
+}
+
+
+static void *ConsumeIMP(void *param_)
+{
+	channel_ty *channel = (channel_ty *)param_;
+	void *batch[BATCH];
+	size_t received = 0;
+	size_t spins = 0;
+	size_t n = 0;
+	size_t i = 0;
+
+	while (received < TRANSFERS)
+	{
+		switch (channel->m_variant)
+		{
+			case LOCKED:
+				pthread_mutex_lock(&channel->m_lock);
+				n = !QueueIsEmpty(channel->m_locked_queue);
+
+				if (n)
+				{
+					batch[0] = QueuePeek(channel->m_locked_queue);
+					QueueDequeue(channel->m_locked_queue);
+				}
+
+				pthread_mutex_unlock(&channel->m_lock);
+				break;
+
+			case SINGLE:
+				n = (0 == SpscQueueDequeue(channel->m_queue, &batch[0]));
+				break;
+
+			default:
+				n = SpscQueueDequeueN(channel->m_queue, batch, BATCH);
+				break;
+		}
+
+		if (0 == n)
+		{
+			WaitIMP(&spins);
+		}
+
+		for (i = 0; i < n; ++i)
+		{
+			channel->m_checksum += (size_t)batch[i];
+		}
+
+		received += n;
+	}
+
+	return NULL;
+}
+
+
+/* A message goes to the echo thread and back through a second queue, one
+	message in flight at a time */
+static void LatencyIMP(void)
+{
+	spsc_queue_ty *queues[2];
+	size_t *samples = (size_t *)malloc(SAMPLES * sizeof(size_t));
+	double percentiles[] = { 50, 90, 99, 99.9 };
+	pthread_t echo;
+	void *message = NULL;
+	size_t sent = 0;
+	size_t spins = 0;
+	size_t i = 0;
+
+	queues[0] = SpscQueueCreate(CAPACITY);
+	queues[1] = SpscQueueCreate(CAPACITY);
+
+	if (NULL == samples || NULL == queues[0] || NULL == queues[1])
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	pthread_create(&echo, NULL, EchoIMP, queues);
+
+	for (i = 0; i < SAMPLES; ++i)
+	{
+		sent = NowIMP();
+
+		while (0 != SpscQueueEnqueue(queues[0], (void *)sent))
+		{
+			WaitIMP(&spins);
+		}
+
+		while (0 != SpscQueueDequeue(queues[1], &message))
+		{
+			WaitIMP(&spins);
+		}
+
+		samples[i] = NowIMP() - (size_t)message;
+	}
+
+	/* NULL tells the echo thread to stop */
+	SpscQueueEnqueue(queues[0], NULL);
+	pthread_join(echo, NULL);
+
+	qsort(samples, SAMPLES, sizeof(size_t), CmpSizeIMP);
+
+	printf("\n\t--- SPSC Queue Round Trip Latency (%lu samples) ---\n\n", SAMPLES);
+
+	for (i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); ++i)
+	{
+		printf("p%-6g\t%10lu ns\n", percentiles[i],
+		       samples[(size_t)(percentiles[i] / 100 * (SAMPLES - 1))]);
+	}
+
+	printf("max\t%10lu ns\n", samples[SAMPLES - 1]);
+
+	SpscQueueDestroy(queues[0]);
+	SpscQueueDestroy(queues[1]);
+	free(samples);
+}
+
+
+static void *EchoIMP(void *param_)
+{
+	spsc_queue_ty **queues = (spsc_queue_ty **)param_;
+	void *message = NULL;
+	size_t spins = 0;
+
+	do
+	{
+		while (0 != SpscQueueDequeue(queues[0], &message))
+		{
+			WaitIMP(&spins);
+		}
+
+		if (NULL != message)
+		{
+			SpscQueueEnqueue(queues[1], message);
+		}
+	}
+	while (NULL != message);
+
+	return NULL;
+}
+
+
+/* Busy waits, giving the CPU away now and then so the other thread gets
+	to run when both share a core */
+static void WaitIMP(size_t *spins_)
+{
+	if (0 == ++*spins_ % SPINS_BEFORE_YIELD)
+	{
+		sched_yield();
+	}
+}
+
+
+static size_t NowIMP(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (size_t)now.tv_sec * 1000000000LU + (size_t)now.tv_nsec;
+}
+
+
+static int CmpSizeIMP(const void *a_, const void *b_)
+{
+	return (*(const size_t *)a_ > *(const size_t *)b_) -
+	       (*(const size_t *)a_ < *(const size_t *)b_);
+}
@@ -0,0 +1,162 @@
+/*******************************************************************************
+******************************* - VECTOR - *************************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of create / push / destroy churn of short-lived
+*					vectors, regular vector against the small vector, and of
+*					loading pointers one by one against the bulk APIs
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/vector.c bench/vector_bench.c -I ./include -I ../
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* malloc, free */
+#include <time.h>		/* clock */
+
+#include "vector.h"
+
+#define ROUNDS			2000000LU
+#define INLINE_SLOTS	8LU
+#define LOAD_SIZE		1000000LU
+#define LOAD_REPEATS	50
+
+typedef enum kind { REGULAR_100, REGULAR_8, SMALL_8 } kind_ty;
+
+static const char *kind_names[] = { "VectorCreate(100)", "VectorCreate(8)",
+                                    "VectorCreateSmall(8)" };
+
+static double ChurnIMP(kind_ty kind_, size_t pushes_, size_t *checksum_);
+static void BenchLoadIMP(size_t *checksum_);
+
+
+int main(void)
+{
+	size_t pushes[] = { 2, 4, 8, 16 };
+	size_t checksum = 0;
+	size_t i = 0;
+	int kind = 0;
+
+	printf("\n\t--- Bench Vector Churn (%lu create / push / destroy rounds) ---\n\n",
+	       ROUNDS);
+	puts("vector\t\t\t  ns/round 2\t  ns/round 4\t  ns/round 8\t ns/round 16");
+
+	for (kind = REGULAR_100; kind <= SMALL_8; ++kind)
+	{
+		printf("%-20s", kind_names[kind]);
+
+		for (i = 0; i < sizeof(pushes) / sizeof(pushes[0]); ++i)
+		{
+			printf("\t%12.1f", ChurnIMP((kind_ty)kind, pushes[i], &checksum));
+		}
+		puts("");
+	}
+
+	BenchLoadIMP(&checksum);
+
+	/* Keeps the loops from being optimized out */
+	if (0 == checksum)
+	{
+		puts("checksum 0");
+	}
+
+	return 0;
+}
+
+
+static double ChurnIMP(kind_ty kind_, size_t pushes_, size_t *checksum_)
+{
+	vector_ty *vector = NULL;
+	clock_t start = clock();
+	size_t round = 0;
+	size_t i = 0;
+
+	for (round = 0; round < ROUNDS; ++round)
+	{
+		switch (kind_)
+		{
+			case REGULAR_100:
+				vector = VectorCreate(100, 0);
+				break;
+
+			case REGULAR_8:
+				vector = VectorCreate(INLINE_SLOTS, 0);
+				break;
+
+			default:
+				vector = VectorCreateSmall(INLINE_SLOTS);
+				break;
+		}
+
+		if (NULL == vector)
+		{
+			puts("Memory Allocation Failed");
+			return 0;
+		}
+
+		for (i = 0; i < pushes_; ++i)
+		{
+			VectorPushBack(vector, (void *)i);
+		}
+
+		*checksum_ += (size_t)VectorGet(vector, pushes_ - 1) + VectorSize(vector);
+
+		VectorDestroy(vector);
+	}
+
+	return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / ROUNDS;
+}
+
+
+static void BenchLoadIMP(size_t *checksum_)
+{
+	void **src = (void **)malloc(LOAD_SIZE * sizeof(void *));
+	vector_ty *vector = NULL;
+	clock_t start = 0;
+	double ms[2];
+	size_t i = 0;
+	int repeat = 0;
+
+	if (NULL == src)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < LOAD_SIZE; ++i)
+	{
+		src[i] = (void *)i;
+	}
+
+	printf("\n\t--- Bench Vector Load (%lu pointers into an empty vector) ---\n\n",
+	       LOAD_SIZE);
+
+	start = clock();
+	for (repeat = 0; repeat < LOAD_REPEATS; ++repeat)
+	{
+		vector = VectorCreate(1, 0);
+		for (i = 0; i < LOAD_SIZE; ++i)
+		{
+			VectorPushBack(vector, src[i]);
+		}
+		*checksum_ += VectorSize(vector);
+		VectorDestroy(vector);
+	}
+	ms[0] = (double)(clock() - start) * 1e3 / CLOCKS_PER_SEC / LOAD_REPEATS;
+
+	start = clock();
+	for (repeat = 0; repeat < LOAD_REPEATS; ++repeat)
+	{
+		vector = VectorCreate(1, 0);
+		VectorPushBackN(vector, src, LOAD_SIZE);
+		*checksum_ += VectorSize(vector);
+		VectorDestroy(vector);
+	}
+	ms[1] = (double)(clock() - start) * 1e3 / CLOCKS_PER_SEC / LOAD_REPEATS;
+
+	printf("VectorPushBack loop\t%8.3f ms\n", ms[0]);
+	printf("VectorPushBackN\t\t%8.3f ms\n", ms[1]);
+
+	free(src);
+}
@@ -0,0 +1,143 @@
+/*******************************************************************************
+**************************** - PARALLEL VECTOR - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Benchmark of sorting and for-each over a void* vector
+*					from 1 to N threads, speedup against 1 thread and qsort
+*	AUTHOR 			Liad Raz
+*	COMPILE			gcc -ansi -pedantic-errors -Wall -Wextra -DNDEBUG -O3
+*					src/vector_parallel.c src/vector.c
+*					bench/vector_parallel_bench.c -I ./include -I ../ -pthread
+*	RUN				./a.out [max_threads] [elements]
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* clock_gettime */
+
+#include <stdio.h>		/* printf, puts */
+#include <stdlib.h>		/* atoi, atol, malloc, free, qsort, rand */
+#include <string.h>		/* memcpy */
+#include <time.h>		/* clock_gettime */
+
+#include "vector_parallel.h"
+
+#define DEFAULT_ELEMENTS	10000000LU	/* 100000000 needs ~2.4GB */
+#define MAX_THREADS			256
+#define DEFAULT_THREADS		16
+
+static double SecondsIMP(void);
+static int CmpIMP(const void *data_a_, const void *data_b_, const void *param_);
+static int QsortCmpIMP(const void *a_, const void *b_);
+static int ScaleIMP(void *element_, void *param_);
+
+
+int main(int argc, char *argv[])
+{
+	size_t max_threads = (argc > 1) ? (size_t)atoi(argv[1]) : DEFAULT_THREADS;
+	size_t elements = (argc > 2) ? (size_t)atol(argv[2]) : DEFAULT_ELEMENTS;
+	vector_ty *vector = NULL;
+	void **keys = NULL;
+	size_t factor = 3;
+	size_t n_threads = 0;
+	size_t i = 0;
+	double start = 0;
+	double qsort_time = 0;
+	double sort_time = 0;
+	double sort_base = 0;
+	double each_time = 0;
+	double each_base = 0;
+
+	if (0 == max_threads || max_threads > MAX_THREADS)
+	{
+		max_threads = MAX_THREADS;
+	}
+
+	vector = VectorCreate(elements, elements);
+	keys = (void **)malloc(elements * sizeof(void *));
+
+	if (NULL == vector || NULL == keys)
+	{
+		puts("Memory Allocation Failed");
+		return 1;
+	}
+
+	for (i = 0; i < elements; ++i)
+	{
+		keys[i] = (void *)(((size_t)rand() << 31) ^ (size_t)rand());
+	}
+
+	printf("\n\t--- Bench Parallel Vector (%lu elements) ---\n\n", elements);
+
+	memcpy(VectorGetArray(vector), keys, elements * sizeof(void *));
+	start = SecondsIMP();
+	qsort(VectorGetArray(vector), elements, sizeof(void *), QsortCmpIMP);
+	qsort_time = SecondsIMP() - start;
+
+	printf("qsort, 1 thread: %.3f s\n\n", qsort_time);
+	puts("threads\t  sort s\tspeedup\tvs qsort\t  for-each s\tspeedup");
+
+	for (n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+	{
+		memcpy(VectorGetArray(vector), keys, elements * sizeof(void *));
+		start = SecondsIMP();
+
+		if (0 != VectorParallelSort(vector, CmpIMP, NULL, n_threads))
+		{
+			puts("Sort Failed");
+			break;
+		}
+
+		sort_time = SecondsIMP() - start;
+
+		start = SecondsIMP();
+		VectorParallelForEach(vector, ScaleIMP, &factor, n_threads);
+		each_time = SecondsIMP() - start;
+
+		if (1 == n_threads)
+		{
+			sort_base = sort_time;
+			each_base = each_time;
+		}
+
+		printf("%lu\t%8.3f\t%7.2f\t%8.2f\t%12.3f\t%7.2f\n", n_threads,
+		       sort_time, sort_base / sort_time, qsort_time / sort_time,
+		       each_time, each_base / each_time);
+	}
+
+	free(keys);
+	VectorDestroy(vector);
+
+	return 0;
+}
+
+
+static double SecondsIMP(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+
+static int CmpIMP(const void *data_a_, const void *data_b_, const void *param_)
+{
+	(void)param_;
+
+	return ((size_t)data_a_ > (size_t)data_b_) - ((size_t)data_a_ < (size_t)data_b_);
+}
+
+
+static int QsortCmpIMP(const void *a_, const void *b_)
+{
+	return CmpIMP(*(void *const *)a_, *(void *const *)b_, NULL);
+}
+
+
+static int ScaleIMP(void *element_, void *param_)
+{
+	*(size_t *)element_ *= *(size_t *)param_;
+
+	return 0;
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+***************************** - ATOMIC BIT SET - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Lock-free bit set API, shared between threads
+*	AUTHOR 			Liad Raz
+*	FILES			atomic_bitset.c atomic_bitset_test.c atomic_bitset.h
+*
+*******************************************************************************/
+
+#ifndef __ATOMIC_BIT_SET_H__
+#define __ATOMIC_BIT_SET_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct atomic_bit_set atomic_bitset_ty;
+
+/* AtomicBitSetCreate layout options */
+typedef enum atomic_bitset_layout
+{
+	ATOMIC_BITSET_PACKED,		/* words are contiguous */
+	ATOMIC_BITSET_PADDED		/* each word owns a 64 bytes cache line */
+} atomic_bitset_layout_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates a bit set of n_bits bits, all bits are set to 0.
+				Every operation is a single atomic instruction on a word
+				(fetch_or / fetch_and), or a retry loop of them.
+				ATOMIC_BITSET_PADDED stops threads that work on different
+				words from invalidating each other's cache lines, at the
+				cost of 8 times the memory.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		Create and Destroy are not thread safe, every other
+				function may be called concurrently.
+				Indexes are zero based.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+atomic_bitset_ty *AtomicBitSetCreate(size_t n_bits, atomic_bitset_layout_ty layout);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the bit set.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void AtomicBitSetDestroy(atomic_bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of bits the bit set holds.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t AtomicBitSetSize(const atomic_bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Sets / clears the bit at the given index atomically.
+* RETURN		The value of the bit before the operation; 0 or 1.
+				TestAndSet returning 0 means the caller claimed the bit.
+* IMPORTANT		Undefined behavior for out of range indexes.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int AtomicBitSetTestAndSet(atomic_bitset_ty *bitset, size_t index);
+int AtomicBitSetTestAndClear(atomic_bitset_ty *bitset, size_t index);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the value of the bit at the given index.
+* RETURN		0 or 1
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int AtomicBitSetGetVal(const atomic_bitset_ty *bitset, size_t index);
+
+
+/*******************************************************************************
+* DESCRIPTION	Claims (sets) the first clear bit, scanning from the word of
+				hint and wrapping around. Spreading the hints of the threads
+				(e.g. thread_id * size / n_threads) keeps them off each
+				other's words.
+* RETURN		The claimed index; AtomicBitSetSize when all bits are set.
+*
+* Time Complexity 	O(n_bits / 64) uncontended
+*******************************************************************************/
+size_t AtomicBitSetClaim(atomic_bitset_ty *bitset);
+size_t AtomicBitSetClaimFrom(atomic_bitset_ty *bitset, size_t hint);
+
+
+/*******************************************************************************
+* DESCRIPTION	Releases (clears) a claimed bit.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void AtomicBitSetRelease(atomic_bitset_ty *bitset, size_t index);
+
+
+/*******************************************************************************
+* DESCRIPTION	Counts the set bits.
+* IMPORTANT		Under concurrent updates the result is a snapshot of each
+				word at a different time.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+size_t AtomicBitSetCountOn(const atomic_bitset_ty *bitset);
+
+
+#endif /* __ATOMIC_BIT_SET_H__ */
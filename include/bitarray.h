@@ -112,7 +112,9 @@ bit_array_ty BitArrFlip(bit_array_ty bit_arr, size_t index);
 * Arguments: 		bit_array_ty bit_arr - a bit array of 64 bits
 * Return value:		The function returns a bit_array_ty bit array,
 				which is the mirror image of bit_arr.
-* Notes:			/
+* Notes:			BitArrMirror uses the fastest backend the CPU supports
+				(pshufb on SSSE3), BitArrMirrorLUT is the portable
+				byte lookup table version.
 
 * Time Complexity:	NA
 *******************************************************************************/
@@ -154,11 +156,33 @@ bit_array_ty BitArrRotL(bit_array_ty bit_arr, size_t shifts);
 * Function Description: The function count_on counts the number of lit bits
 * Arguments: bit_arr - varible of size_t that represent a array of bit
 * Return value: the number of lit bit
+* Notes: BitArrCountOn uses the fastest backend the CPU supports (popcnt),
+	BitArrCountOnLUT is the portable byte lookup table version.
+	Tables are built at compile time, so both are thread safe.
 *
 *******************************************************************************/
 size_t BitArrCountOn(bit_array_ty bit_arr);
 size_t BitArrCountOnLUT(bit_array_ty bit_arr);
 
+/******************************************************************************
+* Function Description: Count the unset bits below the lowest set bit /
+	above the highest set bit.
+* Arguments: bit_arr - varible of size_t that represent a array of bit
+* Return value: the number of unset bits, 64 when bit_arr is 0
+* Notes: Compiles to a single ctz / clz instruction on GCC and Clang.
+*
+*******************************************************************************/
+size_t BitArrCountTrailingZeros(bit_array_ty bit_arr);
+size_t BitArrCountLeadingZeros(bit_array_ty bit_arr);
+
+/******************************************************************************
+* Function Description: Names the backends selected for BitArrCountOn and 
+	BitArrMirror ("lut", "popcnt", "popcnt+pshufb" ...).
+* Return value: a static string
+*
+*******************************************************************************/
+const char *BitArrBackend(void);
+
 /******************************************************************************
 * Function Description: The function count_off counts the number of turned off bits
 * Arguments: bit_arr - varible of size_t that represent a array of bit
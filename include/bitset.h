@@ -0,0 +1,235 @@
+/*******************************************************************************
+******************************** - BIT SET - ***********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Multi-word bit array API of arbitrary length
+*	AUTHOR 			Liad Raz
+*	FILES			bitset.c bitset_test.c bitset.h bitarray.h
+*
+*******************************************************************************/
+
+#ifndef __BIT_SET_H__
+#define __BIT_SET_H__
+
+#include <stddef.h>			/* size_t */
+
+#include "bitarray.h"		/* bit_array_ty */
+
+typedef struct bit_set bitset_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates a bit set of n_bits bits, all bits are set to 0.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		User needs to destroy the allocated bit set.
+				Indexes are zero based; bit i lives in word (i / 64),
+				at bit position (i % 64) counting from the LSB.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+bitset_ty *BitSetCreate(size_t n_bits);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the bit set.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void BitSetDestroy(bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of bits the bit set holds.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t BitSetSize(const bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of words in the underlying array.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t BitSetWordsCount(const bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the underlying array of words.
+* IMPORTANT		Bits beyond BitSetSize in the last word must be kept 0.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+bit_array_ty *BitSetGetArray(const bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Sets all bits to 1 / to 0.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+void BitSetSetAll(bitset_ty *bitset);
+void BitSetResetAll(bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Sets the bit at the given index to 1 / to 0 / to state.
+* IMPORTANT		Undefined behavior for out of range indexes.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void BitSetSetOn(bitset_ty *bitset, size_t index);
+void BitSetSetOff(bitset_ty *bitset, size_t index);
+void BitSetSetBit(bitset_ty *bitset, size_t index, int state);
+
+
+/*******************************************************************************
+* DESCRIPTION	Switches the state of the bit at the given index.
+* IMPORTANT		Undefined behavior for out of range indexes.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void BitSetFlip(bitset_ty *bitset, size_t index);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the value of the bit at the given index.
+* RETURN		0 or 1
+* IMPORTANT		Undefined behavior for out of range indexes.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int BitSetGetVal(const bitset_ty *bitset, size_t index);
+
+
+/*******************************************************************************
+* DESCRIPTION	Whole-set bitwise operations, the result is stored in dest.
+				AndNot clears in dest every bit that is set in src.
+* IMPORTANT		Both bit sets must be of the same size.
+				Loops are plain word loops, the compiler vectorizes them
+				when optimizations are on (-O3).
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+void BitSetAnd(bitset_ty *dest, const bitset_ty *src);
+void BitSetOr(bitset_ty *dest, const bitset_ty *src);
+void BitSetXor(bitset_ty *dest, const bitset_ty *src);
+void BitSetAndNot(bitset_ty *dest, const bitset_ty *src);
+
+
+/*******************************************************************************
+* DESCRIPTION	Counts the number of set / unset bits.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+size_t BitSetCountOn(const bitset_ty *bitset);
+size_t BitSetCountOff(const bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates a mirror image of the whole bit set in place;
+				bit i moves to index (size - 1 - i).
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+void BitSetMirror(bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Sets to 1 / sets to 0 / switches the bits in range [from, to).
+				The partial edge words are masked, the whole words between
+				them are filled with memset / a word loop.
+* IMPORTANT		from <= to <= BitSetSize. An empty range does nothing.
+*
+* Time Complexity 	O((to - from) / 64)
+*******************************************************************************/
+void BitSetSetRange(bitset_ty *bitset, size_t from, size_t to);
+void BitSetClearRange(bitset_ty *bitset, size_t from, size_t to);
+void BitSetFlipRange(bitset_ty *bitset, size_t from, size_t to);
+
+
+/*******************************************************************************
+* DESCRIPTION	Copies n_bits bits of src starting at src_from into dest
+				starting at dest_from. Bits of dest outside the range keep
+				their value. Each dest word is written once, with the source
+				bits read as a whole word from any bit offset.
+* IMPORTANT		Both ranges must be inside their bit sets.
+				dest and src may be the same bit set, overlapping ranges
+				are copied as with memmove.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+void BitSetCopyRange(bitset_ty *dest, size_t dest_from,
+                     const bitset_ty *src, size_t src_from, size_t n_bits);
+
+
+/*******************************************************************************
+* DESCRIPTION	Shifts the whole bit set by shifts bits, as BitArr shifts do
+				on a single word; Left moves bit i to index i + shifts
+				(towards the MSB), Right moves it to i - shifts.
+				Bits shifted in are 0, bits shifted out are lost.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+void BitSetShiftLeft(bitset_ty *bitset, size_t shifts);
+void BitSetShiftRight(bitset_ty *bitset, size_t shifts);
+
+
+/*******************************************************************************
+* DESCRIPTION	Rotates the whole bit set, generalising BitArrRotL / BitArrRotR;
+				RotL moves bit i to index (i + shifts) % BitSetSize.
+				The smaller side of the rotation is saved in a temporary
+				buffer, the rest is shifted in place.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		On failure the bit set is unchanged.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+int BitSetRotL(bitset_ty *bitset, size_t shifts);
+int BitSetRotR(bitset_ty *bitset, size_t shifts);
+
+
+/*******************************************************************************
+* DESCRIPTION	Finds the lowest set / unset bit, or the highest set bit.
+* RETURN		The bit index; BitSetSize when there is no such bit.
+* IMPORTANT		Whole words are skipped, the bit inside a word is found
+				with a single ctz / clz.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+size_t BitSetFindFirstSet(const bitset_ty *bitset);
+size_t BitSetFindFirstClear(const bitset_ty *bitset);
+size_t BitSetFindLastSet(const bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Finds the lowest set / unset bit at index from or above it.
+				Iterating the set bits :
+				for (i = BitSetFindNextSet(set, 0); i < size; 
+				     i = BitSetFindNextSet(set, i + 1))
+* RETURN		The bit index; BitSetSize when there is no such bit.
+*
+* Time Complexity 	O((n_bits - from) / 64)
+*******************************************************************************/
+size_t BitSetFindNextSet(const bitset_ty *bitset, size_t from);
+size_t BitSetFindNextClear(const bitset_ty *bitset, size_t from);
+
+
+/*******************************************************************************
+* DESCRIPTION	Used in BitSetForEachSet, called with each set bit index.
+* RETURN		status => 0 SUCCESS, keep iterating; non-zero value STOP.
+*******************************************************************************/
+typedef int (*bitset_action_ty)(size_t index, void *param);
+
+/*******************************************************************************
+* DESCRIPTION	Calls action on each set bit, from the lowest to the highest.
+* RETURN		status => 0 SUCCESS; non-zero value returned by action.
+* IMPORTANT		Changing bits of the word currently visited does not
+				affect the iteration of that word.
+*
+* Time Complexity 	O(n_bits / 64 + set bits)
+*******************************************************************************/
+int BitSetForEachSet(const bitset_ty *bitset, bitset_action_ty action, void *param);
+
+
+#endif /* __BIT_SET_H__ */
@@ -0,0 +1,98 @@
+/*******************************************************************************
+**************************** - BLOCKING QUEUE - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Thread safe queue whose consumers sleep until an element
+*					arrives or a timeout passes - API
+*	AUTHOR 			Liad Raz
+*	FILES			blocking_queue.c blocking_queue_test.c blocking_queue.h
+*					queue.h
+*
+*******************************************************************************/
+
+#ifndef __BLOCKING_QUEUE_H__
+#define __BLOCKING_QUEUE_H__
+
+#include <stddef.h>			/* size_t */
+
+/* timeout_ms value for waiting until an element arrives */
+#define BLOCKING_QUEUE_FOREVER		(-1L)
+
+typedef struct blocking_queue blocking_queue_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates an empty unbounded queue of void* pointers shared by
+				any number of producer and consumer threads.
+				A mutex guards a ring queue_ty. Consumers that find it empty
+				sleep on a condition variable instead of polling.
+				A producer signals only when its element makes the queue go
+				from empty to non-empty and a consumer is asleep. One consumer
+				wakes up, and passes the signal on when it leaves elements
+				behind, so a burst wakes consumers one by one instead of all
+				at once.
+* RETURN		NULL in case of memory or system resources failure.
+* IMPORTANT		- User needs to destroy the allocated queue.
+				- capacity is where the ring starts, it doubles when full.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+blocking_queue_ty *BlockingQueueCreate(size_t capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the queue, elements still in it are not freed.
+* IMPORTANT		No thread may use or wait on the queue at that time.
+*
+* Time Complexity 	O(n)
+*******************************************************************************/
+void BlockingQueueDestroy(blocking_queue_ty *queue);
+
+
+/*******************************************************************************
+* DESCRIPTION	Inserts element at the back of the queue, waking a sleeping
+				consumer if the queue was empty.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (memory).
+* IMPORTANT		Thread safe.
+*
+* Time Complexity 	amortized O(1)
+*******************************************************************************/
+int BlockingQueueEnqueue(blocking_queue_ty *queue, void *element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes the front element into element, waiting up to
+				timeout_ms milliseconds for one to arrive.
+				timeout_ms 0 only tries, BLOCKING_QUEUE_FOREVER never gives up.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (timed out while
+				the queue stayed empty).
+* IMPORTANT		Thread safe.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int BlockingQueueDequeueWait(blocking_queue_ty *queue, void **element, long timeout_ms);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes up to max front elements into elements, in order,
+				under a single lock acquisition. Waits like DequeueWait
+				while the queue is empty.
+* RETURN		The number of elements removed, 0 when timed out.
+* IMPORTANT		Thread safe.
+*
+* Time Complexity 	O(max)
+*******************************************************************************/
+size_t BlockingQueueDequeueBatch(blocking_queue_ty *queue, void **elements,
+                                 size_t max, long timeout_ms);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of elements in the queue.
+* IMPORTANT		A snapshot while other threads run.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t BlockingQueueSize(blocking_queue_ty *queue);
+
+
+#endif /* __BLOCKING_QUEUE_H__ */
@@ -0,0 +1,148 @@
+/*******************************************************************************
+****************************** - BLOOM FILTER - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Bloom filter and counting Bloom filter API
+*	AUTHOR 			Liad Raz
+*	FILES			bloom_filter.c bloom_filter_test.c bloom_filter.h bitset.h
+*
+*******************************************************************************/
+
+#ifndef __BLOOM_FILTER_H__
+#define __BLOOM_FILTER_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct bloom bloom_ty;
+typedef struct counting_bloom counting_bloom_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Generate a hash value using provided data.
+				Same signature as hash_func_ty of the hash table, so the
+				table's hash function can be shared with its filter.
+* RETURN	 	hash value
+*******************************************************************************/
+typedef size_t (*bloom_hash_ty)(const void *data, const void *param);
+
+
+/*******************************************************************************
+* DESCRIPTION	Sizing helpers for a target false positive rate.
+				BloomOptimalBits    => m = -n * ln(p) / ln(2)^2
+				BloomOptimalHashes  => k = m / n * ln(2), at least 1
+* IMPORTANT		fp_rate must be in range (0, 1). Link with -lm.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t BloomOptimalBits(size_t expected_items, double fp_rate);
+size_t BloomOptimalHashes(size_t n_bits, size_t expected_items);
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates a Bloom filter of n_bits bits and n_hashes hashes.
+				The hash indexes are derived from two base hashes :
+				index_i = (h1 + i * h2) % n_bits.
+				h1 is HashFunc(data), h2 is SecondHashFunc(data) or, when
+				SecondHashFunc is NULL, a bit mix of h1.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		n_hashes must be in range [1, 32].
+				User needs to destroy the allocated filter.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+bloom_ty *BloomCreate(size_t n_bits, size_t n_hashes, bloom_hash_ty HashFunc,
+                      bloom_hash_ty SecondHashFunc, const void *param);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the filter.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void BloomDestroy(bloom_ty *bloom);
+
+
+/*******************************************************************************
+* DESCRIPTION	Adds data to the filter.
+*
+* Time Complexity 	O(n_hashes)
+*******************************************************************************/
+void BloomInsert(bloom_ty *bloom, const void *data);
+
+
+/*******************************************************************************
+* DESCRIPTION	Checks if data may have been added to the filter.
+* RETURN		boolean => 0 DEFINITELY NOT PRESENT; 1 MAY BE PRESENT
+*
+* Time Complexity 	O(n_hashes)
+*******************************************************************************/
+int BloomMayContain(const bloom_ty *bloom, const void *data);
+
+
+/*******************************************************************************
+* DESCRIPTION	Batch versions of Insert / MayContain. The indexes of a group
+				of items are computed first and their words are prefetched,
+				so the cache misses of the group overlap.
+				results[i] is the MayContain result of data[i].
+*
+* Time Complexity 	O(n * n_hashes)
+*******************************************************************************/
+void BloomInsertBatch(bloom_ty *bloom, const void **data, size_t n);
+void BloomQueryBatch(const bloom_ty *bloom, const void **data, size_t n, int *results);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes all data from the filter.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+void BloomClear(bloom_ty *bloom);
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates a counting Bloom filter, a filter that supports
+				removal. Each of the n_counters positions holds an 8 bits
+				saturating counter instead of a bit; a counter that reached
+				255 is never decremented again.
+				Hashes are derived as in BloomCreate.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		n_hashes must be in range [1, 32].
+				User needs to destroy the allocated filter.
+*
+* Time Complexity 	O(n_counters)
+*******************************************************************************/
+counting_bloom_ty *CountingBloomCreate(size_t n_counters, size_t n_hashes,
+                                       bloom_hash_ty HashFunc,
+                                       bloom_hash_ty SecondHashFunc,
+                                       const void *param);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the filter.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void CountingBloomDestroy(counting_bloom_ty *bloom);
+
+
+/*******************************************************************************
+* DESCRIPTION	Adds / removes data.
+* IMPORTANT		Removing data that was never added corrupts the filter
+				(it may produce false negatives).
+*
+* Time Complexity 	O(n_hashes)
+*******************************************************************************/
+void CountingBloomInsert(counting_bloom_ty *bloom, const void *data);
+void CountingBloomRemove(counting_bloom_ty *bloom, const void *data);
+
+
+/*******************************************************************************
+* DESCRIPTION	Checks if data may be in the filter.
+* RETURN		boolean => 0 DEFINITELY NOT PRESENT; 1 MAY BE PRESENT
+*
+* Time Complexity 	O(n_hashes)
+*******************************************************************************/
+int CountingBloomMayContain(const counting_bloom_ty *bloom, const void *data);
+
+
+#endif /* __BLOOM_FILTER_H__ */
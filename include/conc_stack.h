@@ -0,0 +1,91 @@
+/*******************************************************************************
+***************************** - CONCURRENT STACK - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Lock-free stack (Treiber) with elimination backoff - API
+*	AUTHOR 			Liad Raz
+*	FILES			conc_stack.c conc_stack_test.c conc_stack.h
+*
+*******************************************************************************/
+
+#ifndef __CONC_STACK_H__
+#define __CONC_STACK_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct conc_stack conc_stack_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates an empty stack of void* pointers, shared by many
+				threads without locks.
+				All capacity nodes are allocated up front and kept on a free
+				list, a node is only freed by destroy. The head and the free
+				list are a node index and a tag changed by every CAS, so a
+				node that was popped and pushed again (ABA) fails the CAS.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		- User needs to destroy the allocated stack.
+				- capacity must be below 2^32 - 1.
+*
+* Time Complexity 	O(capacity)
+*******************************************************************************/
+conc_stack_ty *ConcStackCreate(size_t capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the stack and its nodes.
+* IMPORTANT		No other thread may use the stack at that time.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void ConcStackDestroy(conc_stack_ty *stack);
+
+
+/*******************************************************************************
+* DESCRIPTION	Pushes element with a CAS on the head. When the CAS fails
+				the push offers its element in a random elimination slot for
+				a short time, a pop that finds it takes it and neither
+				touches the head.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (stack full).
+* IMPORTANT		Thread safe.
+*
+* Time Complexity 	O(1) without contention
+*******************************************************************************/
+int ConcStackPush(conc_stack_ty *stack, void *element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Pops the top most element into element. When the CAS on the
+				head fails the pop looks for an offered push in a random
+				elimination slot.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (stack empty).
+* IMPORTANT		Thread safe.
+*
+* Time Complexity 	O(1) without contention
+*******************************************************************************/
+int ConcStackPop(conc_stack_ty *stack, void **element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Copies the top most element into element without removing it.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (stack empty).
+* IMPORTANT		Thread safe; other threads may pop it right after.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int ConcStackPeek(conc_stack_ty *stack, void **element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of elements / whether the stack is empty /
+				how many elements the stack can hold.
+* IMPORTANT		Size and IsEmpty are a snapshot while other threads run.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t ConcStackSize(const conc_stack_ty *stack);
+int ConcStackIsEmpty(const conc_stack_ty *stack);
+size_t ConcStackCapacity(const conc_stack_ty *stack);
+
+
+#endif /* __CONC_STACK_H__ */
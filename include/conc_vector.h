@@ -0,0 +1,93 @@
+/*******************************************************************************
+**************************** - CONCURRENT VECTOR - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Lock-free append-only vector for many writer threads - API
+*	AUTHOR 			Liad Raz
+*	FILES			conc_vector.c conc_vector_test.c conc_vector.h
+*
+*******************************************************************************/
+
+#ifndef __CONC_VECTOR_H__
+#define __CONC_VECTOR_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct conc_vector conc_vector_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates an empty append-only vector of elements of
+				element_size bytes, stored by value (pass sizeof(void *)
+				and the address of the pointer to hold void* pointers).
+				Elements live in chunks of 64, 128, 256 ... elements which
+				are allocated on first use, an element never moves.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		User needs to destroy the allocated vector.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+conc_vector_ty *ConcVectorCreate(size_t element_size);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the vector and all its chunks.
+* IMPORTANT		No other thread may use the vector at that time.
+*
+* Time Complexity 	O(chunks)
+*******************************************************************************/
+void ConcVectorDestroy(conc_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Allocates the chunks needed to hold capacity elements, so
+				the pushes below it never allocate.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		Thread safe, may run alongside pushes.
+*
+* Time Complexity 	O(chunks)
+*******************************************************************************/
+int ConcVectorReserve(conc_vector_ty *vector, size_t capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Copies element_size bytes from value to the end of the vector.
+				The index is claimed with an atomic fetch-add, the thread
+				that first reaches a missing chunk allocates it and installs
+				it with a compare-and-swap. No locks are taken.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		- Thread safe.
+				- A failed push still holds its index, the published size
+				stops below it for good. Reserve ahead to rule this out.
+				- Pushes from one thread keep their order in the vector.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int ConcVectorPushBack(conc_vector_ty *vector, const void *value);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the published size : the number of leading elements
+				that were completely written. Elements below it may be read
+				without locks.
+* IMPORTANT		- Thread safe.
+				- Pushes complete out of order, an element that is still
+				being written holds back the elements after it.
+*
+* Time Complexity 	O(1) amortized
+*******************************************************************************/
+size_t ConcVectorSize(conc_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Copies the element at index into value / returns its address.
+* IMPORTANT		- index MUST be smaller than a size returned by ConcVectorSize.
+				- Thread safe, elements are never changed after the push.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void ConcVectorGet(const conc_vector_ty *vector, size_t index, void *value);
+const void *ConcVectorAt(const conc_vector_ty *vector, size_t index);
+
+
+#endif /* __CONC_VECTOR_H__ */
@@ -0,0 +1,158 @@
+/*******************************************************************************
+****************************** - FILE VECTOR - *********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Persistent vector stored in a memory mapped file - API
+*	AUTHOR 			Liad Raz
+*	FILES			file_vector.c file_vector_test.c file_vector.h
+*
+*******************************************************************************/
+
+#ifndef __FILE_VECTOR_H__
+#define __FILE_VECTOR_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct file_vector file_vector_ty;
+
+typedef enum file_vector_mode
+{
+	FILE_VECTOR_READ_ONLY,
+	FILE_VECTOR_READ_WRITE
+} file_vector_mode_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates the file at path (truncating an existing one) and maps
+				it as an empty vector of elements of element_size bytes,
+				stored inline as in VectorCreateTyped.
+				The file holds a small header (element size, size, capacity)
+				followed by the elements, it is the only copy of the data.
+* RETURN		NULL in case of memory or file failure.
+* IMPORTANT		- User needs to destroy the vector, the file is kept.
+				- Elements are raw bytes; store offsets or indexes rather
+				than pointers, pointers are not valid in another process.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+file_vector_ty *FileVectorCreate(const char *path, size_t element_size);
+
+
+/*******************************************************************************
+* DESCRIPTION	Maps an existing vector file. Nothing is read or copied, the
+				elements are paged in from the file on first access.
+				A read only vector may only be read, a read write vector
+				may grow, change and sync the file.
+* RETURN		NULL in case of failure, or when the file is not a vector
+				file or is shorter than its header claims.
+* IMPORTANT		User needs to destroy the vector, the file is kept.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+file_vector_ty *FileVectorOpen(const char *path, file_vector_mode_ty mode);
+
+
+/*******************************************************************************
+* DESCRIPTION	Unmaps the file and closes it. Changes of a read write vector
+				reach the file eventually even without FileVectorSync.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void FileVectorDestroy(file_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Writes the changed pages (elements and header) to the file and
+				waits for the write to complete (msync MS_SYNC).
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		Read write vectors only.
+*
+* Time Complexity 	O(changed pages)
+*******************************************************************************/
+int FileVectorSync(file_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Copies element_size bytes from value into the element at index /
+				from the element at index into value.
+* IMPORTANT		- index MUST be in range of the size.
+				- Set is for read write vectors only.
+*
+* Time Complexity 	O(element_size)
+*******************************************************************************/
+void FileVectorSet(file_vector_ty *vector, size_t index, const void *value);
+void FileVectorGet(const file_vector_ty *vector, size_t index, void *value);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the address of the element at index / of the first
+				element, inside the mapping.
+* IMPORTANT		- Growing may move the mapping, the addresses are valid until
+				the next growth.
+				- Writing through them is allowed in read write vectors only.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void *FileVectorAt(const file_vector_ty *vector, size_t index);
+void *FileVectorData(const file_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of elements / the number of elements the
+				file has room for / the size of an element in bytes.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t FileVectorSize(const file_vector_ty *vector);
+size_t FileVectorCapacity(const file_vector_ty *vector);
+size_t FileVectorElementSize(const file_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Grows the file to hold at least new_capacity elements
+				(ftruncate, then mremap of the mapping).
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		- Read write vectors only.
+				- A new_capacity smaller than capacity does nothing.
+				- Capacity is rounded up so the file is whole pages.
+*
+* Time Complexity 	O(1), new file pages are allocated lazily
+*******************************************************************************/
+int FileVectorReserve(file_vector_ty *vector, size_t new_capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Changes the number of elements, growing the file when
+				new_size is bigger than capacity. Elements from size to
+				new_size - 1 are set to zero bytes.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		Read write vectors only.
+*
+* Time Complexity 	O(new_size - size) when growing, O(1) otherwise
+*******************************************************************************/
+int FileVectorResize(file_vector_ty *vector, size_t new_size);
+
+
+/*******************************************************************************
+* DESCRIPTION	Copies element_size bytes from value to the end of the vector,
+				a full vector doubles the file.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		Read write vectors only.
+*
+* Time Complexity 	O(1) amortized
+*******************************************************************************/
+int FileVectorPushBack(file_vector_ty *vector, const void *value);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes the last element, copying it into value (value may be
+				NULL). The file keeps its length.
+* IMPORTANT		- Read write vectors only.
+				- Undefined behavior when the vector is empty.
+*
+* Time Complexity 	O(element_size)
+*******************************************************************************/
+void FileVectorPopBack(file_vector_ty *vector, void *value);
+
+
+#endif /* __FILE_VECTOR_H__ */
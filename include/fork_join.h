@@ -0,0 +1,94 @@
+/*******************************************************************************
+****************************** - FORK JOIN - ***********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Fork-join task pool over work-stealing deques - API
+*	AUTHOR 			Liad Raz
+*	FILES			fork_join.c fork_join_test.c fork_join.h work_deque.h
+*
+*******************************************************************************/
+
+#ifndef __FORK_JOIN_H__
+#define __FORK_JOIN_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct fork_join fork_join_ty;
+typedef struct fork_join_worker fork_join_worker_ty;
+typedef struct fork_join_task fork_join_task_ty;
+
+/* worker is the thread running the task, to fork and join subtasks on */
+typedef void (*fork_join_func_ty)(fork_join_worker_ty *worker, void *param);
+
+/* Lives in the forking task's frame, so forking allocates nothing.
+	The fields are private to fork_join.c */
+struct fork_join_task
+{
+	fork_join_func_ty m_func;
+	void *m_param;
+	int m_done;
+};
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates a pool of n_threads worker threads, each owning a
+				work-stealing deque.
+				A task forks subtasks onto its worker's deque and keeps
+				working. A worker out of tasks steals the oldest task of
+				another worker, which is the biggest piece of work left. A
+				worker waiting in Join runs other tasks meanwhile.
+				Between runs the workers sleep.
+* RETURN		NULL in case of memory or system resources failure.
+* IMPORTANT		- User needs to destroy the allocated pool.
+				- n_threads 0 means one worker per online CPU.
+*
+* Time Complexity 	O(n_threads)
+*******************************************************************************/
+fork_join_ty *ForkJoinCreate(size_t n_threads);
+
+
+/*******************************************************************************
+* DESCRIPTION	Stops and joins the worker threads, frees the pool.
+* IMPORTANT		No run may be in progress.
+*
+* Time Complexity 	O(n_threads)
+*******************************************************************************/
+void ForkJoinDestroy(fork_join_ty *pool);
+
+
+/*******************************************************************************
+* DESCRIPTION	Runs func(worker, param) on the pool as the root task and
+				returns when it and every task it forked are done.
+* IMPORTANT		- One run at a time; not to be called from inside a task.
+				- Every forked task must be joined before the task that
+				forked it returns.
+*
+* Time Complexity 	That of func, divided among the workers
+*******************************************************************************/
+void ForkJoinRun(fork_join_ty *pool, fork_join_func_ty func, void *param);
+
+
+/*******************************************************************************
+* DESCRIPTION	Fork makes task = func(param) available to run, on the
+				calling worker or on a thief. Join returns when task is done,
+				running it, or other tasks, while it waits.
+* IMPORTANT		- worker is the one passed to the calling task.
+				- task must stay in place until joined.
+				- Fork runs the task at once when the deque cannot grow.
+*
+* Time Complexity 	O(1) for Fork
+*******************************************************************************/
+void ForkJoinFork(fork_join_worker_ty *worker, fork_join_task_ty *task,
+                  fork_join_func_ty func, void *param);
+void ForkJoinJoin(fork_join_worker_ty *worker, fork_join_task_ty *task);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of worker threads of the pool.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t ForkJoinThreads(const fork_join_ty *pool);
+
+
+#endif /* __FORK_JOIN_H__ */
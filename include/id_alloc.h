@@ -0,0 +1,86 @@
+/*******************************************************************************
+****************************** - ID ALLOCATOR - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Hierarchical bitmap ID / slot allocator API
+*	AUTHOR 			Liad Raz
+*	FILES			id_alloc.c id_alloc_test.c id_alloc.h bitset.h
+*
+*******************************************************************************/
+
+#ifndef __ID_ALLOC_H__
+#define __ID_ALLOC_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct id_alloc id_alloc_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates an allocator of the IDs in range [0, capacity).
+				IDs are kept in a bit set, on top of it are summary levels
+				holding one bit per full 64 bits word of the level below,
+				up to a single word.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		User needs to destroy the allocated allocator.
+*
+* Time Complexity 	O(capacity / 64)
+*******************************************************************************/
+id_alloc_ty *IDAllocCreate(size_t capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the allocator.
+*
+* Time Complexity 	O(log64 capacity)
+*******************************************************************************/
+void IDAllocDestroy(id_alloc_ty *id_alloc);
+
+
+/*******************************************************************************
+* DESCRIPTION	Allocates the lowest free ID.
+* RETURN		The ID; IDAllocCapacity when all IDs are in use.
+*
+* Time Complexity 	O(log64 capacity)
+*******************************************************************************/
+size_t IDAllocAlloc(id_alloc_ty *id_alloc);
+
+
+/*******************************************************************************
+* DESCRIPTION	Allocates the lowest run of n consecutive free IDs.
+* RETURN		The first ID of the run; IDAllocCapacity when no such run.
+*
+* Time Complexity 	O(n / 64 + log64 capacity) per free run examined
+*******************************************************************************/
+size_t IDAllocAllocRange(id_alloc_ty *id_alloc, size_t n);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns an ID / a run of n IDs to the allocator.
+* IMPORTANT		Undefined behavior for IDs that are not in use.
+*
+* Time Complexity 	O(log64 capacity), O(n / 64 + log64 capacity) for a run
+*******************************************************************************/
+void IDAllocFree(id_alloc_ty *id_alloc, size_t id);
+void IDAllocFreeRange(id_alloc_ty *id_alloc, size_t first_id, size_t n);
+
+
+/*******************************************************************************
+* DESCRIPTION	Checks if an ID is in use.
+* RETURN		boolean => 1 IN USE; 0 FREE
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int IDAllocIsUsed(const id_alloc_ty *id_alloc, size_t id);
+
+
+/*******************************************************************************
+* DESCRIPTION	Number of IDs in use / number of IDs the allocator manages.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t IDAllocCount(const id_alloc_ty *id_alloc);
+size_t IDAllocCapacity(const id_alloc_ty *id_alloc);
+
+
+#endif /* __ID_ALLOC_H__ */
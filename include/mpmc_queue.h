@@ -0,0 +1,85 @@
+/*******************************************************************************
+************************** - MULTI PRODUCER QUEUE - ****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Lock-free bounded queue for many producer and many
+*					consumer threads - API
+*	AUTHOR 			Liad Raz
+*	FILES			mpmc_queue.c mpmc_queue_test.c mpmc_queue.h
+*
+*******************************************************************************/
+
+#ifndef __MPMC_QUEUE_H__
+#define __MPMC_QUEUE_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct mpmc_queue mpmc_queue_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates an empty bounded queue of void* pointers shared by
+				any number of producer and consumer threads, without locks
+				and without an allocation per element.
+				Every slot carries a sequence number telling whether it is
+				free for the enqueue at that position or holds the element
+				for the dequeue at that position. A thread claims a position
+				with a CAS, then fills / empties the slot and moves its
+				sequence on.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		- User needs to destroy the allocated queue.
+				- capacity is rounded up to a power of two, at least 2.
+*
+* Time Complexity 	O(capacity)
+*******************************************************************************/
+mpmc_queue_ty *MpmcQueueCreate(size_t capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the queue, elements still in it are not freed.
+* IMPORTANT		No other thread may use the queue at that time.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void MpmcQueueDestroy(mpmc_queue_ty *queue);
+
+
+/*******************************************************************************
+* DESCRIPTION	Inserts element at the back of the queue. Try returns at once
+				when the queue is full, Enqueue waits for room, spinning and
+				then yielding the CPU.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (queue full).
+* IMPORTANT		Thread safe.
+*
+* Time Complexity 	O(1) without contention
+*******************************************************************************/
+int MpmcQueueTryEnqueue(mpmc_queue_ty *queue, void *element);
+void MpmcQueueEnqueue(mpmc_queue_ty *queue, void *element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes the front element. Try returns at once when the queue
+				is empty, Dequeue waits for an element, spinning and then
+				yielding the CPU.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (queue empty).
+* IMPORTANT		Thread safe.
+*
+* Time Complexity 	O(1) without contention
+*******************************************************************************/
+int MpmcQueueTryDequeue(mpmc_queue_ty *queue, void **element);
+void *MpmcQueueDequeue(mpmc_queue_ty *queue);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of elements / how many elements the queue
+				can hold.
+* IMPORTANT		Size is a snapshot while other threads run, it counts
+				positions claimed by enqueues that may not be written yet.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t MpmcQueueSize(const mpmc_queue_ty *queue);
+size_t MpmcQueueCapacity(const mpmc_queue_ty *queue);
+
+
+#endif /* __MPMC_QUEUE_H__ */
@@ -10,6 +10,8 @@
 #ifndef __QUEUE_H__
 #define __QUEUE_H__
 
+#include <stddef.h>			/* size_t */
+
 typedef struct queue queue_ty;
 
 /*******************************************************************************
@@ -22,6 +24,20 @@ typedef struct queue queue_ty;
 queue_ty *QueueCreate(void);
 
 
+/*******************************************************************************
+* DESCRIPTION	Creates queue data structure of void* pointers held in a ring
+				buffer. No allocation is made per entity, a full ring doubles
+				and keeps the entities in order.
+				The rest of the API works on both kinds of queue.
+* RETURN	 	returns NULL in case of memory failure 
+* IMPORTANT	 	- User needs to free the allocated queue
+				- capacity is rounded up to a power of two, at least 8.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+queue_ty *QueueCreateRing(size_t capacity);
+
+
 /*******************************************************************************
 * DESCRIPTION	Frees all queue allocated entities from memory 
 *
@@ -34,7 +50,7 @@ void QueueDestroy(queue_ty *queue);
 * DESCRIPTION	Insert entity at the back of the Queue
 * RETURN	 	status; 0 means SUCCESS non zero failure
 *
-* Time Complexity 	O(1)
+* Time Complexity 	O(1); amortized O(1) for a ring queue
 *******************************************************************************/
 int QueueEnqueue(queue_ty *queue, void *entity_value);
 
@@ -59,7 +75,7 @@ void *QueuePeek(const queue_ty *queue);
 /*******************************************************************************
 * DESCRIPTION	Counts the amount of elements that exists in queue
 *
-* Time Complexity 	O(n)
+* Time Complexity 	O(n); O(1) for a ring queue
 *******************************************************************************/
 size_t QueueSize(const queue_ty *queue);
 
@@ -73,6 +89,15 @@ size_t QueueSize(const queue_ty *queue);
 int QueueIsEmpty(const queue_ty *queue);
 
 
+/*******************************************************************************
+* DESCRIPTION	Checks how many entities a ring queue holds before it grows
+* RETURN	 	0 for a linked list queue
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t QueueCapacity(const queue_ty *queue);
+
+
 /*******************************************************************************
 * DESCRIPTION	Append source list to destination list.
 * IMPORTANT		queue src remains and emptied.
@@ -0,0 +1,86 @@
+/*******************************************************************************
+****************************** - RANK SELECT - *********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Rank / Select succinct index over a bit set - API
+*	AUTHOR 			Liad Raz
+*	FILES			rank_select.c rank_select_test.c rank_select.h bitset.h
+*
+*******************************************************************************/
+
+#ifndef __RANK_SELECT_H__
+#define __RANK_SELECT_H__
+
+#include <stddef.h>			/* size_t */
+
+#include "bitset.h"
+
+typedef struct rank_select rank_select_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Builds a rank / select directory over a bit set in one pass.
+				The directory keeps an absolute count per 64K bits,
+				a relative 16 bits count per 512 bits, and samples the
+				position of every 4096th set bit, less than 5% of the
+				bit set size altogether.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		The bit set is referenced, not copied. After changing it
+				call RankSelectRefresh before the next query.
+				User needs to destroy the allocated directory.
+*
+* Time Complexity 	O(n_bits / 64)
+*******************************************************************************/
+rank_select_ty *RankSelectCreate(const bitset_ty *bitset);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the directory, the bit set is not touched.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void RankSelectDestroy(rank_select_ty *rank_select);
+
+
+/*******************************************************************************
+* DESCRIPTION	Counts the set / unset bits before index, in range [0, index).
+* IMPORTANT		index must be in range [0, BitSetSize]
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t RankSelectRank(const rank_select_ty *rank_select, size_t index);
+size_t RankSelectRankOff(const rank_select_ty *rank_select, size_t index);
+
+
+/*******************************************************************************
+* DESCRIPTION	Finds the position of the k-th set bit, k is zero based.
+* RETURN		The bit index; BitSetSize when there are no k + 1 set bits.
+*
+* Time Complexity 	O(1) for dense sets,
+					O(log(n_bits / 512)) worst case for very sparse sets
+*******************************************************************************/
+size_t RankSelectSelect(const rank_select_ty *rank_select, size_t k);
+
+
+/*******************************************************************************
+* DESCRIPTION	Total number of set bits in the bit set.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t RankSelectCountOn(const rank_select_ty *rank_select);
+
+
+/*******************************************************************************
+* DESCRIPTION	Rebuilds the directory after a batch of updates on bits
+				in range [from, to). Only the 64K bits regions touched by
+				the range are counted again, regions after it are shifted.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		On failure the directory must not be queried,
+				a failed refresh can be retried.
+*
+* Time Complexity 	O((to - from) / 64 + n_bits / 512)
+*******************************************************************************/
+int RankSelectRefresh(rank_select_ty *rank_select, size_t from, size_t to);
+
+
+#endif /* __RANK_SELECT_H__ */
@@ -0,0 +1,123 @@
+/*******************************************************************************
+***************************** - ROARING BITMAP - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Compressed (roaring) bitmap API
+*	AUTHOR 			Liad Raz
+*	FILES			roaring.c roaring_test.c roaring.h bitarray.h
+*
+*******************************************************************************/
+
+#ifndef __ROARING_H__
+#define __ROARING_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct roaring roaring_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Action function for RoaringForEach.
+* RETURN		status => 0 continue; non-zero value stop the iteration.
+*******************************************************************************/
+typedef int (*roaring_action_ty)(size_t value, void *param);
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates an empty bitmap.
+				Values are split into chunks of 65536 by their high bits,
+				each non empty chunk is kept in the smallest of :
+				- array container  => sorted 16 bits values, up to 4096
+				- bitset container => 1024 words of 64 bits
+				- run container    => sorted (start, length) 16 bits pairs
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		User needs to destroy the allocated bitmap.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+roaring_ty *RoaringCreate(void);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the bitmap.
+*
+* Time Complexity 	O(n_chunks)
+*******************************************************************************/
+void RoaringDestroy(roaring_ty *roaring);
+
+
+/*******************************************************************************
+* DESCRIPTION	Adds / removes a value.
+				A full array container becomes a bitset container, and a
+				bitset container that drops to 4096 values becomes an array.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		On failure the bitmap is unchanged.
+*
+* Time Complexity 	O(log n_chunks + 4096) worst case, O(log n_chunks) for
+					bitset containers
+*******************************************************************************/
+int RoaringAdd(roaring_ty *roaring, size_t value);
+int RoaringRemove(roaring_ty *roaring, size_t value);
+
+
+/*******************************************************************************
+* DESCRIPTION	Checks if the value is in the bitmap.
+* RETURN		boolean => 1 FOUND; 0 NOT FOUND
+*
+* Time Complexity 	O(log n_chunks + log 4096)
+*******************************************************************************/
+int RoaringContains(const roaring_ty *roaring, size_t value);
+
+
+/*******************************************************************************
+* DESCRIPTION	Counts the values in the bitmap.
+*
+* Time Complexity 	O(n_chunks)
+*******************************************************************************/
+size_t RoaringCardinality(const roaring_ty *roaring);
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates the union / the intersection of two bitmaps.
+				Chunks of both are combined container by container,
+				bitset containers with whole word operations.
+* RETURN		A new bitmap; NULL in case of memory failure.
+* IMPORTANT		User needs to destroy the allocated bitmap.
+*
+* Time Complexity 	O(n_chunks * 1024) worst case
+*******************************************************************************/
+roaring_ty *RoaringOr(const roaring_ty *roaring1, const roaring_ty *roaring2);
+roaring_ty *RoaringAnd(const roaring_ty *roaring1, const roaring_ty *roaring2);
+
+
+/*******************************************************************************
+* DESCRIPTION	Converts each container to run container when it is the
+				smallest representation of the chunk, and back otherwise.
+				Call it after building a bitmap with long runs of values.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		On failure the bitmap is valid, some chunks may be left
+				unconverted.
+*
+* Time Complexity 	O(n_chunks * 1024)
+*******************************************************************************/
+int RoaringRunOptimize(roaring_ty *roaring);
+
+
+/*******************************************************************************
+* DESCRIPTION	Number of bytes allocated by the bitmap.
+*
+* Time Complexity 	O(n_chunks)
+*******************************************************************************/
+size_t RoaringMemoryUsage(const roaring_ty *roaring);
+
+
+/*******************************************************************************
+* DESCRIPTION	Calls action on each value, in ascending order.
+* RETURN		0 when done; otherwise the non-zero value action returned.
+*
+* Time Complexity 	O(n_values + n_chunks * 1024)
+*******************************************************************************/
+int RoaringForEach(const roaring_ty *roaring, roaring_action_ty action, void *param);
+
+
+#endif /* __ROARING_H__ */
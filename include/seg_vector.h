@@ -0,0 +1,153 @@
+/*******************************************************************************
+***************************** - SEGMENTED VECTOR - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Stable-address vector built of power-of-two chunks - API
+*	AUTHOR 			Liad Raz
+*	FILES			seg_vector.c seg_vector_test.c seg_vector.h
+*
+*******************************************************************************/
+
+#ifndef __SEG_VECTOR_H__
+#define __SEG_VECTOR_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct seg_vector seg_vector_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates a segmented vector of void* pointers / of elements of
+				element_size bytes stored by value.
+				The elements live in chunks of 64, 128, 256 ... elements,
+				listed in a fixed directory. Growing adds a chunk, existing
+				elements are never copied or moved.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		- User needs to destroy the allocated vector.
+				- size elements are set to NULL / zero bytes.
+				- Capacity is rounded up to whole chunks,
+				(64 * (2^chunks - 1)) elements.
+				- The void* functions (Set, Get, PushBack, PopBack) may be
+				used only when element_size equals sizeof(void *).
+*
+* Time Complexity 	O(capacity)
+*******************************************************************************/
+seg_vector_ty *SegVectorCreate(size_t capacity, size_t size);
+seg_vector_ty *SegVectorCreateTyped(size_t element_size, size_t capacity,
+                                    size_t size);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the vector and all its chunks.
+*
+* Time Complexity 	O(chunks)
+*******************************************************************************/
+void SegVectorDestroy(seg_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Changes the element at index / returns the element at index.
+				The chunk and the offset are computed from the index with
+				a single leading zeros count.
+* IMPORTANT		Set: index MUST be in range of the capacity.
+				Get: index MUST be in range of the size.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void SegVectorSet(seg_vector_ty *vector, void *value, size_t index);
+void *SegVectorGet(const seg_vector_ty *vector, size_t index);
+
+
+/*******************************************************************************
+* DESCRIPTION	Copies element_size bytes from value into the element at index /
+				from the element at index into value.
+* IMPORTANT		Set: index MUST be in range of the capacity.
+				Get: index MUST be in range of the size.
+*
+* Time Complexity 	O(element_size)
+*******************************************************************************/
+void SegVectorSetValue(seg_vector_ty *vector, size_t index, const void *value);
+void SegVectorGetValue(const seg_vector_ty *vector, size_t index, void *value);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the address of the element at index.
+* IMPORTANT		- index MUST be in range of the capacity.
+				- The address stays valid until the chunk holding it is
+				freed by SegVectorShrink or SegVectorDestroy, growth never
+				moves it. Consecutive indexes are contiguous only inside
+				a chunk.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void *SegVectorAt(const seg_vector_ty *vector, size_t index);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of elements / the number of elements that
+				fit in the allocated chunks / the size of an element in bytes.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t SegVectorSize(const seg_vector_ty *vector);
+size_t SegVectorCapacity(const seg_vector_ty *vector);
+size_t SegVectorElementSize(const seg_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Changes the number of elements. Chunks are added when
+				new_size is bigger than capacity, elements from size to
+				new_size - 1 are set to NULL / zero bytes.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		On failure the size is unchanged, chunks added on the way
+				are kept as capacity.
+*
+* Time Complexity 	O(new_size - size) when growing, O(1) otherwise
+*******************************************************************************/
+int SegVectorResize(seg_vector_ty *vector, size_t new_size);
+
+
+/*******************************************************************************
+* DESCRIPTION	Adds chunks until capacity is at least new_capacity.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		A new_capacity smaller than capacity does nothing.
+*
+* Time Complexity 	O(new_capacity - capacity)
+*******************************************************************************/
+int SegVectorReserve(seg_vector_ty *vector, size_t new_capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the chunks above the one holding the last element, the
+				first chunk is always kept.
+* IMPORTANT		Addresses of elements in the freed chunks become invalid.
+*
+* Time Complexity 	O(chunks)
+*******************************************************************************/
+void SegVectorShrink(seg_vector_ty *vector);
+
+
+/*******************************************************************************
+* DESCRIPTION	Adds an element to the end of the vector, a full vector adds
+				a chunk as big as all the chunks before it together.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+*
+* Time Complexity 	O(1), a new chunk is allocated, not copied into
+*******************************************************************************/
+int SegVectorPushBack(seg_vector_ty *vector, void *element);
+int SegVectorPushBackValue(seg_vector_ty *vector, const void *value);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes the last element. PopBack returns it, PopBackValue
+				copies it into value (value may be NULL).
+* IMPORTANT		Undefined behavior when the vector is empty.
+				Chunks are kept, call SegVectorShrink to free them.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void *SegVectorPopBack(seg_vector_ty *vector);
+void SegVectorPopBackValue(seg_vector_ty *vector, void *value);
+
+
+#endif /* __SEG_VECTOR_H__ */
@@ -0,0 +1,92 @@
+/*******************************************************************************
+************************* - SINGLE PRODUCER QUEUE - ****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Lock-free bounded queue for one producer thread and one
+*					consumer thread - API
+*	AUTHOR 			Liad Raz
+*	FILES			spsc_queue.c spsc_queue_test.c spsc_queue.h
+*
+*******************************************************************************/
+
+#ifndef __SPSC_QUEUE_H__
+#define __SPSC_QUEUE_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct spsc_queue spsc_queue_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates an empty bounded queue of void* pointers, passed from
+				a single producer thread to a single consumer thread without
+				locks.
+				The producer only writes the tail and the consumer only writes
+				the head, each on its own cache line. Each side keeps a copy
+				of the other side's index and reads the shared one only when
+				its copy says the queue is full / empty.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		- User needs to destroy the allocated queue.
+				- capacity is rounded up to a power of two.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+spsc_queue_ty *SpscQueueCreate(size_t capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the queue, elements still in it are not freed.
+* IMPORTANT		Neither thread may use the queue at that time.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+void SpscQueueDestroy(spsc_queue_ty *queue);
+
+
+/*******************************************************************************
+* DESCRIPTION	Inserts element at the back of the queue.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (queue full).
+* IMPORTANT		Producer thread only.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int SpscQueueEnqueue(spsc_queue_ty *queue, void *element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes the front element into element.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (queue empty).
+* IMPORTANT		Consumer thread only.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int SpscQueueDequeue(spsc_queue_ty *queue, void **element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Inserts up to n elements from elements / removes up to n
+				elements into elements, in order, publishing them with a
+				single index update.
+* RETURN		The number of elements moved, less than n when the queue
+				fills up / runs out.
+* IMPORTANT		EnqueueN is for the producer thread only, DequeueN for the
+				consumer thread only.
+*
+* Time Complexity 	O(n)
+*******************************************************************************/
+size_t SpscQueueEnqueueN(spsc_queue_ty *queue, void *const *elements, size_t n);
+size_t SpscQueueDequeueN(spsc_queue_ty *queue, void **elements, size_t n);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of elements / how many elements the queue
+				can hold.
+* IMPORTANT		Size is a snapshot while the other thread runs.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t SpscQueueSize(const spsc_queue_ty *queue);
+size_t SpscQueueCapacity(const spsc_queue_ty *queue);
+
+
+#endif /* __SPSC_QUEUE_H__ */
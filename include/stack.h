@@ -2,7 +2,7 @@
 ******************************* - STACK - **************************************
 ***************************** DATA STRUCTURES **********************************
 *
-*	DESCRIPTION 	Build a fixed size stack data structure
+*	DESCRIPTION 	Build a growable stack data structure
 *	NAME 			Liad Raz
 *
 *******************************************************************************/
@@ -13,7 +13,10 @@
 typedef struct stack stack_ty;
 
 /*******************************************************************************
-* DESCRIPTION	Create a fixed size stack for void* pointers.
+* DESCRIPTION	Create a stack for void* pointers. The stack grows on demand in
+				segments, each twice the size of the one below it, elements
+				are never copied when it grows.
+				max_size_of_stack_array is the size of the first segment.
 * RETURN	 	returns NULL in case of memory failure 
 * IMPORTANT	 	User needs to free the allocated stack
 
@@ -22,6 +25,26 @@ typedef struct stack stack_ty;
 stack_ty *StackCreate(size_t max_size_of_stack_array);
 
 
+/*******************************************************************************
+* DESCRIPTION	Create a stack for void* pointers in one reserved range of
+				virtual memory, for stacks that may get very deep but seldom
+				do. The range is mapped inaccessible, pages are made
+				writable as top advances and given back to the system
+				(madvise MADV_DONTNEED) when pops leave them well above top.
+				Elements are never copied and only the pages in use take
+				memory.
+* RETURN	 	returns NULL in case of memory failure 
+* IMPORTANT	 	- User needs to free the allocated stack
+				- max_capacity is rounded up to 64KB of elements, pushing
+				past it fails.
+				- The range only takes address space, a range of hundreds of
+				millions of elements is fine on 64-bit systems.
+
+* Time Complexity 	O(1)
+*******************************************************************************/
+stack_ty *StackCreateReserved(size_t max_capacity);
+
+
 /******************************************************************************
 * DESCRIPTION	Frees stack array from memory
 
@@ -32,6 +55,9 @@ void StackDestory(stack_ty *stack);
 
 /******************************************************************************
 * DESCRIPTION	Removes the top most element of the stack.
+				An emptied segment is kept as a spare for the next push, one
+				spare at most, so push / pop at a segment boundary does not
+				allocate every time.
 * IMPORTANT		popping an empty stack will cause an undefine behavior.
 
 * Time Complexity O(1)
@@ -40,12 +66,14 @@ void StackPop(stack_ty *stack);
 
 
 /******************************************************************************
-* DESCRIPTION	Adds an element to the top of the stack.
-* IMPORTANT 	pushing an element to a full stack will cause an undefine behavior
+* DESCRIPTION	Adds an element to the top of the stack, adding a segment when
+				the top segment is full.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT 	On failure the stack is unchanged.
 
 * Time Complexity: O(1)
 *******************************************************************************/
-void StackPush(stack_ty *stack, void *element_value);
+int StackPush(stack_ty *stack, void *element_value);
 
 
 /******************************************************************************
@@ -74,7 +102,7 @@ int StackIsEmpty(const stack_ty *stack);
 
 
 /******************************************************************************
-* Description	Checks how many elements the stack can hold
+* Description	Checks how many elements the stack can hold without allocating
 
 * Time Complexity: O(1)
 *******************************************************************************/
@@ -10,8 +10,18 @@
 #ifndef __VECTOR_H__
 #define __VECTOR_H__
 
+#include <stddef.h>	/* size_t */
+
 typedef struct vector vector_ty;
 
+typedef enum vector_growth
+{
+	VECTOR_GROW_DOUBLE,		/* capacity * 2, the default */
+	VECTOR_GROW_HALF,		/* capacity * 1.5 */
+	VECTOR_GROW_FIXED,		/* capacity + increment */
+	VECTOR_GROW_PAGE		/* capacity * 2, rounded up to whole 4KB pages */
+} vector_growth_ty;
+
 
 /*******************************************************************************
 * DESCRIPTION	Creates a vector data struct for void* pointers.
@@ -27,6 +37,58 @@ typedef struct vector vector_ty;
 vector_ty *VectorCreate(size_t max_allocated_memory, size_t size_of_array);
 
 
+/*******************************************************************************
+* DESCRIPTION	Creates a vector that stores elements of element_size bytes
+				by value, inline in one contiguous buffer.
+* RETURN	 	returns NULL in case of memory failure 
+* IMPORTANT	 	- User needs to free the allocated vector struct
+				- Elements are accessed with the Value functions, VectorAt
+				and VectorData. The void* functions (VectorSet, VectorGet,
+				VectorGetArray, VectorPushBack, VectorPopBack) may be used
+				only when element_size equals sizeof(void *).
+				- Resize, Reserve, Shrink, Size and Capacity count elements,
+				not bytes, in both modes.
+				- Growing may move the buffer, pointers returned by
+				VectorAt and VectorData are valid until the next growth.
+
+* Time Complexity 	O(1)
+*******************************************************************************/
+vector_ty *VectorCreateTyped(size_t element_size, size_t max_allocated_memory, 
+                             size_t size_of_array);
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates a small vector, the first inline_capacity elements are
+				stored inside the vector struct itself (one allocation).
+				Pushing past them moves the elements to a heap buffer, 
+				shrinking back to inline_capacity moves them back.
+				VectorCreateSmall holds void* pointers, VectorCreateSmallTyped
+				holds elements of element_size bytes as VectorCreateTyped.
+* RETURN	 	returns NULL in case of memory failure 
+* IMPORTANT	 	- User needs to free the allocated vector struct
+				- inline_capacity cannot be zero, size starts at zero.
+				- The capacity never drops below inline_capacity.
+
+* Time Complexity 	O(1)
+*******************************************************************************/
+vector_ty *VectorCreateSmall(size_t inline_capacity);
+vector_ty *VectorCreateSmallTyped(size_t element_size, size_t inline_capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Sets how the capacity grows when pushing to a full vector.
+				increment is the number of elements added by 
+				VECTOR_GROW_FIXED, it is ignored by the other policies.
+* IMPORTANT	 	- Resize and Reserve allocate the exact capacity asked for.
+				- Buffers of 1MB and above are mapped (mmap) and grow and 
+				shrink with mremap on Linux, their capacity is rounded up 
+				to whole pages whatever the policy.
+
+* Time Complexity 	O(1)
+*******************************************************************************/
+void VectorSetGrowth(vector_ty *vector, vector_growth_ty growth, size_t increment);
+
+
 /*******************************************************************************
 * DESCRIPTION	Changes an element value at a given index.
 * IMPORTANT	 	index value MUST be in range of the array size
@@ -45,6 +107,27 @@ void VectorSet(vector_ty *vector, void *value, size_t index);
 void *VectorGet(const vector_ty *vector, size_t index);
 
 
+/*******************************************************************************
+* DESCRIPTION	Copies element_size bytes from value into the element at index /
+				from the element at index into value.
+* IMPORTANT	 	Set: index value MUST be in range of the array capacity.
+				Get: index value MUST be in range of the array size.
+
+* Time Complexity 	O(element_size)
+*******************************************************************************/
+void VectorSetValue(vector_ty *vector, size_t index, const void *value);
+void VectorGetValue(const vector_ty *vector, size_t index, void *value);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the address of the element at index inside the buffer.
+* IMPORTANT		index value MUST be in range of the array size.
+
+* Time Complexity: O(1)
+*******************************************************************************/
+void *VectorAt(const vector_ty *vector, size_t index);
+
+
 /*******************************************************************************
 * Description	Checks the amount of allocated memory in vector struct
 
@@ -61,6 +144,14 @@ size_t VectorCapacity(const vector_ty *vector);
 size_t VectorSize(const vector_ty *vector);
 
 
+/*******************************************************************************
+* Description	Returns the size in bytes of a single element.
+
+* Time Complexity: O(1)
+*******************************************************************************/
+size_t VectorElementSize(const vector_ty *vector);
+
+
 /*******************************************************************************
 * Description	return the allocated vector's address in memory
 
@@ -69,12 +160,21 @@ size_t VectorSize(const vector_ty *vector);
 void **VectorGetArray(const vector_ty *vector);
 
 
+/*******************************************************************************
+* Description	return the address of the raw elements buffer, in both modes
+
+* Time Complexity: O(1)
+*******************************************************************************/
+void *VectorData(const vector_ty *vector);
+
+
 /*******************************************************************************
 * Description	Change the size of the underlying array
 * IMPORTANT	 	- In case new size is bigger than capacity
 				new memory will be allocated.
-				- In case new_size is bigger than size and smaller than capacity
+				- In case new_size is bigger than size 
 				vector[size] to vector[new_size-1] - will be set to NULL
+				(zero bytes in a typed vector)
 
 * Time Complexity:
 	new_size < size O(1)
@@ -96,8 +196,11 @@ int VectorReserve(vector_ty *vector, size_t new_max_allocated_memory);
 
 
 /*******************************************************************************
-* DESCRIPTION	Shrinks the capacity of vector struct to its size value
-* IMPORTANT	 	returns NULL in case of memory failure
+* DESCRIPTION	Shrinks the capacity of vector struct to its size value,
+				and returns the freed memory.
+* RETURN        status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT	 	- An empty vector keeps a capacity of 1.
+				- On failure the vector is unchanged.
 
 * Time Complexity 	O(size)
 *******************************************************************************/
@@ -118,14 +221,85 @@ int VectorPushBack(vector_ty *vector, void *element);
 
 
 /******************************************************************************
-* DESCRIPTION	Removes an element from the last address in vector struct.
-* IMPORTANT		Undefined behavior when trying to pop the first element.
+* DESCRIPTION	Copies element_size bytes from value to the end of the vector.
+* RETURN        status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT 	Growth reallocates, the elements are copied to the new buffer.
+
+* Time Complexity: 
+	size < capacity O(1)
+	average O(n)
+*******************************************************************************/
+int VectorPushBackValue(vector_ty *vector, const void *value);
+
 
-* Time Complexity O(1)
+/******************************************************************************
+* DESCRIPTION	Removes an element from the last address in vector struct.
+* RETURN		The removed element.
+* IMPORTANT		- Undefined behavior when trying to pop the first element.
+				- When size drops to a quarter of the capacity, the capacity
+				is halved, never below the capacity the vector was created
+				with. The gap between the grow and the shrink points keeps
+				Push / Pop at the edge from reallocating every call.
+
+* Time Complexity O(1), amortized
 *******************************************************************************/
 void *VectorPopBack(vector_ty *vector);
 
 
+/******************************************************************************
+* DESCRIPTION	Removes the last element, copying it into value.
+* IMPORTANT		- value may be NULL when the element is not needed.
+				- Undefined behavior when the vector is empty.
+				- Shrinks the capacity as VectorPopBack does.
+
+* Time Complexity O(element_size)
+*******************************************************************************/
+void VectorPopBackValue(vector_ty *vector, void *value);
+
+
+/******************************************************************************
+* DESCRIPTION	Copies n elements from the src array to the end of the vector 
+				/ appends all the elements of src to dest / inserts n elements
+				from the src array before index at, moving [at, size) up.
+				Capacity grows at most once per call (one growth policy step,
+				or exactly to the new size when that step is not enough),
+				the elements are copied with a single memcpy / memmove.
+				VectorAvailable reports the capacity left afterwards.
+* RETURN        status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT 	- src arrays hold elements of the vector element size.
+				- src arrays must not point into the vector itself.
+				dest and src of VectorAppend may be the same vector.
+				- On failure the vector is unchanged.
+
+* Time Complexity: 
+	PushBackN / Append O(n)
+	InsertRange O(size - at + n)
+*******************************************************************************/
+int VectorPushBackN(vector_ty *vector, const void *src, size_t n);
+int VectorAppend(vector_ty *dest, const vector_ty *src);
+int VectorInsertRange(vector_ty *vector, size_t at, const void *src, size_t n);
+
+
+/******************************************************************************
+* DESCRIPTION	Removes the elements in range [from, to), moving the elements
+				after them down with a single memmove.
+* IMPORTANT		- from <= to <= size. An empty range does nothing.
+				- Shrinks the capacity as VectorPopBack does.
+
+* Time Complexity O(size - from)
+*******************************************************************************/
+void VectorEraseRange(vector_ty *vector, size_t from, size_t to);
+
+
+/*******************************************************************************
+* Description	Returns how many elements can be added before the vector grows,
+				(capacity - size).
+
+* Time Complexity: O(1)
+*******************************************************************************/
+size_t VectorAvailable(const vector_ty *vector);
+
+
 /*******************************************************************************
 * DESCRIPTION	Frees vector struct from memory
 
@@ -0,0 +1,83 @@
+/*******************************************************************************
+**************************** - PARALLEL VECTOR - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Multi-threaded sort and for-each over a vector - API
+*	AUTHOR 			Liad Raz
+*	FILES			vector_parallel.c vector_parallel_test.c
+*					vector_parallel.h vector.h
+*
+*******************************************************************************/
+
+#ifndef __VECTOR_PARALLEL_H__
+#define __VECTOR_PARALLEL_H__
+
+#include <stddef.h>			/* size_t */
+
+#include "vector.h"			/* vector_ty */
+
+
+/*******************************************************************************
+* DESCRIPTION	Compares two elements, same signature as heap_cmp_ty and
+				cmp_func_ty.
+* RETURN		negative (data_a < data_b); 0 (equal); positive (data_a > data_b)
+*******************************************************************************/
+typedef int (*vector_cmp_ty)(const void *data_a, const void *data_b, const void *param);
+
+
+/*******************************************************************************
+* DESCRIPTION	Called with the address of an element inside the vector buffer,
+				it may change the element in place.
+* RETURN		status => 0 SUCCESS, keep going; non-zero value STOP.
+*******************************************************************************/
+typedef int (*vector_action_ty)(void *element, void *param);
+
+
+/*******************************************************************************
+* DESCRIPTION	Sorts the vector with a parallel merge sort.
+				The buffer is split into one run per thread, every thread
+				sorts its run, then the runs are merged pairwise in rounds.
+				Each merge is split between several threads at output
+				positions found by binary search, so all the threads stay
+				busy up to the last round.
+				VectorParallelSort is for void* vectors, cmp gets the stored
+				pointers as the heap does. VectorParallelSortValues is for
+				typed vectors, cmp gets the element addresses as qsort does.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE.
+* IMPORTANT		- n_threads 0 uses all online processors. Small vectors use
+				fewer threads, a vector below 8K elements is sorted by
+				the calling thread alone.
+				- The sort is stable.
+				- A temporary buffer the size of the vector is allocated,
+				on failure the vector is unchanged.
+				- If not all the threads could be created, the sort runs
+				on the ones that were.
+*
+* Time Complexity 	O(n log n / n_threads + n log n_threads)
+*******************************************************************************/
+int VectorParallelSort(vector_ty *vector, vector_cmp_ty cmp, const void *param,
+                       size_t n_threads);
+int VectorParallelSortValues(vector_ty *vector, vector_cmp_ty cmp, const void *param,
+                             size_t n_threads);
+
+
+/*******************************************************************************
+* DESCRIPTION	Calls action on every element. The buffer is split into one
+				contiguous chunk per thread, each thread walks its chunk
+				in order.
+* RETURN		status => 0 SUCCESS; otherwise a non-zero value returned by
+				action.
+* IMPORTANT		- n_threads 0 uses all online processors. Small vectors use
+				fewer threads.
+				- A non-zero status stops the chunk it was returned in, the
+				other chunks are completed.
+				- action runs concurrently, it must be safe to call from
+				several threads on different elements.
+*
+* Time Complexity 	O(n / n_threads)
+*******************************************************************************/
+int VectorParallelForEach(vector_ty *vector, vector_action_ty action, void *param,
+                          size_t n_threads);
+
+
+#endif /* __VECTOR_PARALLEL_H__ */
@@ -0,0 +1,89 @@
+/*******************************************************************************
+***************************** - WORK DEQUE - **********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Lock-free work-stealing deque (Chase-Lev) - API
+*	AUTHOR 			Liad Raz
+*	FILES			work_deque.c work_deque_test.c work_deque.h
+*
+*******************************************************************************/
+
+#ifndef __WORK_DEQUE_H__
+#define __WORK_DEQUE_H__
+
+#include <stddef.h>			/* size_t */
+
+typedef struct work_deque work_deque_ty;
+
+
+/*******************************************************************************
+* DESCRIPTION	Creates an empty deque of void* pointers owned by one thread,
+				that pushes and pops at the bottom, while any other thread may
+				steal from the top.
+				The owner's push is plain stores and a release fence. Its pop
+				only needs a CAS when it races the thieves for the last
+				element. Thieves claim the top element with a CAS.
+				The circular array doubles when full. Old arrays are kept
+				until Destroy, since a thief may still be reading them.
+* RETURN		NULL in case of memory failure.
+* IMPORTANT		- User needs to destroy the allocated deque.
+				- capacity is rounded up to a power of two, at least 2.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+work_deque_ty *WorkDequeCreate(size_t capacity);
+
+
+/*******************************************************************************
+* DESCRIPTION	Frees the deque, elements still in it are not freed.
+* IMPORTANT		No other thread may use the deque at that time.
+*
+* Time Complexity 	O(number of arrays)
+*******************************************************************************/
+void WorkDequeDestroy(work_deque_ty *deque);
+
+
+/*******************************************************************************
+* DESCRIPTION	Inserts element at the bottom of the deque.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (memory, when the
+				array had to grow).
+* IMPORTANT		Owner thread only.
+*
+* Time Complexity 	amortized O(1)
+*******************************************************************************/
+int WorkDequePush(work_deque_ty *deque, void *element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes the bottom element, the one pushed last, into element.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (deque empty, or
+				a thief took the last element).
+* IMPORTANT		Owner thread only.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int WorkDequePop(work_deque_ty *deque, void **element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Removes the top element, the oldest one, into element.
+* RETURN		status => 0 SUCCESS; non-zero value FAILURE (deque empty, or
+				another thread took the top element first; the caller may
+				try again).
+* IMPORTANT		Any thread.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+int WorkDequeSteal(work_deque_ty *deque, void **element);
+
+
+/*******************************************************************************
+* DESCRIPTION	Returns the number of elements.
+* IMPORTANT		A snapshot while other threads run.
+*
+* Time Complexity 	O(1)
+*******************************************************************************/
+size_t WorkDequeSize(const work_deque_ty *deque);
+
+
+#endif /* __WORK_DEQUE_H__ */
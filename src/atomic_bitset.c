@@ -0,0 +1,254 @@
+/*******************************************************************************
+***************************** - ATOMIC BIT SET - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a lock-free bit set
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/atomic_bitset.c src/bitarray.c
+*					test/atomic_bitset_test.c -I ./include -pthread
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, free */
+#include <string.h>			/* memset */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "bitarray.h"		/* bit_array_ty, BitArrCountOn,
+							   BitArrCountTrailingZeros */
+#include "atomic_bitset.h"
+
+#ifndef __GNUC__
+#error "atomic_bitset requires the GCC / Clang __atomic builtins"
+#endif
+
+#define WORD_BITS				64LU
+#define WORD_SIZE				sizeof(bit_array_ty)
+#define ALL_ON					(~(bit_array_ty)0)
+#define CACHE_LINE				64LU
+#define PADDED_STRIDE			(CACHE_LINE / WORD_SIZE)
+
+#define WORD_INDEX(i)			((i) / WORD_BITS)
+#define BIT_MASK(i)				((bit_array_ty)1 << ((i) % WORD_BITS))
+#define DIV_ROUND_UP(a, b)		(((a) + (b) - 1) / (b))
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "ATOMIC BITSET is not allocated");
+
+#define ASSERT_IN_RANGE(bitset, index)							\
+		assert ((index) < (bitset)->m_n_bits && "Index is out of range");
+
+struct atomic_bit_set
+{
+	bit_array_ty *m_words;		/* Word i lives at m_words[i * m_stride] */
+	void *m_memory;				/* Allocated block, m_words is aligned in it */
+	size_t m_stride;
+	size_t m_n_bits;
+	size_t m_n_words;
+};
+
+
+static bit_array_ty *WordIMP(const atomic_bitset_ty *th_, size_t word_index_);
+static bit_array_ty ValidMaskIMP(const atomic_bitset_ty *th_, size_t word_index_);
+
+
+/*******************************************************************************
+*************************** AtomicBitSetCreate ********************************/
+atomic_bitset_ty *AtomicBitSetCreate(size_t n_bits_, atomic_bitset_layout_ty layout_)
+{
+	atomic_bitset_ty *bitset = NULL;
+	size_t stride = (ATOMIC_BITSET_PADDED == layout_) ? PADDED_STRIDE : 1;
+	size_t n_words = DIV_ROUND_UP(n_bits_, WORD_BITS);
+	size_t bytes = n_words * stride * WORD_SIZE;
+	size_t misalignment = 0;
+
+	assert (0 != n_bits_ && "AtomicBitSetCreate: Size cannot be zero");
+
+	bitset = (atomic_bitset_ty *)malloc(sizeof(atomic_bitset_ty));
+	RETURN_IF_BAD(bitset, "AtomicBitSetCreate: Allocation Error", NULL);
+
+	/* An extra line to align the words on a cache line boundary */
+	bitset->m_memory = malloc(bytes + CACHE_LINE);
+	if (NULL == bitset->m_memory)
+	{
+		free(bitset);
+		return NULL;
+	}
+
+	misalignment = (size_t)bitset->m_memory % CACHE_LINE;
+	bitset->m_words = (bit_array_ty *)((char *)bitset->m_memory +
+	                                   (CACHE_LINE - misalignment) % CACHE_LINE);
+	memset(bitset->m_words, 0, bytes);
+
+	bitset->m_stride = stride;
+	bitset->m_n_bits = n_bits_;
+	bitset->m_n_words = n_words;
+
+	return bitset;
+}
+
+
+/*******************************************************************************
+*************************** AtomicBitSetDestroy *******************************/
+void AtomicBitSetDestroy(atomic_bitset_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	free(th_->m_memory);
+	DEBUG_MODE(
+		th_->m_memory = DEAD_MEM(void *);
+		th_->m_words = DEAD_MEM(bit_array_ty *);
+	)
+
+	free(th_);
+}
+
+
+/*******************************************************************************
+**************************** AtomicBitSetSize *********************************/
+size_t AtomicBitSetSize(const atomic_bitset_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	return th_->m_n_bits;
+}
+
+
+/*******************************************************************************
+************************* AtomicBitSetTestAndSet ******************************/
+int AtomicBitSetTestAndSet(atomic_bitset_ty *th_, size_t index_)
+{
+	bit_array_ty previous = 0;
+
+	ASSERT_IS_ALLOC(th_);
+	ASSERT_IN_RANGE(th_, index_);
+
+	previous = __atomic_fetch_or(WordIMP(th_, WORD_INDEX(index_)), BIT_MASK(index_),
+	                             __ATOMIC_ACQ_REL);
+
+	return !!(previous & BIT_MASK(index_));
+}
+
+
+/*******************************************************************************
+************************ AtomicBitSetTestAndClear *****************************/
+int AtomicBitSetTestAndClear(atomic_bitset_ty *th_, size_t index_)
+{
+	bit_array_ty previous = 0;
+
+	ASSERT_IS_ALLOC(th_);
+	ASSERT_IN_RANGE(th_, index_);
+
+	previous = __atomic_fetch_and(WordIMP(th_, WORD_INDEX(index_)), ~BIT_MASK(index_),
+	                              __ATOMIC_ACQ_REL);
+
+	return !!(previous & BIT_MASK(index_));
+}
+
+
+/*******************************************************************************
+*************************** AtomicBitSetGetVal ********************************/
+int AtomicBitSetGetVal(const atomic_bitset_ty *th_, size_t index_)
+{
+	ASSERT_IS_ALLOC(th_);
+	ASSERT_IN_RANGE(th_, index_);
+
+	return !!(__atomic_load_n(WordIMP(th_, WORD_INDEX(index_)), __ATOMIC_ACQUIRE) &
+	          BIT_MASK(index_));
+}
+
+
+/*******************************************************************************
+**************************** AtomicBitSetClaim ********************************/
+size_t AtomicBitSetClaim(atomic_bitset_ty *th_)
+{
+	return AtomicBitSetClaimFrom(th_, 0);
+}
+
+
+/*******************************************************************************
+************************** AtomicBitSetClaimFrom ******************************/
+size_t AtomicBitSetClaimFrom(atomic_bitset_ty *th_, size_t hint_)
+{
+	bit_array_ty *word = NULL;
+	bit_array_ty current = 0;
+	bit_array_ty free_bits = 0;
+	bit_array_ty bit = 0;
+	size_t word_index = 0;
+	size_t scanned = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	word_index = WORD_INDEX(hint_ % th_->m_n_bits);
+
+	for (scanned = 0; scanned < th_->m_n_words; ++scanned)
+	{
+		word = WordIMP(th_, word_index);
+		current = __atomic_load_n(word, __ATOMIC_RELAXED);
+		free_bits = ~current & ValidMaskIMP(th_, word_index);
+
+		/* Try the clear bits of the word until one is won */
+		while (0 != free_bits)
+		{
+			bit = free_bits & (~free_bits + 1);
+			current = __atomic_fetch_or(word, bit, __ATOMIC_ACQ_REL);
+
+			if (0 == (current & bit))
+			{
+				return word_index * WORD_BITS + BitArrCountTrailingZeros(bit);
+			}
+
+			free_bits = ~current & ValidMaskIMP(th_, word_index);
+		}
+
+		word_index = (word_index + 1 == th_->m_n_words) ? 0 : word_index + 1;
+	}
+
+	return th_->m_n_bits;
+}
+
+
+/*******************************************************************************
+*************************** AtomicBitSetRelease *******************************/
+void AtomicBitSetRelease(atomic_bitset_ty *th_, size_t index_)
+{
+	ASSERT_IS_ALLOC(th_);
+	ASSERT_IN_RANGE(th_, index_);
+
+	__atomic_fetch_and(WordIMP(th_, WORD_INDEX(index_)), ~BIT_MASK(index_),
+	                   __ATOMIC_RELEASE);
+}
+
+
+/*******************************************************************************
+*************************** AtomicBitSetCountOn *******************************/
+size_t AtomicBitSetCountOn(const atomic_bitset_ty *th_)
+{
+	size_t counter = 0;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	for (i = 0; i < th_->m_n_words; ++i)
+	{
+		counter += BitArrCountOn(__atomic_load_n(WordIMP(th_, i), __ATOMIC_RELAXED));
+	}
+
+	return counter;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+static bit_array_ty *WordIMP(const atomic_bitset_ty *th_, size_t word_index_)
+{
+	return th_->m_words + word_index_ * th_->m_stride;
+}
+
+/* Bits of the word that are inside the set */
+static bit_array_ty ValidMaskIMP(const atomic_bitset_ty *th_, size_t word_index_)
+{
+	size_t used_bits = th_->m_n_bits - word_index_ * WORD_BITS;
+
+	return (used_bits >= WORD_BITS) ? ALL_ON : (ALL_ON >> (WORD_BITS - used_bits));
+}
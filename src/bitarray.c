@@ -13,6 +13,12 @@
 #include "utilities.h"
 #include "bitarray.h"
 
+/* Hardware backends are compiled in for x86-64 GCC / Clang only */
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BIT_ARR_X86_BACKENDS
+#include <tmmintrin.h>		/* _mm_shuffle_epi8 (pshufb) */
+#endif
+
 #define BYTE 8
 #define BIT_ARR_SIZE 64
 #define NIBBLE_MAX_VALUE 16
@@ -24,11 +30,39 @@
 
 #define UNUSED(x) (void)(x)
 
-static void InitMirrorLUT(unsigned char *mirror_arr);
-static unsigned char MirrorOneByte(unsigned char byte);
+/* Count set bits of every byte value, expanded at compile time */
+#define COUNT_2(n)	n, n + 1, n + 1, n + 2
+#define COUNT_4(n)	COUNT_2(n), COUNT_2(n + 1), COUNT_2(n + 1), COUNT_2(n + 2)
+#define COUNT_6(n)	COUNT_4(n), COUNT_4(n + 1), COUNT_4(n + 1), COUNT_4(n + 2)
+
+/* Mirror image of every byte value, expanded at compile time */
+#define MIRROR_2(n)	n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define MIRROR_4(n)	MIRROR_2(n), MIRROR_2(n + 2 * 16), MIRROR_2(n + 1 * 16), MIRROR_2(n + 3 * 16)
+#define MIRROR_6(n)	MIRROR_4(n), MIRROR_4(n + 2 * 4), MIRROR_4(n + 1 * 4), MIRROR_4(n + 3 * 4)
+
+typedef size_t (*count_func_ty)(bit_array_ty bit_arr);
+typedef bit_array_ty (*mirror_func_ty)(bit_array_ty bit_arr);
 
-static size_t CountSetBits(unsigned char byte);
-static void InitCountLUT(size_t *count_set_LUT);
+static const unsigned char count_set_LUT[BYTE_MAX_VALUE] = 
+{
+	COUNT_6(0), COUNT_6(1), COUNT_6(1), COUNT_6(2)
+};
+
+static const unsigned char mirror_LUT[BYTE_MAX_VALUE] = 
+{
+	MIRROR_6(0), MIRROR_6(2), MIRROR_6(1), MIRROR_6(3)
+};
+
+/* Selected backends, the portable LUT versions until the CPU is probed */
+static count_func_ty count_on_backend = BitArrCountOnLUT;
+static mirror_func_ty mirror_backend = BitArrMirrorLUT;
+static const char *backend_name = "lut";
+
+#ifdef BIT_ARR_X86_BACKENDS
+static size_t CountOnPopcntIMP(bit_array_ty bit_arr);
+static bit_array_ty MirrorPshufbIMP(bit_array_ty bit_arr);
+static void SelectBackendIMP(void);
+#endif /* BIT_ARR_X86_BACKENDS */
 
 static size_t CreateMaskInIndex(size_t index);
 
@@ -150,23 +184,7 @@ bit_array_ty BitArrFlip(bit_array_ty bit_arr, size_t index)
 **************************** BitArrMirror *************************************/
 bit_array_ty BitArrMirror(bit_array_ty bit_arr)
 {
-	bit_array_ty shifts_num = BIT_ARR_SIZE - 1;
-	bit_array_ty curr_bit_value = MASK_ZERO;
-	bit_array_ty reversed_num = 0;
-	
-	while (bit_arr > 0)
-	{
-		/* Get right Most bit in bit_arr and shift it left shifts_num times */
-		curr_bit_value = (bit_arr & MASK_ONE) << shifts_num;
-		
-		/* Add the current bit to the result num */
-		reversed_num |= curr_bit_value;
-		
-		--shifts_num;
-		bit_arr >>= 1;
-	}
-	
-	return reversed_num;
+	return mirror_backend(bit_arr);
 }
 
 
@@ -174,25 +192,15 @@ bit_array_ty BitArrMirror(bit_array_ty bit_arr)
 **************************** BitArrMirror LUT *********************************/
 bit_array_ty BitArrMirrorLUT(bit_array_ty bit_arr)
 {
-	static bool_ty is_init_LUT = FALSE;
-	static unsigned char mirror_arr[BYTE_MAX_VALUE] = {0};
-	
 	bit_array_ty shift_bytes = BIT_ARR_SIZE - BYTE;
 	bit_array_ty curr_byte_mirrored = MASK_ZERO;
 	bit_array_ty result_bit_arr = 0;
 
-	/* Initialize LUT only once */
-	if (FALSE == is_init_LUT)
-	{
-		InitMirrorLUT(mirror_arr);
-		is_init_LUT = TRUE;
-	}
-	
 	/* mirror each byte in the bit_arr and assign it to result_bit_arr */
 	while (bit_arr > 0)
 	{
 		/* Assign the mirrored masked byte to the a temporary */
-		curr_byte_mirrored = (bit_array_ty)mirror_arr[(unsigned char)bit_arr];
+		curr_byte_mirrored = (bit_array_ty)mirror_LUT[(unsigned char)bit_arr];
 		
 		/* Shift the byte to the left position shift_bytes times */
 		curr_byte_mirrored <<= shift_bytes;
@@ -208,29 +216,6 @@ bit_array_ty BitArrMirrorLUT(bit_array_ty bit_arr)
 	return result_bit_arr;
 }
 
-static void InitMirrorLUT(unsigned char *mirror_arr)
-{
-	size_t index = 0;
-	
-	while (index < BYTE_MAX_VALUE)
-	{
-		*mirror_arr = MirrorOneByte((unsigned char)index);
-		
-		++mirror_arr;
-		++index;
-	}
-}
-
-/* Mirror 8 bits using Hamming Weight method */
-static unsigned char MirrorOneByte(unsigned char byte) 
-{
-    byte = (byte & 0xF0) >> 4 | (byte & 0x0F) << 4; /* 0xF0 11110000 0x0F 00001111 */
-    byte = (byte & 0xCC) >> 2 | (byte & 0x33) << 2; /* 0xCC 11001100 0x33 00110011*/
-    byte = (byte & 0xAA) >> 1 | (byte & 0x55) << 1; /* 0xAA 10101010 0x55 01010101*/
-    
-    return byte;
-}
-
 
 /*******************************************************************************
 ***************************** BitArrRotR **************************************/
@@ -256,18 +241,7 @@ bit_array_ty BitArrRotL(bit_array_ty bit_arr, size_t shifts)
 ***************************** BitArrCountOn ***********************************/
 size_t BitArrCountOn(bit_array_ty bit_arr)
 {
-	size_t counter_on = 0;
-	
-	while (bit_arr > 0)
-	{
-		if (0 != (MASK_ONE & bit_arr))
-		{
-			++counter_on;
-		}
-		bit_arr >>= 1;
-	}
-	
-	return counter_on;
+	return count_on_backend(bit_arr);
 }
 
 
@@ -283,17 +257,8 @@ size_t BitArrCountOff(bit_array_ty bit_arr)
 **************************** BitArrCountOn LUT ********************************/
 size_t BitArrCountOnLUT(bit_array_ty bit_arr)
 {
-	static bool_ty is_init_LUT = FALSE;
-	static size_t count_set_LUT[BYTE_MAX_VALUE] = {0};
 	size_t count_set_bits = 0;
 	
-	/* Initialize LUT only once */
-	if (FALSE == is_init_LUT)
-	{
-		InitCountLUT(count_set_LUT);
-		is_init_LUT = TRUE;
-	}
-	
 	/* Count each byte in the bit_arr */
 	while (bit_arr > 0)
 	{
@@ -303,40 +268,145 @@ size_t BitArrCountOnLUT(bit_array_ty bit_arr)
 		/* Shift the original bit_arr BYTE times right*/
 		bit_arr >>= BYTE;
 	}
-	/* iterate each Byte and get the count Set bits number using the LUT */
 	
 	return count_set_bits;
 }
 
-static size_t CountSetBits(unsigned char byte)
+
+/*******************************************************************************
+************************* BitArrCountTrailingZeros ****************************/
+size_t BitArrCountTrailingZeros(bit_array_ty bit_arr)
 {
 	size_t counter = 0;
-	
-	while (byte > 0)
+
+	if (0 == bit_arr)
 	{
-		if (!!(MASK_ONE & byte))
+		return BIT_ARR_SIZE;
+	}
+
+#ifdef __GNUC__
+	counter = (size_t)__builtin_ctzl(bit_arr);
+#else
+	/* Binary search the lowest set bit, halving the searched width */
+	{
+		size_t width = BIT_ARR_SIZE / 2;
+
+		for (; width > 0; width /= 2)
 		{
-			++counter;
+			if (0 == (bit_arr & (~MASK_ZERO >> (BIT_ARR_SIZE - width))))
+			{
+				counter += width;
+				bit_arr >>= width;
+			}
 		}
-		byte >>= 1;
 	}
-	
+#endif
+
 	return counter;
 }
 
-static void InitCountLUT(size_t *count_set_LUT)
+
+/*******************************************************************************
+************************** BitArrCountLeadingZeros *****************************/
+size_t BitArrCountLeadingZeros(bit_array_ty bit_arr)
 {
-	size_t index = 0;
-	
-	while (index < BYTE_MAX_VALUE)
+	size_t counter = 0;
+
+	if (0 == bit_arr)
 	{
-		*count_set_LUT = CountSetBits(index);
-		
-		++count_set_LUT;
-		++index;
+		return BIT_ARR_SIZE;
+	}
+
+#ifdef __GNUC__
+	counter = (size_t)__builtin_clzl(bit_arr);
+#else
+	/* Binary search the highest set bit, halving the searched width */
+	{
+		size_t width = BIT_ARR_SIZE / 2;
+
+		for (; width > 0; width /= 2)
+		{
+			if (0 == (bit_arr & (~MASK_ZERO << (BIT_ARR_SIZE - width))))
+			{
+				counter += width;
+				bit_arr <<= width;
+			}
+		}
+	}
+#endif
+
+	return counter;
+}
+
+
+/*******************************************************************************
+***************************** BitArrBackend ***********************************/
+const char *BitArrBackend(void)
+{
+	return backend_name;
+}
+
+
+/*******************************************************************************
+**************************** Hardware Backends ********************************/
+#ifdef BIT_ARR_X86_BACKENDS
+
+__attribute__((target("popcnt")))
+static size_t CountOnPopcntIMP(bit_array_ty bit_arr)
+{
+	return (size_t)__builtin_popcountl(bit_arr);
+}
+
+/* Mirror each nibble with pshufb, then reverse the order of the bytes */
+__attribute__((target("ssse3")))
+static bit_array_ty MirrorPshufbIMP(bit_array_ty bit_arr)
+{
+	const __m128i low_nibble_mask = _mm_set1_epi8(0x0F);
+	/* mirrored nibble placed in the high half of the byte */
+	const __m128i mirror_to_high = _mm_setr_epi8(
+		0x00, (char)0x80, 0x40, (char)0xC0, 0x20, (char)0xA0, 0x60, (char)0xE0,
+		0x10, (char)0x90, 0x50, (char)0xD0, 0x30, (char)0xB0, 0x70, (char)0xF0);
+	/* mirrored nibble placed in the low half of the byte */
+	const __m128i mirror_to_low = _mm_setr_epi8(
+		0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE,
+		0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF);
+	const __m128i reverse_bytes = _mm_setr_epi8(
+		7, 6, 5, 4, 3, 2, 1, 0,
+		(char)0x80, (char)0x80, (char)0x80, (char)0x80,
+		(char)0x80, (char)0x80, (char)0x80, (char)0x80);
+
+	__m128i value = _mm_cvtsi64_si128(bit_arr);
+	__m128i low = _mm_and_si128(value, low_nibble_mask);
+	__m128i high = _mm_and_si128(_mm_srli_epi16(value, 4), low_nibble_mask);
+
+	value = _mm_or_si128(_mm_shuffle_epi8(mirror_to_high, low), 
+	                     _mm_shuffle_epi8(mirror_to_low, high));
+
+	return (bit_array_ty)_mm_cvtsi128_si64(_mm_shuffle_epi8(value, reverse_bytes));
+}
+
+/* Runs once at load time, before main and before any thread can exist */
+__attribute__((constructor))
+static void SelectBackendIMP(void)
+{
+	__builtin_cpu_init();
+
+	if (__builtin_cpu_supports("popcnt"))
+	{
+		count_on_backend = CountOnPopcntIMP;
+		backend_name = "popcnt";
+	}
+
+	if (__builtin_cpu_supports("ssse3"))
+	{
+		mirror_backend = MirrorPshufbIMP;
+		backend_name = (count_on_backend == CountOnPopcntIMP) ? 
+		               "popcnt+pshufb" : "lut+pshufb";
 	}
 }
 
+#endif /* BIT_ARR_X86_BACKENDS */
+
 
 /*******************************************************************************
 **************************** Utilities Function *******************************/
@@ -0,0 +1,819 @@
+/*******************************************************************************
+******************************** - BIT SET - ***********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a multi-word bit array
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/bitset.c src/bitarray.c test/bitset_test.c -I ./include
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* calloc, malloc, free */
+#include <string.h>			/* memset */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "bitarray.h"		/* BitArrCountOn, BitArrMirror, BitArrCount*Zeros */
+#include "bitset.h"
+
+#define WORD_BITS				64LU
+#define WORD_SIZE				sizeof(bit_array_ty)
+#define ALL_ON					(~(bit_array_ty)0)
+
+#define WORD_INDEX(i)			((i) / WORD_BITS)
+#define BIT_OFFSET(i)			((i) % WORD_BITS)
+#define BIT_MASK(i)				((bit_array_ty)1 << BIT_OFFSET(i))
+#define WORDS_FOR_BITS(n)		(((n) + WORD_BITS - 1) / WORD_BITS)
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "BITSET is not allocated");
+
+#define ASSERT_IN_RANGE(bitset, index)							\
+		assert ((index) < (bitset)->m_n_bits && "Index is out of range");
+
+#define ASSERT_SAME_SIZE(a, b)									\
+		assert ((a)->m_n_bits == (b)->m_n_bits && "Bit sets differ in size");
+
+struct bit_set
+{
+	bit_array_ty *m_words;		/* Array of words, LSB of word 0 is bit 0 */
+	size_t m_n_bits;			/* Number of valid bits */
+	size_t m_n_words;			/* Number of words in m_words */
+};
+
+
+typedef enum range_op
+{
+	RANGE_SET,
+	RANGE_CLEAR,
+	RANGE_FLIP
+} range_op_ty;
+
+
+static bit_array_ty TailMaskIMP(const bitset_ty *bitset_);
+static void ShiftRightIMP(bit_array_ty *words_, size_t n_words_, size_t shift_);
+static void ShiftLeftIMP(bit_array_ty *words_, size_t n_words_, size_t shift_);
+static void RangeIMP(bitset_ty *bitset_, size_t from_, size_t to_, range_op_ty op_);
+static void CopyBitsIMP(bit_array_ty *dest_, size_t dest_from_, const bit_array_ty *src_,
+                        size_t src_n_words_, size_t src_from_, size_t n_bits_);
+static bit_array_ty ReadWordIMP(const bit_array_ty *words_, size_t n_words_, size_t bit_);
+static int RotateLeftIMP(bitset_ty *bitset_, size_t shifts_);
+
+
+/*******************************************************************************
+****************************** BitSetCreate ***********************************/
+bitset_ty *BitSetCreate(size_t n_bits_)
+{
+	bitset_ty *bitset = NULL;
+	size_t n_words = WORDS_FOR_BITS(n_bits_);
+
+	assert (0 != n_bits_ && "BitSetCreate: Size cannot be zero");
+
+	bitset = (bitset_ty *)malloc(sizeof(bitset_ty));
+	RETURN_IF_BAD(bitset, "BitSetCreate: Allocation Error", NULL);
+
+	bitset->m_words = (bit_array_ty *)calloc(n_words, WORD_SIZE);
+	if (NULL == bitset->m_words)
+	{
+		free(bitset);
+		return NULL;
+	}
+
+	bitset->m_n_bits = n_bits_;
+	bitset->m_n_words = n_words;
+
+	return bitset;
+}
+
+
+/*******************************************************************************
+****************************** BitSetDestroy **********************************/
+void BitSetDestroy(bitset_ty *bitset_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	free(bitset_->m_words);
+	DEBUG_MODE(
+		bitset_->m_words = DEAD_MEM(bit_array_ty *);
+	)
+
+	free(bitset_);
+}
+
+
+/*******************************************************************************
+****************************** BitSetSize *************************************/
+size_t BitSetSize(const bitset_ty *bitset_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	return bitset_->m_n_bits;
+}
+
+
+/*******************************************************************************
+*************************** BitSetWordsCount **********************************/
+size_t BitSetWordsCount(const bitset_ty *bitset_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	return bitset_->m_n_words;
+}
+
+
+/*******************************************************************************
+**************************** BitSetGetArray ***********************************/
+bit_array_ty *BitSetGetArray(const bitset_ty *bitset_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	return bitset_->m_words;
+}
+
+
+/*******************************************************************************
+***************************** BitSetSetAll ************************************/
+void BitSetSetAll(bitset_ty *bitset_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	memset(bitset_->m_words, 0xFF, bitset_->m_n_words * WORD_SIZE);
+
+	/* Keep the bits beyond the set size turned off */
+	bitset_->m_words[bitset_->m_n_words - 1] &= TailMaskIMP(bitset_);
+}
+
+
+/*******************************************************************************
+**************************** BitSetResetAll ***********************************/
+void BitSetResetAll(bitset_ty *bitset_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	memset(bitset_->m_words, 0, bitset_->m_n_words * WORD_SIZE);
+}
+
+
+/*******************************************************************************
+****************************** BitSetSetOn ************************************/
+void BitSetSetOn(bitset_ty *bitset_, size_t index_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+	ASSERT_IN_RANGE(bitset_, index_);
+
+	bitset_->m_words[WORD_INDEX(index_)] |= BIT_MASK(index_);
+}
+
+
+/*******************************************************************************
+****************************** BitSetSetOff ***********************************/
+void BitSetSetOff(bitset_ty *bitset_, size_t index_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+	ASSERT_IN_RANGE(bitset_, index_);
+
+	bitset_->m_words[WORD_INDEX(index_)] &= ~BIT_MASK(index_);
+}
+
+
+/*******************************************************************************
+****************************** BitSetSetBit ***********************************/
+void BitSetSetBit(bitset_ty *bitset_, size_t index_, int state_)
+{
+	if (0 == state_)
+	{
+		BitSetSetOff(bitset_, index_);
+	}
+	else
+	{
+		BitSetSetOn(bitset_, index_);
+	}
+}
+
+
+/*******************************************************************************
+******************************* BitSetFlip ************************************/
+void BitSetFlip(bitset_ty *bitset_, size_t index_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+	ASSERT_IN_RANGE(bitset_, index_);
+
+	bitset_->m_words[WORD_INDEX(index_)] ^= BIT_MASK(index_);
+}
+
+
+/*******************************************************************************
+****************************** BitSetGetVal ***********************************/
+int BitSetGetVal(const bitset_ty *bitset_, size_t index_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+	ASSERT_IN_RANGE(bitset_, index_);
+
+	return !!(bitset_->m_words[WORD_INDEX(index_)] & BIT_MASK(index_));
+}
+
+
+/*******************************************************************************
+**************************** Bitwise Operations *******************************/
+void BitSetAnd(bitset_ty *dest_, const bitset_ty *src_)
+{
+	bit_array_ty *dest = NULL;
+	const bit_array_ty *src = NULL;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(dest_);
+	ASSERT_IS_ALLOC(src_);
+	ASSERT_SAME_SIZE(dest_, src_);
+
+	dest = dest_->m_words;
+	src = src_->m_words;
+
+	for (i = 0; i < dest_->m_n_words; ++i)
+	{
+		dest[i] &= src[i];
+	}
+}
+
+void BitSetOr(bitset_ty *dest_, const bitset_ty *src_)
+{
+	bit_array_ty *dest = NULL;
+	const bit_array_ty *src = NULL;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(dest_);
+	ASSERT_IS_ALLOC(src_);
+	ASSERT_SAME_SIZE(dest_, src_);
+
+	dest = dest_->m_words;
+	src = src_->m_words;
+
+	for (i = 0; i < dest_->m_n_words; ++i)
+	{
+		dest[i] |= src[i];
+	}
+}
+
+void BitSetXor(bitset_ty *dest_, const bitset_ty *src_)
+{
+	bit_array_ty *dest = NULL;
+	const bit_array_ty *src = NULL;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(dest_);
+	ASSERT_IS_ALLOC(src_);
+	ASSERT_SAME_SIZE(dest_, src_);
+
+	dest = dest_->m_words;
+	src = src_->m_words;
+
+	for (i = 0; i < dest_->m_n_words; ++i)
+	{
+		dest[i] ^= src[i];
+	}
+}
+
+void BitSetAndNot(bitset_ty *dest_, const bitset_ty *src_)
+{
+	bit_array_ty *dest = NULL;
+	const bit_array_ty *src = NULL;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(dest_);
+	ASSERT_IS_ALLOC(src_);
+	ASSERT_SAME_SIZE(dest_, src_);
+
+	dest = dest_->m_words;
+	src = src_->m_words;
+
+	for (i = 0; i < dest_->m_n_words; ++i)
+	{
+		dest[i] &= ~src[i];
+	}
+}
+
+
+/*******************************************************************************
+***************************** BitSetCountOn ***********************************/
+size_t BitSetCountOn(const bitset_ty *bitset_)
+{
+	size_t counter = 0;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(bitset_);
+
+	for (i = 0; i < bitset_->m_n_words; ++i)
+	{
+		counter += BitArrCountOn(bitset_->m_words[i]);
+	}
+
+	return counter;
+}
+
+
+/*******************************************************************************
+***************************** BitSetCountOff **********************************/
+size_t BitSetCountOff(const bitset_ty *bitset_)
+{
+	return BitSetSize(bitset_) - BitSetCountOn(bitset_);
+}
+
+
+/*******************************************************************************
+****************************** BitSetMirror ***********************************/
+void BitSetMirror(bitset_ty *bitset_)
+{
+	bit_array_ty *low = NULL;
+	bit_array_ty *high = NULL;
+	bit_array_ty tmp = 0;
+	size_t padding = 0;
+
+	ASSERT_IS_ALLOC(bitset_);
+
+	low = bitset_->m_words;
+	high = bitset_->m_words + bitset_->m_n_words - 1;
+
+	/* Reverse the order of the words, and mirror each one of them */
+	while (low < high)
+	{
+		tmp = BitArrMirror(*low);
+		*low = BitArrMirror(*high);
+		*high = tmp;
+
+		++low;
+		--high;
+	}
+
+	if (low == high)
+	{
+		*low = BitArrMirror(*low);
+	}
+
+	/* The unused top bits of the last word are now at the bottom of word 0 */
+	padding = bitset_->m_n_words * WORD_BITS - bitset_->m_n_bits;
+	ShiftRightIMP(bitset_->m_words, bitset_->m_n_words, padding);
+}
+
+
+/*******************************************************************************
+***************************** BitSetSetRange **********************************/
+void BitSetSetRange(bitset_ty *bitset_, size_t from_, size_t to_)
+{
+	RangeIMP(bitset_, from_, to_, RANGE_SET);
+}
+
+
+/*******************************************************************************
+**************************** BitSetClearRange *********************************/
+void BitSetClearRange(bitset_ty *bitset_, size_t from_, size_t to_)
+{
+	RangeIMP(bitset_, from_, to_, RANGE_CLEAR);
+}
+
+
+/*******************************************************************************
+**************************** BitSetFlipRange **********************************/
+void BitSetFlipRange(bitset_ty *bitset_, size_t from_, size_t to_)
+{
+	RangeIMP(bitset_, from_, to_, RANGE_FLIP);
+}
+
+
+/*******************************************************************************
+**************************** BitSetCopyRange **********************************/
+void BitSetCopyRange(bitset_ty *dest_, size_t dest_from_,
+                     const bitset_ty *src_, size_t src_from_, size_t n_bits_)
+{
+	ASSERT_IS_ALLOC(dest_);
+	ASSERT_IS_ALLOC(src_);
+	assert (dest_from_ + n_bits_ <= dest_->m_n_bits && "BitSetCopyRange: dest out of range");
+	assert (src_from_ + n_bits_ <= src_->m_n_bits && "BitSetCopyRange: src out of range");
+
+	CopyBitsIMP(dest_->m_words, dest_from_, src_->m_words, src_->m_n_words,
+	            src_from_, n_bits_);
+}
+
+
+/*******************************************************************************
+**************************** BitSetShiftLeft **********************************/
+void BitSetShiftLeft(bitset_ty *bitset_, size_t shifts_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	ShiftLeftIMP(bitset_->m_words, bitset_->m_n_words, shifts_);
+
+	/* Keep the bits shifted beyond the set size turned off */
+	bitset_->m_words[bitset_->m_n_words - 1] &= TailMaskIMP(bitset_);
+}
+
+
+/*******************************************************************************
+**************************** BitSetShiftRight *********************************/
+void BitSetShiftRight(bitset_ty *bitset_, size_t shifts_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	ShiftRightIMP(bitset_->m_words, bitset_->m_n_words, shifts_);
+}
+
+
+/*******************************************************************************
+******************************* BitSetRotL ************************************/
+int BitSetRotL(bitset_ty *bitset_, size_t shifts_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	return RotateLeftIMP(bitset_, shifts_ % bitset_->m_n_bits);
+}
+
+
+/*******************************************************************************
+******************************* BitSetRotR ************************************/
+int BitSetRotR(bitset_ty *bitset_, size_t shifts_)
+{
+	ASSERT_IS_ALLOC(bitset_);
+
+	shifts_ %= bitset_->m_n_bits;
+
+	return RotateLeftIMP(bitset_, (0 == shifts_) ? 0 : bitset_->m_n_bits - shifts_);
+}
+
+
+/*******************************************************************************
+*************************** BitSetFindFirstSet ********************************/
+size_t BitSetFindFirstSet(const bitset_ty *bitset_)
+{
+	return BitSetFindNextSet(bitset_, 0);
+}
+
+
+/*******************************************************************************
+************************** BitSetFindFirstClear *******************************/
+size_t BitSetFindFirstClear(const bitset_ty *bitset_)
+{
+	return BitSetFindNextClear(bitset_, 0);
+}
+
+
+/*******************************************************************************
+*************************** BitSetFindLastSet *********************************/
+size_t BitSetFindLastSet(const bitset_ty *bitset_)
+{
+	size_t word_index = 0;
+
+	ASSERT_IS_ALLOC(bitset_);
+
+	for (word_index = bitset_->m_n_words; word_index > 0; --word_index)
+	{
+		if (0 != bitset_->m_words[word_index - 1])
+		{
+			return word_index * WORD_BITS - 1 - 
+			       BitArrCountLeadingZeros(bitset_->m_words[word_index - 1]);
+		}
+	}
+
+	return bitset_->m_n_bits;
+}
+
+
+/*******************************************************************************
+*************************** BitSetFindNextSet *********************************/
+size_t BitSetFindNextSet(const bitset_ty *bitset_, size_t from_)
+{
+	size_t word_index = WORD_INDEX(from_);
+	bit_array_ty word = 0;
+
+	ASSERT_IS_ALLOC(bitset_);
+
+	if (from_ >= bitset_->m_n_bits)
+	{
+		return bitset_->m_n_bits;
+	}
+
+	/* Ignore the bits below from in the first word */
+	word = bitset_->m_words[word_index] & (ALL_ON << BIT_OFFSET(from_));
+
+	while (0 == word)
+	{
+		++word_index;
+
+		if (word_index == bitset_->m_n_words)
+		{
+			return bitset_->m_n_bits;
+		}
+
+		word = bitset_->m_words[word_index];
+	}
+
+	return word_index * WORD_BITS + BitArrCountTrailingZeros(word);
+}
+
+
+/*******************************************************************************
+************************** BitSetFindNextClear ********************************/
+size_t BitSetFindNextClear(const bitset_ty *bitset_, size_t from_)
+{
+	size_t word_index = WORD_INDEX(from_);
+	size_t index = 0;
+	bit_array_ty word = 0;
+
+	ASSERT_IS_ALLOC(bitset_);
+
+	if (from_ >= bitset_->m_n_bits)
+	{
+		return bitset_->m_n_bits;
+	}
+
+	/* Search the set bits of the negated words */
+	word = ~bitset_->m_words[word_index] & (ALL_ON << BIT_OFFSET(from_));
+
+	while (0 == word)
+	{
+		++word_index;
+
+		if (word_index == bitset_->m_n_words)
+		{
+			return bitset_->m_n_bits;
+		}
+
+		word = ~bitset_->m_words[word_index];
+	}
+
+	index = word_index * WORD_BITS + BitArrCountTrailingZeros(word);
+
+	/* The unused tail bits read as clear */
+	return (index < bitset_->m_n_bits) ? index : bitset_->m_n_bits;
+}
+
+
+/*******************************************************************************
+*************************** BitSetForEachSet **********************************/
+int BitSetForEachSet(const bitset_ty *bitset_, bitset_action_ty action_, void *param_)
+{
+	bit_array_ty word = 0;
+	size_t word_index = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(bitset_);
+	ASSERT_NOT_NULL(action_, "BitSetForEachSet: Function is not valid");
+
+	for (word_index = 0; word_index < bitset_->m_n_words; ++word_index)
+	{
+		word = bitset_->m_words[word_index];
+
+		while (0 != word)
+		{
+			status = action_(word_index * WORD_BITS + BitArrCountTrailingZeros(word), 
+			                 param_);
+			if (SUCCESS != status)
+			{
+				return status;
+			}
+
+			/* Turn off the lowest set bit */
+			word &= word - 1;
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+
+/* Mask of the valid bits in the last word */
+static bit_array_ty TailMaskIMP(const bitset_ty *bitset_)
+{
+	size_t used_bits = BIT_OFFSET(bitset_->m_n_bits);
+
+	return (0 == used_bits) ? ALL_ON : (ALL_ON >> (WORD_BITS - used_bits));
+}
+
+/* Shift a words array towards bit 0, zeros are shifted in at the top */
+static void ShiftRightIMP(bit_array_ty *words_, size_t n_words_, size_t shift_)
+{
+	size_t word_shift = shift_ / WORD_BITS;
+	size_t bit_shift = BIT_OFFSET(shift_);
+	size_t src = 0;
+	size_t i = 0;
+
+	if (0 == shift_)
+	{
+		return;
+	}
+
+	for (i = 0; i < n_words_; ++i)
+	{
+		src = i + word_shift;
+
+		if (src >= n_words_ || src < i)
+		{
+			words_[i] = 0;
+			continue;
+		}
+
+		words_[i] = words_[src] >> bit_shift;
+
+		if (0 != bit_shift && src + 1 < n_words_)
+		{
+			words_[i] |= words_[src + 1] << (WORD_BITS - bit_shift);
+		}
+	}
+}
+
+/* Shift a words array towards the last word, zeros are shifted in at bit 0 */
+static void ShiftLeftIMP(bit_array_ty *words_, size_t n_words_, size_t shift_)
+{
+	size_t word_shift = shift_ / WORD_BITS;
+	size_t bit_shift = BIT_OFFSET(shift_);
+	size_t src = 0;
+	size_t i = n_words_;
+
+	if (0 == shift_)
+	{
+		return;
+	}
+
+	while (i-- > 0)
+	{
+		if (i < word_shift)
+		{
+			words_[i] = 0;
+			continue;
+		}
+
+		src = i - word_shift;
+		words_[i] = words_[src] << bit_shift;
+
+		if (0 != bit_shift && 0 < src)
+		{
+			words_[i] |= words_[src - 1] >> (WORD_BITS - bit_shift);
+		}
+	}
+}
+
+/* Masked edge words, memset / word loop over the whole words in between */
+static void RangeIMP(bitset_ty *bitset_, size_t from_, size_t to_, range_op_ty op_)
+{
+	bit_array_ty *words = NULL;
+	bit_array_ty low_mask = 0;
+	bit_array_ty high_mask = 0;
+	size_t low = 0;
+	size_t high = 0;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(bitset_);
+	assert (from_ <= to_ && to_ <= bitset_->m_n_bits && "Range is out of range");
+
+	if (from_ == to_)
+	{
+		return;
+	}
+
+	words = bitset_->m_words;
+	low = WORD_INDEX(from_);
+	high = WORD_INDEX(to_ - 1);
+	low_mask = ALL_ON << BIT_OFFSET(from_);
+	high_mask = ALL_ON >> (WORD_BITS - 1 - BIT_OFFSET(to_ - 1));
+
+	if (low == high)
+	{
+		low_mask &= high_mask;
+	}
+
+	switch (op_)
+	{
+		case RANGE_SET:
+			words[low] |= low_mask;
+			break;
+
+		case RANGE_CLEAR:
+			words[low] &= ~low_mask;
+			break;
+
+		case RANGE_FLIP:
+			words[low] ^= low_mask;
+			break;
+	}
+
+	if (low == high)
+	{
+		return;
+	}
+
+	switch (op_)
+	{
+		case RANGE_SET:
+			memset(words + low + 1, 0xFF, (high - low - 1) * WORD_SIZE);
+			words[high] |= high_mask;
+			break;
+
+		case RANGE_CLEAR:
+			memset(words + low + 1, 0, (high - low - 1) * WORD_SIZE);
+			words[high] &= ~high_mask;
+			break;
+
+		case RANGE_FLIP:
+			for (i = low + 1; i < high; ++i)
+			{
+				words[i] = ~words[i];
+			}
+			words[high] ^= high_mask;
+			break;
+	}
+}
+
+/* Writes each dest word once. When dest_ and src_ overlap, the direction
+	keeps the source bits unread by the time they are overwritten */
+static void CopyBitsIMP(bit_array_ty *dest_, size_t dest_from_, const bit_array_ty *src_,
+                        size_t src_n_words_, size_t src_from_, size_t n_bits_)
+{
+	bit_array_ty mask = 0;
+	bit_array_ty bits = 0;
+	size_t first = 0;
+	size_t last = 0;
+	size_t word = 0;
+	size_t start = 0;
+	size_t end = 0;
+	size_t i = 0;
+	int backward = (dest_ == src_ && dest_from_ > src_from_);
+
+	if (0 == n_bits_)
+	{
+		return;
+	}
+
+	first = WORD_INDEX(dest_from_);
+	last = WORD_INDEX(dest_from_ + n_bits_ - 1);
+
+	for (i = 0; i <= last - first; ++i)
+	{
+		word = backward ? last - i : first + i;
+
+		/* The part of the range inside this word */
+		start = (word * WORD_BITS > dest_from_) ? word * WORD_BITS : dest_from_;
+		end = ((word + 1) * WORD_BITS < dest_from_ + n_bits_) ?
+		      (word + 1) * WORD_BITS : dest_from_ + n_bits_;
+
+		mask = (ALL_ON << BIT_OFFSET(start)) &
+		       (ALL_ON >> (WORD_BITS - (end - word * WORD_BITS)));
+		bits = ReadWordIMP(src_, src_n_words_, start - dest_from_ + src_from_) <<
+		       BIT_OFFSET(start);
+
+		dest_[word] = (dest_[word] & ~mask) | (bits & mask);
+	}
+}
+
+/* The 64 bits starting at any bit offset, bits past the last word read 0 */
+static bit_array_ty ReadWordIMP(const bit_array_ty *words_, size_t n_words_, size_t bit_)
+{
+	size_t index = WORD_INDEX(bit_);
+	bit_array_ty word = words_[index] >> BIT_OFFSET(bit_);
+
+	if (0 != BIT_OFFSET(bit_) && index + 1 < n_words_)
+	{
+		word |= words_[index + 1] << (WORD_BITS - BIT_OFFSET(bit_));
+	}
+
+	return word;
+}
+
+/* Saves the smaller side of the rotation, shifts the other side in place
+	and puts the saved bits back at the opposite end */
+static int RotateLeftIMP(bitset_ty *bitset_, size_t shifts_)
+{
+	bit_array_ty *saved = NULL;
+	size_t n_bits = bitset_->m_n_bits;
+	size_t n_saved = 0;
+
+	if (0 == shifts_)
+	{
+		return SUCCESS;
+	}
+
+	n_saved = (shifts_ <= n_bits - shifts_) ? shifts_ : n_bits - shifts_;
+
+	saved = (bit_array_ty *)calloc(WORDS_FOR_BITS(n_saved), WORD_SIZE);
+	RETURN_IF_BAD(saved, "BitSetRotate: Allocation Error", ALLOC_ERR);
+
+	if (n_saved == shifts_)
+	{
+		/* The top bits wrap around to the bottom */
+		CopyBitsIMP(saved, 0, bitset_->m_words, bitset_->m_n_words,
+		            n_bits - n_saved, n_saved);
+		BitSetShiftLeft(bitset_, n_saved);
+		CopyBitsIMP(bitset_->m_words, 0, saved, WORDS_FOR_BITS(n_saved), 0, n_saved);
+	}
+	else
+	{
+		/* Same as rotating right, the bottom bits wrap around to the top */
+		CopyBitsIMP(saved, 0, bitset_->m_words, bitset_->m_n_words, 0, n_saved);
+		BitSetShiftRight(bitset_, n_saved);
+		CopyBitsIMP(bitset_->m_words, n_bits - n_saved, saved,
+		            WORDS_FOR_BITS(n_saved), 0, n_saved);
+	}
+
+	free(saved);
+
+	return SUCCESS;
+}
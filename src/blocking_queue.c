@@ -0,0 +1,286 @@
+/*******************************************************************************
+**************************** - BLOCKING QUEUE - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a queue_ty behind a mutex, with
+*					consumers sleeping on a condition variable
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/blocking_queue.c src/queue.c src/linked_list.c
+*					test/blocking_queue_test.c -I ./include -pthread
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* pthread_condattr_setclock, clock_gettime */
+
+#include <stdlib.h>			/* malloc, free */
+#include <assert.h>			/* assert */
+#include <errno.h>			/* ETIMEDOUT */
+#include <time.h>			/* clock_gettime */
+#include <pthread.h>		/* pthread_mutex_t, pthread_cond_t */
+
+#include "utilities.h"
+#include "queue.h"
+#include "blocking_queue.h"
+
+#define QUEUE_EMPTY				3
+
+#define MS_PER_SEC				1000L
+#define NS_PER_MS				1000000L
+#define NS_PER_SEC				1000000000L
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "BLOCKING QUEUE is not allocated");
+
+struct blocking_queue
+{
+	queue_ty *m_queue;
+	pthread_mutex_t m_lock;
+	pthread_cond_t m_not_empty;		/* Waits on CLOCK_MONOTONIC */
+	size_t m_sleepers;				/* Consumers inside pthread_cond_*wait */
+};
+
+
+static int WaitNotEmptyIMP(blocking_queue_ty *th_, long timeout_ms_);
+static void PassWakeupIMP(blocking_queue_ty *th_);
+static void DeadlineIMP(struct timespec *deadline_, long timeout_ms_);
+
+
+/*******************************************************************************
+**************************** BlockingQueueCreate ******************************/
+blocking_queue_ty *BlockingQueueCreate(size_t capacity_)
+{
+	blocking_queue_ty *queue = NULL;
+	pthread_condattr_t attr;
+
+	queue = (blocking_queue_ty *)malloc(sizeof(blocking_queue_ty));
+	RETURN_IF_BAD(queue, "BlockingQueueCreate: Allocation Error", NULL);
+
+	queue->m_queue = QueueCreateRing(capacity_);
+	queue->m_sleepers = 0;
+
+	if (NULL == queue->m_queue)
+	{
+		free(queue);
+		return NULL;
+	}
+
+	/* Timeouts must not move with the wall clock */
+	if (0 != pthread_condattr_init(&attr))
+	{
+		QueueDestroy(queue->m_queue);
+		free(queue);
+		return NULL;
+	}
+
+	if (0 != pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) ||
+	    0 != pthread_cond_init(&queue->m_not_empty, &attr))
+	{
+		pthread_condattr_destroy(&attr);
+		QueueDestroy(queue->m_queue);
+		free(queue);
+		return NULL;
+	}
+
+	pthread_condattr_destroy(&attr);
+
+	if (0 != pthread_mutex_init(&queue->m_lock, NULL))
+	{
+		pthread_cond_destroy(&queue->m_not_empty);
+		QueueDestroy(queue->m_queue);
+		free(queue);
+		return NULL;
+	}
+
+	return queue;
+}
+
+
+/*******************************************************************************
+**************************** BlockingQueueDestroy *****************************/
+void BlockingQueueDestroy(blocking_queue_ty *queue_)
+{
+	ASSERT_IS_ALLOC(queue_);
+	assert (0 == queue_->m_sleepers && "BLOCKING QUEUE destroyed while waited on");
+
+	pthread_mutex_destroy(&queue_->m_lock);
+	pthread_cond_destroy(&queue_->m_not_empty);
+	QueueDestroy(queue_->m_queue);
+	DEBUG_MODE(
+	queue_->m_queue = DEAD_MEM(queue_ty *);
+	);
+
+	free(queue_);
+}
+
+
+/*******************************************************************************
+**************************** BlockingQueueEnqueue *****************************/
+int BlockingQueueEnqueue(blocking_queue_ty *queue_, void *element_)
+{
+	int was_empty = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(queue_);
+
+	pthread_mutex_lock(&queue_->m_lock);
+
+	was_empty = QueueIsEmpty(queue_->m_queue);
+	status = QueueEnqueue(queue_->m_queue, element_);
+
+	/* A non-empty queue has no sleepers left to wake: they were woken when
+		it turned non-empty, or by the consumer ahead of them */
+	if (SUCCESS == status && was_empty && 0 < queue_->m_sleepers)
+	{
+		pthread_cond_signal(&queue_->m_not_empty);
+	}
+
+	pthread_mutex_unlock(&queue_->m_lock);
+
+	return status;
+}
+
+
+/*******************************************************************************
+************************** BlockingQueueDequeueWait ***************************/
+int BlockingQueueDequeueWait(blocking_queue_ty *queue_, void **element_, long timeout_ms_)
+{
+	ASSERT_IS_ALLOC(queue_);
+	assert (NULL != element_);
+
+	pthread_mutex_lock(&queue_->m_lock);
+
+	if (SUCCESS != WaitNotEmptyIMP(queue_, timeout_ms_))
+	{
+		pthread_mutex_unlock(&queue_->m_lock);
+		return QUEUE_EMPTY;
+	}
+
+	*element_ = QueuePeek(queue_->m_queue);
+	QueueDequeue(queue_->m_queue);
+
+	PassWakeupIMP(queue_);
+
+	pthread_mutex_unlock(&queue_->m_lock);
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+************************** BlockingQueueDequeueBatch **************************/
+size_t BlockingQueueDequeueBatch(blocking_queue_ty *queue_, void **elements_,
+                                 size_t max_, long timeout_ms_)
+{
+	size_t n = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+	assert (NULL != elements_ || 0 == max_);
+
+	if (0 == max_)
+	{
+		return 0;
+	}
+
+	pthread_mutex_lock(&queue_->m_lock);
+
+	if (SUCCESS != WaitNotEmptyIMP(queue_, timeout_ms_))
+	{
+		pthread_mutex_unlock(&queue_->m_lock);
+		return 0;
+	}
+
+	for (n = 0; n < max_ && !QueueIsEmpty(queue_->m_queue); ++n)
+	{
+		elements_[n] = QueuePeek(queue_->m_queue);
+		QueueDequeue(queue_->m_queue);
+	}
+
+	PassWakeupIMP(queue_);
+
+	pthread_mutex_unlock(&queue_->m_lock);
+
+	return n;
+}
+
+
+/*******************************************************************************
+***************************** BlockingQueueSize *******************************/
+size_t BlockingQueueSize(blocking_queue_ty *queue_)
+{
+	size_t size = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+
+	pthread_mutex_lock(&queue_->m_lock);
+	size = QueueSize(queue_->m_queue);
+	pthread_mutex_unlock(&queue_->m_lock);
+
+	return size;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+/* Called with the lock held. Sleeps until the queue is not empty or the
+	timeout passes, returns SUCCESS when there is an element to take */
+static int WaitNotEmptyIMP(blocking_queue_ty *th_, long timeout_ms_)
+{
+	struct timespec deadline;
+	int status = 0;
+
+	if (!QueueIsEmpty(th_->m_queue))
+	{
+		return SUCCESS;
+	}
+
+	if (0 == timeout_ms_)
+	{
+		return QUEUE_EMPTY;
+	}
+
+	if (BLOCKING_QUEUE_FOREVER != timeout_ms_)
+	{
+		DeadlineIMP(&deadline, timeout_ms_);
+	}
+
+	++th_->m_sleepers;
+
+	/* Loops over spurious wakeups and elements taken by other consumers */
+	while (QueueIsEmpty(th_->m_queue) && ETIMEDOUT != status)
+	{
+		status = (BLOCKING_QUEUE_FOREVER == timeout_ms_) ?
+		         pthread_cond_wait(&th_->m_not_empty, &th_->m_lock) :
+		         pthread_cond_timedwait(&th_->m_not_empty, &th_->m_lock, &deadline);
+	}
+
+	--th_->m_sleepers;
+
+	/* An element that arrived with the timeout is still taken */
+	return QueueIsEmpty(th_->m_queue) ? QUEUE_EMPTY : SUCCESS;
+}
+
+
+/* Called with the lock held, after taking elements. Producers signal only
+	on empty to non-empty, so elements left behind wake the next sleeper */
+static void PassWakeupIMP(blocking_queue_ty *th_)
+{
+	if (!QueueIsEmpty(th_->m_queue) && 0 < th_->m_sleepers)
+	{
+		pthread_cond_signal(&th_->m_not_empty);
+	}
+}
+
+
+static void DeadlineIMP(struct timespec *deadline_, long timeout_ms_)
+{
+	clock_gettime(CLOCK_MONOTONIC, deadline_);
+
+	deadline_->tv_sec += timeout_ms_ / MS_PER_SEC;
+	deadline_->tv_nsec += (timeout_ms_ % MS_PER_SEC) * NS_PER_MS;
+
+	if (NS_PER_SEC <= deadline_->tv_nsec)
+	{
+		++deadline_->tv_sec;
+		deadline_->tv_nsec -= NS_PER_SEC;
+	}
+}
@@ -0,0 +1,450 @@
+/*******************************************************************************
+****************************** - BLOOM FILTER - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of Bloom filter and counting Bloom filter
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/bloom_filter.c src/bitset.c src/bitarray.c
+*					test/bloom_filter_test.c -I ./include -lm
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, calloc, free */
+#include <string.h>			/* memset */
+#include <math.h>			/* log, ceil */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "bitset.h"
+#include "bloom_filter.h"
+
+#define WORD_BITS				64LU
+#define MAX_HASHES				32LU
+#define BATCH_ITEMS				16LU
+#define COUNTER_MAX				255
+
+#ifdef __GNUC__
+#define PREFETCH(addr, rw)		__builtin_prefetch((addr), (rw))
+#else
+#define PREFETCH(addr, rw)		((void)(addr))
+#endif
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "BLOOM FILTER is not allocated");
+
+#define ASSERT_HASHES(n_hashes)									\
+		assert (0 < (n_hashes) && (n_hashes) <= MAX_HASHES &&		\
+		        "Number of hashes is out of range");
+
+/* Hash functions and the number of positions, common to both filters */
+typedef struct bloom_hashes
+{
+	bloom_hash_ty m_hash;
+	bloom_hash_ty m_second_hash;
+	const void *m_param;
+	size_t m_n_hashes;
+	size_t m_n_positions;
+} bloom_hashes_ty;
+
+struct bloom
+{
+	bitset_ty *m_bits;
+	bloom_hashes_ty m_hashes;
+};
+
+struct counting_bloom
+{
+	unsigned char *m_counters;
+	bloom_hashes_ty m_hashes;
+};
+
+
+static void InitHashesIMP(bloom_hashes_ty *hashes_, size_t n_positions_,
+                          size_t n_hashes_, bloom_hash_ty hash_,
+                          bloom_hash_ty second_hash_, const void *param_);
+static void IndexesIMP(const bloom_hashes_ty *hashes_, const void *data_,
+                       size_t *indexes_);
+static size_t MixIMP(size_t hash_);
+
+
+/*******************************************************************************
+***************************** BloomOptimalBits ********************************/
+size_t BloomOptimalBits(size_t expected_items_, double fp_rate_)
+{
+	double ln2 = log(2.0);
+	double bits = 0;
+
+	assert (0.0 < fp_rate_ && fp_rate_ < 1.0 && "BloomOptimalBits: Bad rate");
+
+	bits = ceil(-(double)expected_items_ * log(fp_rate_) / (ln2 * ln2));
+
+	return (bits < 1.0) ? 1 : (size_t)bits;
+}
+
+
+/*******************************************************************************
+**************************** BloomOptimalHashes *******************************/
+size_t BloomOptimalHashes(size_t n_bits_, size_t expected_items_)
+{
+	size_t n_hashes = 0;
+
+	if (0 == expected_items_)
+	{
+		return 1;
+	}
+
+	n_hashes = (size_t)((double)n_bits_ / (double)expected_items_ * log(2.0) + 0.5);
+
+	if (0 == n_hashes)
+	{
+		return 1;
+	}
+
+	return (n_hashes > MAX_HASHES) ? MAX_HASHES : n_hashes;
+}
+
+
+/*******************************************************************************
+******************************** BloomCreate **********************************/
+bloom_ty *BloomCreate(size_t n_bits_, size_t n_hashes_, bloom_hash_ty HashFunc_,
+                      bloom_hash_ty SecondHashFunc_, const void *param_)
+{
+	bloom_ty *bloom = NULL;
+
+	assert (0 != n_bits_ && "BloomCreate: Size cannot be zero");
+	assert (NULL != HashFunc_ && "BloomCreate: Hash function is NULL");
+	ASSERT_HASHES(n_hashes_);
+
+	bloom = (bloom_ty *)malloc(sizeof(bloom_ty));
+	RETURN_IF_BAD(bloom, "BloomCreate: Allocation Error", NULL);
+
+	bloom->m_bits = BitSetCreate(n_bits_);
+	if (NULL == bloom->m_bits)
+	{
+		free(bloom);
+		return NULL;
+	}
+
+	InitHashesIMP(&bloom->m_hashes, n_bits_, n_hashes_, HashFunc_,
+	              SecondHashFunc_, param_);
+
+	return bloom;
+}
+
+
+/*******************************************************************************
+******************************** BloomDestroy *********************************/
+void BloomDestroy(bloom_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	BitSetDestroy(th_->m_bits);
+	DEBUG_MODE(
+		th_->m_bits = DEAD_MEM(bitset_ty *);
+	)
+
+	free(th_);
+}
+
+
+/*******************************************************************************
+******************************** BloomInsert **********************************/
+void BloomInsert(bloom_ty *th_, const void *data_)
+{
+	size_t indexes[MAX_HASHES];
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	IndexesIMP(&th_->m_hashes, data_, indexes);
+
+	for (i = 0; i < th_->m_hashes.m_n_hashes; ++i)
+	{
+		BitSetSetOn(th_->m_bits, indexes[i]);
+	}
+}
+
+
+/*******************************************************************************
+****************************** BloomMayContain ********************************/
+int BloomMayContain(const bloom_ty *th_, const void *data_)
+{
+	size_t indexes[MAX_HASHES];
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	IndexesIMP(&th_->m_hashes, data_, indexes);
+
+	for (i = 0; i < th_->m_hashes.m_n_hashes; ++i)
+	{
+		if (0 == BitSetGetVal(th_->m_bits, indexes[i]))
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+
+/*******************************************************************************
+***************************** BloomInsertBatch ********************************/
+void BloomInsertBatch(bloom_ty *th_, const void **data_, size_t n_)
+{
+	size_t indexes[BATCH_ITEMS * MAX_HASHES];
+	bit_array_ty *words = NULL;
+	size_t n_hashes = 0;
+	size_t group = 0;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+	assert (NULL != data_ || 0 == n_);
+
+	words = BitSetGetArray(th_->m_bits);
+	n_hashes = th_->m_hashes.m_n_hashes;
+
+	for (; 0 != n_; n_ -= group, data_ += group)
+	{
+		group = (n_ < BATCH_ITEMS) ? n_ : BATCH_ITEMS;
+
+		/* Compute the whole group first, so the loads are in flight together */
+		for (i = 0; i < group; ++i)
+		{
+			IndexesIMP(&th_->m_hashes, data_[i], indexes + i * n_hashes);
+		}
+
+		for (i = 0; i < group * n_hashes; ++i)
+		{
+			PREFETCH(words + indexes[i] / WORD_BITS, 1);
+		}
+
+		for (i = 0; i < group * n_hashes; ++i)
+		{
+			BitSetSetOn(th_->m_bits, indexes[i]);
+		}
+	}
+}
+
+
+/*******************************************************************************
+****************************** BloomQueryBatch ********************************/
+void BloomQueryBatch(const bloom_ty *th_, const void **data_, size_t n_, int *results_)
+{
+	size_t indexes[BATCH_ITEMS * MAX_HASHES];
+	const bit_array_ty *words = NULL;
+	size_t n_hashes = 0;
+	size_t group = 0;
+	size_t i = 0;
+	size_t j = 0;
+
+	ASSERT_IS_ALLOC(th_);
+	assert (NULL != data_ || 0 == n_);
+	assert (NULL != results_ || 0 == n_);
+
+	words = BitSetGetArray(th_->m_bits);
+	n_hashes = th_->m_hashes.m_n_hashes;
+
+	for (; 0 != n_; n_ -= group, data_ += group, results_ += group)
+	{
+		group = (n_ < BATCH_ITEMS) ? n_ : BATCH_ITEMS;
+
+		for (i = 0; i < group; ++i)
+		{
+			IndexesIMP(&th_->m_hashes, data_[i], indexes + i * n_hashes);
+		}
+
+		for (i = 0; i < group * n_hashes; ++i)
+		{
+			PREFETCH(words + indexes[i] / WORD_BITS, 0);
+		}
+
+		for (i = 0; i < group; ++i)
+		{
+			results_[i] = 1;
+
+			for (j = 0; j < n_hashes && results_[i]; ++j)
+			{
+				results_[i] = BitSetGetVal(th_->m_bits, indexes[i * n_hashes + j]);
+			}
+		}
+	}
+}
+
+
+/*******************************************************************************
+******************************** BloomClear ***********************************/
+void BloomClear(bloom_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	BitSetResetAll(th_->m_bits);
+}
+
+
+/*******************************************************************************
+**************************** CountingBloomCreate ******************************/
+counting_bloom_ty *CountingBloomCreate(size_t n_counters_, size_t n_hashes_,
+                                       bloom_hash_ty HashFunc_,
+                                       bloom_hash_ty SecondHashFunc_,
+                                       const void *param_)
+{
+	counting_bloom_ty *bloom = NULL;
+
+	assert (0 != n_counters_ && "CountingBloomCreate: Size cannot be zero");
+	assert (NULL != HashFunc_ && "CountingBloomCreate: Hash function is NULL");
+	ASSERT_HASHES(n_hashes_);
+
+	bloom = (counting_bloom_ty *)malloc(sizeof(counting_bloom_ty));
+	RETURN_IF_BAD(bloom, "CountingBloomCreate: Allocation Error", NULL);
+
+	bloom->m_counters = (unsigned char *)calloc(n_counters_, sizeof(unsigned char));
+	if (NULL == bloom->m_counters)
+	{
+		free(bloom);
+		return NULL;
+	}
+
+	InitHashesIMP(&bloom->m_hashes, n_counters_, n_hashes_, HashFunc_,
+	              SecondHashFunc_, param_);
+
+	return bloom;
+}
+
+
+/*******************************************************************************
+**************************** CountingBloomDestroy *****************************/
+void CountingBloomDestroy(counting_bloom_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	free(th_->m_counters);
+	DEBUG_MODE(
+		th_->m_counters = DEAD_MEM(unsigned char *);
+	)
+
+	free(th_);
+}
+
+
+/*******************************************************************************
+**************************** CountingBloomInsert ******************************/
+void CountingBloomInsert(counting_bloom_ty *th_, const void *data_)
+{
+	size_t indexes[MAX_HASHES];
+	unsigned char *counter = NULL;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	IndexesIMP(&th_->m_hashes, data_, indexes);
+
+	for (i = 0; i < th_->m_hashes.m_n_hashes; ++i)
+	{
+		counter = th_->m_counters + indexes[i];
+
+		if (COUNTER_MAX != *counter)
+		{
+			++*counter;
+		}
+	}
+}
+
+
+/*******************************************************************************
+**************************** CountingBloomRemove ******************************/
+void CountingBloomRemove(counting_bloom_ty *th_, const void *data_)
+{
+	size_t indexes[MAX_HASHES];
+	unsigned char *counter = NULL;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	IndexesIMP(&th_->m_hashes, data_, indexes);
+
+	for (i = 0; i < th_->m_hashes.m_n_hashes; ++i)
+	{
+		counter = th_->m_counters + indexes[i];
+
+		assert (0 != *counter && "CountingBloomRemove: Data was not inserted");
+
+		/* A saturated counter lost its true count, it stays saturated */
+		if (COUNTER_MAX != *counter && 0 != *counter)
+		{
+			--*counter;
+		}
+	}
+}
+
+
+/*******************************************************************************
+************************** CountingBloomMayContain ****************************/
+int CountingBloomMayContain(const counting_bloom_ty *th_, const void *data_)
+{
+	size_t indexes[MAX_HASHES];
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	IndexesIMP(&th_->m_hashes, data_, indexes);
+
+	for (i = 0; i < th_->m_hashes.m_n_hashes; ++i)
+	{
+		if (0 == th_->m_counters[indexes[i]])
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+static void InitHashesIMP(bloom_hashes_ty *hashes_, size_t n_positions_,
+                          size_t n_hashes_, bloom_hash_ty hash_,
+                          bloom_hash_ty second_hash_, const void *param_)
+{
+	hashes_->m_hash = hash_;
+	hashes_->m_second_hash = second_hash_;
+	hashes_->m_param = param_;
+	hashes_->m_n_hashes = n_hashes_;
+	hashes_->m_n_positions = n_positions_;
+}
+
+/* Double hashing, index_i = (h1 + i * h2) % m. h2 is forced odd so it is
+	never 0, which would collapse all indexes to h1 */
+static void IndexesIMP(const bloom_hashes_ty *hashes_, const void *data_,
+                       size_t *indexes_)
+{
+	size_t h1 = hashes_->m_hash(data_, hashes_->m_param);
+	size_t h2 = 0;
+	size_t i = 0;
+
+	h2 = (NULL != hashes_->m_second_hash) ?
+	     hashes_->m_second_hash(data_, hashes_->m_param) : MixIMP(h1);
+	h2 |= 1;
+
+	/* Mixing h1 too spreads weak hashes (e.g. identity) over the bits */
+	h1 = MixIMP(h1 ^ h2);
+
+	for (i = 0; i < hashes_->m_n_hashes; ++i)
+	{
+		indexes_[i] = h1 % hashes_->m_n_positions;
+		h1 += h2;
+	}
+}
+
+/* 64 bit finalizer of MurmurHash3 */
+static size_t MixIMP(size_t hash_)
+{
+	hash_ ^= hash_ >> 33;
+	hash_ *= 0xff51afd7ed558ccdLU;
+	hash_ ^= hash_ >> 33;
+	hash_ *= 0xc4ceb9fe1a85ec53LU;
+	hash_ ^= hash_ >> 33;
+
+	return hash_;
+}
@@ -0,0 +1,365 @@
+/*******************************************************************************
+***************************** - CONCURRENT STACK - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a lock-free Treiber stack with tagged
+*					indexes and an elimination array
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/conc_stack.c test/conc_stack_test.c
+*					-I ./include -pthread
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, calloc, free */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "conc_stack.h"
+
+#ifndef __GNUC__
+#error "conc_stack requires the GCC / Clang __atomic builtins"
+#endif
+
+#define STACK_FULL				2
+#define STACK_EMPTY				3
+
+#define CACHE_LINE				64LU
+
+/* A list word is a 32 bit tag above a 32 bit node index */
+#define INDEX_BITS				32
+#define NIL						((1LU << INDEX_BITS) - 1)
+#define INDEX_OF(word)			((word) & NIL)
+#define NEXT_WORD(word, index)	(((((word) >> INDEX_BITS) + 1) << INDEX_BITS) | (index))
+
+/* An elimination slot is empty, taken by a pop, or offers a pushed node */
+#define ELIMINATION_SLOTS		16LU
+#define ELIMINATION_SPINS		128
+#define SLOT_EMPTY				0LU
+#define SLOT_TAKEN				1LU
+#define SLOT_OFFER(index)		((index) + 2)
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "CONC STACK is not allocated");
+
+typedef enum try_result { TRY_DONE, TRY_RACE, TRY_EMPTY } try_result_ty;
+
+typedef struct node
+{
+	void *m_element;
+	size_t m_next;				/* Index, read by racing pops: atomic access */
+} node_ty;
+
+typedef struct slot
+{
+	size_t m_word;
+	char m_pad[CACHE_LINE - sizeof(size_t)];
+} slot_ty;
+
+struct conc_stack
+{
+	size_t m_head;				/* List word of the stack */
+	char m_pad1[CACHE_LINE - sizeof(size_t)];
+	size_t m_free;				/* List word of the unused nodes */
+	char m_pad2[CACHE_LINE - sizeof(size_t)];
+	size_t m_size;
+	char m_pad3[CACHE_LINE - sizeof(size_t)];
+	node_ty *m_nodes;
+	size_t m_capacity;
+	slot_ty m_slots[ELIMINATION_SLOTS];
+};
+
+
+static try_result_ty TryPushIMP(conc_stack_ty *th_, size_t *list_, size_t index_);
+static try_result_ty TryPopIMP(conc_stack_ty *th_, size_t *list_, size_t *index_);
+static int EliminatePushIMP(conc_stack_ty *th_, size_t index_, size_t attempt_);
+static int EliminatePopIMP(conc_stack_ty *th_, size_t *index_, size_t attempt_);
+static slot_ty *SlotIMP(conc_stack_ty *th_, size_t attempt_);
+
+
+/*******************************************************************************
+***************************** ConcStackCreate *********************************/
+conc_stack_ty *ConcStackCreate(size_t capacity_)
+{
+	conc_stack_ty *stack = NULL;
+	size_t i = 0;
+
+	assert (0 != capacity_ && capacity_ < NIL && "Capacity must be in 1 .. 2^32 - 2");
+
+	/* calloc leaves the counters 0 and the elimination slots empty */
+	stack = (conc_stack_ty *)calloc(1, sizeof(conc_stack_ty));
+	RETURN_IF_BAD(stack, "ConcStackCreate: Allocation Error", NULL);
+
+	stack->m_nodes = (node_ty *)malloc(capacity_ * sizeof(node_ty));
+
+	if (NULL == stack->m_nodes)
+	{
+		free(stack);
+		return NULL;
+	}
+
+	/* Every node starts on the free list, in index order */
+	for (i = 0; i < capacity_; ++i)
+	{
+		stack->m_nodes[i].m_element = NULL;
+		stack->m_nodes[i].m_next = i + 1;
+	}
+
+	stack->m_nodes[capacity_ - 1].m_next = NIL;
+	stack->m_capacity = capacity_;
+	stack->m_head = NIL;
+	stack->m_free = 0;
+
+	return stack;
+}
+
+
+/*******************************************************************************
+***************************** ConcStackDestroy ********************************/
+void ConcStackDestroy(conc_stack_ty *stack_)
+{
+	ASSERT_IS_ALLOC(stack_);
+
+	free(stack_->m_nodes);
+	DEBUG_MODE(
+	stack_->m_nodes = DEAD_MEM(node_ty *);
+	);
+
+	free(stack_);
+}
+
+
+/*******************************************************************************
+****************************** ConcStackPush **********************************/
+int ConcStackPush(conc_stack_ty *stack_, void *element_)
+{
+	size_t index = 0;
+	size_t attempt = 0;
+	try_result_ty result = TRY_RACE;
+
+	ASSERT_IS_ALLOC(stack_);
+
+	while (TRY_DONE != (result = TryPopIMP(stack_, &stack_->m_free, &index)))
+	{
+		if (TRY_EMPTY == result)
+		{
+			return STACK_FULL;
+		}
+	}
+
+	__atomic_store_n(&stack_->m_nodes[index].m_element, element_, __ATOMIC_RELAXED);
+
+	/* Counted before it is visible, so the size never goes below zero */
+	__atomic_add_fetch(&stack_->m_size, 1, __ATOMIC_RELAXED);
+
+	for (attempt = 0; TRY_DONE != TryPushIMP(stack_, &stack_->m_head, index); ++attempt)
+	{
+		if (EliminatePushIMP(stack_, index, attempt))
+		{
+			break;
+		}
+	}
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+****************************** ConcStackPop ***********************************/
+int ConcStackPop(conc_stack_ty *stack_, void **element_)
+{
+	size_t index = 0;
+	size_t attempt = 0;
+	try_result_ty result = TRY_RACE;
+
+	ASSERT_IS_ALLOC(stack_);
+	assert (NULL != element_);
+
+	for (attempt = 0; TRY_DONE != (result = TryPopIMP(stack_, &stack_->m_head, &index));
+	     ++attempt)
+	{
+		if (TRY_EMPTY == result)
+		{
+			return STACK_EMPTY;
+		}
+
+		if (EliminatePopIMP(stack_, &index, attempt))
+		{
+			break;
+		}
+	}
+
+	*element_ = __atomic_load_n(&stack_->m_nodes[index].m_element, __ATOMIC_RELAXED);
+	__atomic_sub_fetch(&stack_->m_size, 1, __ATOMIC_RELAXED);
+
+	while (TRY_DONE != TryPushIMP(stack_, &stack_->m_free, index))
+	{
+		/* empty, the free list only races with other frees and allocations */
+	}
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+****************************** ConcStackPeek **********************************/
+int ConcStackPeek(conc_stack_ty *stack_, void **element_)
+{
+	size_t index = 0;
+
+	ASSERT_IS_ALLOC(stack_);
+	assert (NULL != element_);
+
+	index = INDEX_OF(__atomic_load_n(&stack_->m_head, __ATOMIC_ACQUIRE));
+
+	if (NIL == index)
+	{
+		return STACK_EMPTY;
+	}
+
+	/* Nodes are never freed, a node popped meanwhile is still readable */
+	*element_ = __atomic_load_n(&stack_->m_nodes[index].m_element, __ATOMIC_RELAXED);
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+****************************** ConcStackSize **********************************/
+size_t ConcStackSize(const conc_stack_ty *stack_)
+{
+	ASSERT_IS_ALLOC(stack_);
+
+	return __atomic_load_n(&stack_->m_size, __ATOMIC_RELAXED);
+}
+
+
+/*******************************************************************************
+***************************** ConcStackIsEmpty ********************************/
+int ConcStackIsEmpty(const conc_stack_ty *stack_)
+{
+	ASSERT_IS_ALLOC(stack_);
+
+	return NIL == INDEX_OF(__atomic_load_n(&stack_->m_head, __ATOMIC_RELAXED));
+}
+
+
+/*******************************************************************************
+**************************** ConcStackCapacity ********************************/
+size_t ConcStackCapacity(const conc_stack_ty *stack_)
+{
+	ASSERT_IS_ALLOC(stack_);
+
+	return stack_->m_capacity;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+/* One CAS attempt to put node index_ on top of list_. The element written
+	before is released with it. */
+static try_result_ty TryPushIMP(conc_stack_ty *th_, size_t *list_, size_t index_)
+{
+	size_t word = __atomic_load_n(list_, __ATOMIC_RELAXED);
+
+	__atomic_store_n(&th_->m_nodes[index_].m_next, INDEX_OF(word), __ATOMIC_RELAXED);
+
+	return __atomic_compare_exchange_n(list_, &word, NEXT_WORD(word, index_), 0,
+	                                   __ATOMIC_RELEASE, __ATOMIC_RELAXED) ?
+	       TRY_DONE : TRY_RACE;
+}
+
+
+/* One CAS attempt to take the top node of list_. The next index may be
+	read from a node another thread has just popped and pushed again, the
+	tag changed by that thread fails the CAS. */
+static try_result_ty TryPopIMP(conc_stack_ty *th_, size_t *list_, size_t *index_)
+{
+	size_t word = __atomic_load_n(list_, __ATOMIC_ACQUIRE);
+	size_t next = 0;
+
+	if (NIL == INDEX_OF(word))
+	{
+		return TRY_EMPTY;
+	}
+
+	next = __atomic_load_n(&th_->m_nodes[INDEX_OF(word)].m_next, __ATOMIC_RELAXED);
+
+	if (!__atomic_compare_exchange_n(list_, &word, NEXT_WORD(word, next), 0,
+	                                 __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+	{
+		return TRY_RACE;
+	}
+
+	*index_ = INDEX_OF(word);
+
+	return TRY_DONE;
+}
+
+
+/* Offers node index_ in a slot for a while. Only the pushing thread empties
+	a slot, so a pop that marked it taken owns the node. Returns 1 when a
+	pop took the node. */
+static int EliminatePushIMP(conc_stack_ty *th_, size_t index_, size_t attempt_)
+{
+	slot_ty *slot = SlotIMP(th_, attempt_);
+	size_t word = SLOT_EMPTY;
+	int spins = 0;
+
+	if (!__atomic_compare_exchange_n(&slot->m_word, &word, SLOT_OFFER(index_), 0,
+	                                 __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+	{
+		return 0;
+	}
+
+	for (spins = 0; spins < ELIMINATION_SPINS &&
+	     SLOT_TAKEN != __atomic_load_n(&slot->m_word, __ATOMIC_RELAXED); ++spins)
+	{
+		/* empty */
+	}
+
+	/* Withdraws the offer, unless a pop got there first */
+	word = SLOT_OFFER(index_);
+
+	if (__atomic_compare_exchange_n(&slot->m_word, &word, SLOT_EMPTY, 0,
+	                                __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+	{
+		return 0;
+	}
+
+	__atomic_store_n(&slot->m_word, SLOT_EMPTY, __ATOMIC_RELAXED);
+
+	return 1;
+}
+
+
+/* Takes the node offered in a slot, if any. Returns 1 with index_ set. */
+static int EliminatePopIMP(conc_stack_ty *th_, size_t *index_, size_t attempt_)
+{
+	slot_ty *slot = SlotIMP(th_, attempt_);
+	size_t word = __atomic_load_n(&slot->m_word, __ATOMIC_RELAXED);
+
+	if (SLOT_TAKEN >= word ||
+	    !__atomic_compare_exchange_n(&slot->m_word, &word, SLOT_TAKEN, 0,
+	                                 __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+	{
+		return 0;
+	}
+
+	*index_ = word - SLOT_OFFER(0);
+
+	return 1;
+}
+
+
+/* Threads have their stacks far apart, the address of a local tells them
+	apart without thread-local storage. The attempt moves a thread to another
+	slot on every retry. */
+static slot_ty *SlotIMP(conc_stack_ty *th_, size_t attempt_)
+{
+	size_t local = attempt_;
+	size_t hash = ((size_t)&local >> 12) + attempt_;
+
+	hash *= 0x9E3779B97F4A7C15LU;
+
+	return &th_->m_slots[(hash >> 32) % ELIMINATION_SLOTS];
+}
@@ -0,0 +1,266 @@
+/*******************************************************************************
+**************************** - CONCURRENT VECTOR - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a lock-free append-only vector
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/conc_vector.c test/conc_vector_test.c
+*					-I ./include -pthread
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, calloc, free */
+#include <string.h>			/* memcpy */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "conc_vector.h"
+
+#ifndef __GNUC__
+#error "conc_vector requires the GCC / Clang __atomic builtins"
+#endif
+
+#define CACHE_LINE				64LU
+#define FIRST_CHUNK_LOG			6LU
+#define FIRST_CHUNK				(1LU << FIRST_CHUNK_LOG)	/* 64 elements */
+#define MAX_CHUNKS				(64 - FIRST_CHUNK_LOG)
+
+/* Chunk k holds FIRST_CHUNK << k elements, starting at index CHUNK_START(k) */
+#define CHUNK_START(k)			(FIRST_CHUNK * ((1LU << (k)) - 1))
+#define CHUNK_ELEMENTS(k)		(FIRST_CHUNK << (k))
+#define MSB_INDEX(x)			(63 - (size_t)__builtin_clzl(x))
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "CONC VECTOR is not allocated");
+
+/* A chunk is its elements followed by one ready flag per element */
+struct conc_vector
+{
+	char *m_chunks[MAX_CHUNKS];	/* Installed once with a CAS, never moved */
+	size_t m_element_size;
+	char m_pad1[CACHE_LINE];
+	size_t m_claimed;			/* Next index to hand out, fetch-add */
+	char m_pad2[CACHE_LINE - sizeof(size_t)];
+	size_t m_published;			/* All elements below it are ready */
+	char m_pad3[CACHE_LINE - sizeof(size_t)];
+};
+
+
+static char *ChunkIMP(conc_vector_ty *th_, size_t chunk_);
+static void LocateIMP(size_t index_, size_t *chunk_, size_t *offset_);
+static unsigned char *ReadyFlagIMP(const conc_vector_ty *th_, char *chunk_memory_,
+                                   size_t chunk_, size_t offset_);
+
+
+/*******************************************************************************
+***************************** ConcVectorCreate ********************************/
+conc_vector_ty *ConcVectorCreate(size_t element_size_)
+{
+	conc_vector_ty *vector = NULL;
+
+	assert (0 != element_size_ && "Element size cannot be zero");
+
+	/* calloc leaves the directory all NULL and both counters 0 */
+	vector = (conc_vector_ty *)calloc(1, sizeof(conc_vector_ty));
+	RETURN_IF_BAD(vector, "ConcVectorCreate: Allocation Error", NULL);
+
+	vector->m_element_size = element_size_;
+
+	return vector;
+}
+
+
+/*******************************************************************************
+***************************** ConcVectorDestroy *******************************/
+void ConcVectorDestroy(conc_vector_ty *vector_)
+{
+	size_t k = 0;
+
+	ASSERT_IS_ALLOC(vector_);
+
+	for (k = 0; k < MAX_CHUNKS; ++k)
+	{
+		free(vector_->m_chunks[k]);
+		DEBUG_MODE(
+		vector_->m_chunks[k] = DEAD_MEM(char *);
+		);
+	}
+
+	free(vector_);
+}
+
+
+/*******************************************************************************
+***************************** ConcVectorReserve *******************************/
+int ConcVectorReserve(conc_vector_ty *vector_, size_t capacity_)
+{
+	size_t k = 0;
+
+	ASSERT_IS_ALLOC(vector_);
+
+	for (k = 0; k < MAX_CHUNKS && CHUNK_START(k) < capacity_; ++k)
+	{
+		if (NULL == ChunkIMP(vector_, k))
+		{
+			return ALLOC_ERR;
+		}
+	}
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+**************************** ConcVectorPushBack *******************************/
+int ConcVectorPushBack(conc_vector_ty *vector_, const void *value_)
+{
+	size_t index = 0;
+	size_t chunk = 0;
+	size_t offset = 0;
+	char *memory = NULL;
+
+	ASSERT_IS_ALLOC(vector_);
+
+	index = __atomic_fetch_add(&vector_->m_claimed, 1, __ATOMIC_RELAXED);
+	LocateIMP(index, &chunk, &offset);
+
+	memory = (chunk < MAX_CHUNKS) ? ChunkIMP(vector_, chunk) : NULL;
+
+	if (NULL == memory)
+	{
+		return ALLOC_ERR;
+	}
+
+	memcpy(memory + offset * vector_->m_element_size, value_, vector_->m_element_size);
+
+	/* Releases the element to readers that see the flag */
+	__atomic_store_n(ReadyFlagIMP(vector_, memory, chunk, offset), 1, __ATOMIC_RELEASE);
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+****************************** ConcVectorSize *********************************/
+size_t ConcVectorSize(conc_vector_ty *vector_)
+{
+	size_t published = 0;
+	size_t claimed = 0;
+	size_t size = 0;
+	size_t chunk = 0;
+	size_t offset = 0;
+	char *memory = NULL;
+
+	ASSERT_IS_ALLOC(vector_);
+
+	published = __atomic_load_n(&vector_->m_published, __ATOMIC_ACQUIRE);
+	claimed = __atomic_load_n(&vector_->m_claimed, __ATOMIC_RELAXED);
+
+	/* Walks the ready flags past the published size */
+	for (size = published; size < claimed; ++size)
+	{
+		LocateIMP(size, &chunk, &offset);
+
+		if (chunk >= MAX_CHUNKS)
+		{
+			break;
+		}
+
+		memory = __atomic_load_n(&vector_->m_chunks[chunk], __ATOMIC_ACQUIRE);
+
+		if (NULL == memory ||
+		    !__atomic_load_n(ReadyFlagIMP(vector_, memory, chunk, offset),
+		                     __ATOMIC_ACQUIRE))
+		{
+			break;
+		}
+	}
+
+	/* Moves the published size forward, unless another reader went further */
+	while (published < size &&
+	       !__atomic_compare_exchange_n(&vector_->m_published, &published, size, 0,
+	                                    __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+	{
+		/* empty, published was reloaded */
+	}
+
+	return (published > size) ? published : size;
+}
+
+
+/*******************************************************************************
+****************************** ConcVectorGet **********************************/
+void ConcVectorGet(const conc_vector_ty *vector_, size_t index_, void *value_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	memcpy(value_, ConcVectorAt(vector_, index_), vector_->m_element_size);
+}
+
+
+/*******************************************************************************
+******************************* ConcVectorAt **********************************/
+const void *ConcVectorAt(const conc_vector_ty *vector_, size_t index_)
+{
+	size_t chunk = 0;
+	size_t offset = 0;
+
+	ASSERT_IS_ALLOC(vector_);
+	assert (index_ < __atomic_load_n(&vector_->m_published, __ATOMIC_RELAXED) &&
+	        "Index must be below the published size");
+
+	LocateIMP(index_, &chunk, &offset);
+
+	return vector_->m_chunks[chunk] + offset * vector_->m_element_size;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+/* Returns chunk_, allocating and installing it when it is missing.
+	Threads racing on a missing chunk each allocate one, the CAS loser
+	frees its own and takes the installed one. */
+static char *ChunkIMP(conc_vector_ty *th_, size_t chunk_)
+{
+	char *memory = __atomic_load_n(&th_->m_chunks[chunk_], __ATOMIC_ACQUIRE);
+	char *expected = NULL;
+
+	if (NULL != memory)
+	{
+		return memory;
+	}
+
+	memory = (char *)calloc(CHUNK_ELEMENTS(chunk_), th_->m_element_size + 1);
+
+	if (NULL == memory)
+	{
+		return NULL;
+	}
+
+	if (!__atomic_compare_exchange_n(&th_->m_chunks[chunk_], &expected, memory, 0,
+	                                 __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+	{
+		free(memory);
+		memory = expected;
+	}
+
+	return memory;
+}
+
+/* index + FIRST_CHUNK has its MSB at FIRST_CHUNK_LOG + k for chunk k, the
+	bits below the MSB are the offset inside the chunk */
+static void LocateIMP(size_t index_, size_t *chunk_, size_t *offset_)
+{
+	size_t biased = index_ + FIRST_CHUNK;
+	size_t msb = MSB_INDEX(biased);
+
+	*chunk_ = msb - FIRST_CHUNK_LOG;
+	*offset_ = biased - (1LU << msb);
+}
+
+static unsigned char *ReadyFlagIMP(const conc_vector_ty *th_, char *chunk_memory_,
+                                   size_t chunk_, size_t offset_)
+{
+	return (unsigned char *)chunk_memory_ +
+	       CHUNK_ELEMENTS(chunk_) * th_->m_element_size + offset_;
+}
@@ -0,0 +1,423 @@
+/*******************************************************************************
+****************************** - FILE VECTOR - *********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a persistent memory mapped file vector
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/file_vector.c test/file_vector_test.c -I ./include
+*
+*******************************************************************************/
+
+#define _GNU_SOURCE			/* mremap, ftruncate */
+
+#include <stdlib.h>			/* malloc, free */
+#include <string.h>			/* memcpy, memset, memcmp */
+#include <assert.h>			/* assert */
+#include <fcntl.h>			/* open */
+#include <unistd.h>			/* ftruncate, close */
+#include <sys/stat.h>		/* fstat */
+#include <sys/mman.h>		/* mmap, mremap, munmap, msync */
+
+#include "utilities.h"
+#include "file_vector.h"
+
+#define FILE_ERR				2
+
+#define PAGE_SIZE				4096LU
+#define PAGE_ROUND(bytes)		(((bytes) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1))
+#define HEADER_SIZE				64LU		/* elements start on a cache line */
+#define MAGIC					"DSFVEC01"
+#define MAGIC_SIZE				8
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "FILE VECTOR is not allocated");
+
+#define ASSERT_WRITABLE(vector)									\
+		assert (FILE_VECTOR_READ_WRITE == (vector)->m_mode &&		\
+		        "FILE VECTOR is read only");
+
+/* Lives at the start of the file. Sizes are in the machine's native
+	layout, a file is read back on the machine that wrote it. */
+typedef struct file_header
+{
+	char m_magic[MAGIC_SIZE];
+	size_t m_element_size;
+	size_t m_size;
+	size_t m_capacity;
+} file_header_ty;
+
+struct file_vector
+{
+	file_header_ty *m_header;	/* Start of the mapping */
+	char *m_elements;			/* HEADER_SIZE bytes into the mapping */
+	size_t m_map_size;			/* Mapped bytes, the file length */
+	int m_fd;
+	file_vector_mode_ty m_mode;
+};
+
+
+static file_vector_ty *MapIMP(int fd_, size_t file_size_, file_vector_mode_ty mode_);
+static int GrowIMP(file_vector_ty *th_, size_t new_capacity_);
+static size_t CapacityOfIMP(size_t file_size_, size_t element_size_);
+
+
+/*******************************************************************************
+***************************** FileVectorCreate ********************************/
+file_vector_ty *FileVectorCreate(const char *path_, size_t element_size_)
+{
+	file_vector_ty *vector = NULL;
+	size_t file_size = PAGE_ROUND(HEADER_SIZE + element_size_);
+	int fd = -1;
+
+	ASSERT_NOT_NULL(path_, "FileVectorCreate: Path is not valid");
+	assert (0 != element_size_ && "Element size cannot be zero");
+
+	fd = open(path_, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (-1 == fd)
+	{
+		return NULL;
+	}
+
+	if (0 != ftruncate(fd, (off_t)file_size))
+	{
+		close(fd);
+		return NULL;
+	}
+
+	vector = MapIMP(fd, file_size, FILE_VECTOR_READ_WRITE);
+
+	if (NULL == vector)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	memcpy(vector->m_header->m_magic, MAGIC, MAGIC_SIZE);
+	vector->m_header->m_element_size = element_size_;
+	vector->m_header->m_size = 0;
+	vector->m_header->m_capacity = CapacityOfIMP(file_size, element_size_);
+
+	return vector;
+}
+
+
+/*******************************************************************************
+****************************** FileVectorOpen *********************************/
+file_vector_ty *FileVectorOpen(const char *path_, file_vector_mode_ty mode_)
+{
+	file_vector_ty *vector = NULL;
+	const file_header_ty *header = NULL;
+	struct stat file_stat;
+	int fd = -1;
+
+	ASSERT_NOT_NULL(path_, "FileVectorOpen: Path is not valid");
+
+	fd = open(path_, (FILE_VECTOR_READ_ONLY == mode_) ? O_RDONLY : O_RDWR);
+	if (-1 == fd)
+	{
+		return NULL;
+	}
+
+	if (0 != fstat(fd, &file_stat) || (size_t)file_stat.st_size < HEADER_SIZE)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	vector = MapIMP(fd, (size_t)file_stat.st_size, mode_);
+
+	if (NULL == vector)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	/* Only the header page is touched, the elements stay on disk */
+	header = vector->m_header;
+
+	if (0 != memcmp(header->m_magic, MAGIC, MAGIC_SIZE) ||
+	    0 == header->m_element_size || header->m_size > header->m_capacity ||
+	    header->m_capacity > CapacityOfIMP(vector->m_map_size, header->m_element_size))
+	{
+		FileVectorDestroy(vector);
+		return NULL;
+	}
+
+	return vector;
+}
+
+
+/*******************************************************************************
+**************************** FileVectorDestroy ********************************/
+void FileVectorDestroy(file_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	munmap(vector_->m_header, vector_->m_map_size);
+	close(vector_->m_fd);
+
+	DEBUG_MODE(
+		vector_->m_header = DEAD_MEM(file_header_ty *);
+		vector_->m_elements = DEAD_MEM(char *);
+	)
+
+	free(vector_);
+}
+
+
+/*******************************************************************************
+***************************** FileVectorSync **********************************/
+int FileVectorSync(file_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	ASSERT_WRITABLE(vector_);
+
+	return (0 == msync(vector_->m_header, vector_->m_map_size, MS_SYNC)) ?
+	       SUCCESS : FILE_ERR;
+}
+
+
+/*******************************************************************************
+****************************** FileVectorSet **********************************/
+void FileVectorSet(file_vector_ty *vector_, size_t index_, const void *value_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	ASSERT_WRITABLE(vector_);
+
+	memcpy(FileVectorAt(vector_, index_), value_, vector_->m_header->m_element_size);
+}
+
+
+/*******************************************************************************
+****************************** FileVectorGet **********************************/
+void FileVectorGet(const file_vector_ty *vector_, size_t index_, void *value_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	memcpy(value_, FileVectorAt(vector_, index_), vector_->m_header->m_element_size);
+}
+
+
+/*******************************************************************************
+******************************* FileVectorAt **********************************/
+void *FileVectorAt(const file_vector_ty *vector_, size_t index_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (index_ < vector_->m_header->m_size && "Index must be in size value range");
+
+	return vector_->m_elements + index_ * vector_->m_header->m_element_size;
+}
+
+
+/*******************************************************************************
+****************************** FileVectorData *********************************/
+void *FileVectorData(const file_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	return vector_->m_elements;
+}
+
+
+/*******************************************************************************
+****************************** FileVectorSize *********************************/
+size_t FileVectorSize(const file_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	return vector_->m_header->m_size;
+}
+
+
+/*******************************************************************************
+**************************** FileVectorCapacity *******************************/
+size_t FileVectorCapacity(const file_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	return vector_->m_header->m_capacity;
+}
+
+
+/*******************************************************************************
+************************** FileVectorElementSize ******************************/
+size_t FileVectorElementSize(const file_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	return vector_->m_header->m_element_size;
+}
+
+
+/*******************************************************************************
+**************************** FileVectorReserve ********************************/
+int FileVectorReserve(file_vector_ty *vector_, size_t new_capacity_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	ASSERT_WRITABLE(vector_);
+
+	if (new_capacity_ <= vector_->m_header->m_capacity)
+	{
+		return SUCCESS;
+	}
+
+	return GrowIMP(vector_, new_capacity_);
+}
+
+
+/*******************************************************************************
+***************************** FileVectorResize ********************************/
+int FileVectorResize(file_vector_ty *vector_, size_t new_size_)
+{
+	file_header_ty *header = NULL;
+	int err = SUCCESS;
+
+	ASSERT_IS_ALLOC(vector_);
+	ASSERT_WRITABLE(vector_);
+
+	err = FileVectorReserve(vector_, new_size_);
+
+	if (SUCCESS != err)
+	{
+		return err;
+	}
+
+	header = vector_->m_header;
+
+	/* Pages past the old file length are zero already, slots left by
+		PopBack are not */
+	if (new_size_ > header->m_size)
+	{
+		memset(vector_->m_elements + header->m_size * header->m_element_size, 0,
+		       (new_size_ - header->m_size) * header->m_element_size);
+	}
+
+	header->m_size = new_size_;
+
+	return err;
+}
+
+
+/*******************************************************************************
+*************************** FileVectorPushBack ********************************/
+int FileVectorPushBack(file_vector_ty *vector_, const void *value_)
+{
+	file_header_ty *header = NULL;
+	int err = SUCCESS;
+
+	ASSERT_IS_ALLOC(vector_);
+	ASSERT_WRITABLE(vector_);
+
+	header = vector_->m_header;
+
+	if (header->m_size == header->m_capacity)
+	{
+		err = GrowIMP(vector_, 2 * header->m_capacity);
+
+		if (SUCCESS != err)
+		{
+			return err;
+		}
+
+		header = vector_->m_header;
+	}
+
+	memcpy(vector_->m_elements + header->m_size * header->m_element_size, value_,
+	       header->m_element_size);
+	++header->m_size;
+
+	return err;
+}
+
+
+/*******************************************************************************
+**************************** FileVectorPopBack ********************************/
+void FileVectorPopBack(file_vector_ty *vector_, void *value_)
+{
+	file_header_ty *header = NULL;
+
+	ASSERT_IS_ALLOC(vector_);
+	ASSERT_WRITABLE(vector_);
+
+	header = vector_->m_header;
+	assert (0 != header->m_size && "Cannot pop an empty vector");
+
+	--header->m_size;
+
+	if (NULL != value_)
+	{
+		memcpy(value_, vector_->m_elements + header->m_size * header->m_element_size,
+		       header->m_element_size);
+	}
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+static file_vector_ty *MapIMP(int fd_, size_t file_size_, file_vector_mode_ty mode_)
+{
+	file_vector_ty *vector = (file_vector_ty *)malloc(sizeof(file_vector_ty));
+	void *map = NULL;
+	int prot = (FILE_VECTOR_READ_ONLY == mode_) ? PROT_READ : PROT_READ | PROT_WRITE;
+
+	RETURN_IF_BAD(vector, "FileVectorOpen: Allocation Error", NULL);
+
+	map = mmap(NULL, file_size_, prot, MAP_SHARED, fd_, 0);
+
+	if (MAP_FAILED == map)
+	{
+		free(vector);
+		return NULL;
+	}
+
+	vector->m_header = (file_header_ty *)map;
+	vector->m_elements = (char *)map + HEADER_SIZE;
+	vector->m_map_size = file_size_;
+	vector->m_fd = fd_;
+	vector->m_mode = mode_;
+
+	return vector;
+}
+
+/* Extends the file first, then the mapping over it. mremap keeps the
+	pages in place when it can, and never copies them. */
+static int GrowIMP(file_vector_ty *th_, size_t new_capacity_)
+{
+	size_t element_size = th_->m_header->m_element_size;
+	size_t file_size = PAGE_ROUND(HEADER_SIZE + new_capacity_ * element_size);
+	void *map = NULL;
+
+	if (0 != ftruncate(th_->m_fd, (off_t)file_size))
+	{
+		return FILE_ERR;
+	}
+
+#ifdef MREMAP_MAYMOVE
+	map = mremap(th_->m_header, th_->m_map_size, file_size, MREMAP_MAYMOVE);
+#else
+	map = mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, th_->m_fd, 0);
+
+	if (MAP_FAILED != map)
+	{
+		munmap(th_->m_header, th_->m_map_size);
+	}
+#endif
+
+	/* The longer file is harmless, the header still holds the old capacity */
+	if (MAP_FAILED == map)
+	{
+		return ALLOC_ERR;
+	}
+
+	th_->m_header = (file_header_ty *)map;
+	th_->m_elements = (char *)map + HEADER_SIZE;
+	th_->m_map_size = file_size;
+	th_->m_header->m_capacity = CapacityOfIMP(file_size, element_size);
+
+	return SUCCESS;
+}
+
+static size_t CapacityOfIMP(size_t file_size_, size_t element_size_)
+{
+	return (file_size_ - HEADER_SIZE) / element_size_;
+}
@@ -0,0 +1,370 @@
+/*******************************************************************************
+****************************** - FORK JOIN - ***********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a fork-join task pool, one
+*					work-stealing deque per worker thread
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/fork_join.c src/work_deque.c
+*					test/fork_join_test.c -I ./include -pthread
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* sysconf, sched_yield */
+
+#include <stdlib.h>			/* malloc, calloc, free */
+#include <assert.h>			/* assert */
+#include <unistd.h>			/* sysconf */
+#include <sched.h>			/* sched_yield */
+#include <pthread.h>		/* pthread_create, pthread_join, pthread_mutex_t */
+
+#include "utilities.h"
+#include "work_deque.h"
+#include "fork_join.h"
+
+#ifndef __GNUC__
+#error "fork_join requires the GCC / Clang __atomic builtins"
+#endif
+
+#define DEQUE_CAPACITY			64LU
+#define SPINS_BEFORE_YIELD		64
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "FORK JOIN is not allocated");
+
+struct fork_join_worker
+{
+	fork_join_ty *m_pool;
+	work_deque_ty *m_deque;
+	size_t m_id;
+	size_t m_seed;				/* Picks the first victim to steal from */
+	pthread_t m_thread;
+};
+
+struct fork_join
+{
+	fork_join_worker_ty *m_workers;
+	size_t m_n_threads;
+	fork_join_task_ty *m_root;		/* Taken by the first worker to swap it out */
+	int m_running;					/* Set for a run, workers look for tasks */
+	int m_stop;
+	pthread_mutex_t m_lock;
+	pthread_cond_t m_wake;			/* Workers wait for a run or a stop */
+	pthread_cond_t m_finished;		/* ForkJoinRun waits for the root */
+};
+
+
+static void *WorkerIMP(void *param_);
+static void WorkWhileRunningIMP(fork_join_worker_ty *th_);
+static int FindTaskIMP(fork_join_worker_ty *th_, fork_join_task_ty **task_);
+static void RunTaskIMP(fork_join_worker_ty *th_, fork_join_task_ty *task_);
+static void WaitIMP(int *spins_);
+static void StopIMP(fork_join_ty *th_, size_t n_started_);
+
+
+/*******************************************************************************
+******************************* ForkJoinCreate ********************************/
+fork_join_ty *ForkJoinCreate(size_t n_threads_)
+{
+	fork_join_ty *pool = NULL;
+	size_t i = 0;
+
+	if (0 == n_threads_)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		n_threads_ = (0 < online) ? (size_t)online : 1;
+	}
+
+	/* calloc leaves the pool stopped and idle */
+	pool = (fork_join_ty *)calloc(1, sizeof(fork_join_ty));
+	RETURN_IF_BAD(pool, "ForkJoinCreate: Allocation Error", NULL);
+
+	pool->m_workers = (fork_join_worker_ty *)calloc(n_threads_, sizeof(fork_join_worker_ty));
+
+	if (NULL == pool->m_workers)
+	{
+		free(pool);
+		return NULL;
+	}
+
+	pool->m_n_threads = n_threads_;
+	pthread_mutex_init(&pool->m_lock, NULL);
+	pthread_cond_init(&pool->m_wake, NULL);
+	pthread_cond_init(&pool->m_finished, NULL);
+
+	/* Every deque exists before any thread may steal from it */
+	for (i = 0; i < n_threads_; ++i)
+	{
+		pool->m_workers[i].m_pool = pool;
+		pool->m_workers[i].m_id = i;
+		pool->m_workers[i].m_seed = i + 1;
+		pool->m_workers[i].m_deque = WorkDequeCreate(DEQUE_CAPACITY);
+
+		if (NULL == pool->m_workers[i].m_deque)
+		{
+			StopIMP(pool, 0);
+			return NULL;
+		}
+	}
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		if (0 != pthread_create(&pool->m_workers[i].m_thread, NULL, WorkerIMP,
+		                        &pool->m_workers[i]))
+		{
+			StopIMP(pool, i);
+			return NULL;
+		}
+	}
+
+	return pool;
+}
+
+
+/*******************************************************************************
+****************************** ForkJoinDestroy ********************************/
+void ForkJoinDestroy(fork_join_ty *pool_)
+{
+	ASSERT_IS_ALLOC(pool_);
+	assert (!pool_->m_running && "FORK JOIN destroyed during a run");
+
+	StopIMP(pool_, pool_->m_n_threads);
+}
+
+
+/*******************************************************************************
+******************************** ForkJoinRun **********************************/
+void ForkJoinRun(fork_join_ty *pool_, fork_join_func_ty func_, void *param_)
+{
+	fork_join_task_ty root;
+
+	ASSERT_IS_ALLOC(pool_);
+	assert (NULL != func_);
+
+	root.m_func = func_;
+	root.m_param = param_;
+	root.m_done = 0;
+
+	pthread_mutex_lock(&pool_->m_lock);
+
+	__atomic_store_n(&pool_->m_root, &root, __ATOMIC_RELEASE);
+	__atomic_store_n(&pool_->m_running, 1, __ATOMIC_RELEASE);
+	pthread_cond_broadcast(&pool_->m_wake);
+
+	/* The worker that runs the root clears m_running */
+	while (__atomic_load_n(&pool_->m_running, __ATOMIC_ACQUIRE))
+	{
+		pthread_cond_wait(&pool_->m_finished, &pool_->m_lock);
+	}
+
+	pthread_mutex_unlock(&pool_->m_lock);
+}
+
+
+/*******************************************************************************
+******************************** ForkJoinFork *********************************/
+void ForkJoinFork(fork_join_worker_ty *worker_, fork_join_task_ty *task_,
+                  fork_join_func_ty func_, void *param_)
+{
+	assert (NULL != worker_);
+	assert (NULL != task_);
+	assert (NULL != func_);
+
+	task_->m_func = func_;
+	task_->m_param = param_;
+	task_->m_done = 0;
+
+	if (SUCCESS != WorkDequePush(worker_->m_deque, task_))
+	{
+		RunTaskIMP(worker_, task_);
+	}
+}
+
+
+/*******************************************************************************
+******************************** ForkJoinJoin *********************************/
+void ForkJoinJoin(fork_join_worker_ty *worker_, fork_join_task_ty *task_)
+{
+	fork_join_task_ty *other = NULL;
+	int spins = 0;
+
+	assert (NULL != worker_);
+	assert (NULL != task_);
+
+	/* Unless stolen, task is at the bottom of the own deque: popped and run
+		here. Otherwise help with other tasks until the thief is done */
+	while (!__atomic_load_n(&task_->m_done, __ATOMIC_ACQUIRE))
+	{
+		if (SUCCESS == FindTaskIMP(worker_, &other))
+		{
+			RunTaskIMP(worker_, other);
+			spins = 0;
+		}
+		else
+		{
+			WaitIMP(&spins);
+		}
+	}
+}
+
+
+/*******************************************************************************
+****************************** ForkJoinThreads ********************************/
+size_t ForkJoinThreads(const fork_join_ty *pool_)
+{
+	ASSERT_IS_ALLOC(pool_);
+
+	return pool_->m_n_threads;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+static void *WorkerIMP(void *param_)
+{
+	fork_join_worker_ty *worker = (fork_join_worker_ty *)param_;
+	fork_join_ty *pool = worker->m_pool;
+
+	pthread_mutex_lock(&pool->m_lock);
+
+	while (!pool->m_stop)
+	{
+		if (!__atomic_load_n(&pool->m_running, __ATOMIC_ACQUIRE))
+		{
+			pthread_cond_wait(&pool->m_wake, &pool->m_lock);
+			continue;
+		}
+
+		pthread_mutex_unlock(&pool->m_lock);
+		WorkWhileRunningIMP(worker);
+		pthread_mutex_lock(&pool->m_lock);
+	}
+
+	pthread_mutex_unlock(&pool->m_lock);
+
+	return NULL;
+}
+
+
+/* Takes the root or other workers' tasks until the root is done */
+static void WorkWhileRunningIMP(fork_join_worker_ty *th_)
+{
+	fork_join_ty *pool = th_->m_pool;
+	fork_join_task_ty *task = NULL;
+	int spins = 0;
+
+	while (__atomic_load_n(&pool->m_running, __ATOMIC_ACQUIRE))
+	{
+		task = __atomic_exchange_n(&pool->m_root, NULL, __ATOMIC_ACQ_REL);
+
+		if (NULL != task)
+		{
+			/* Every task forked under the root was joined by now */
+			RunTaskIMP(th_, task);
+
+			pthread_mutex_lock(&pool->m_lock);
+			__atomic_store_n(&pool->m_running, 0, __ATOMIC_RELEASE);
+			pthread_cond_signal(&pool->m_finished);
+			pthread_mutex_unlock(&pool->m_lock);
+		}
+		else if (SUCCESS == FindTaskIMP(th_, &task))
+		{
+			RunTaskIMP(th_, task);
+			spins = 0;
+		}
+		else
+		{
+			WaitIMP(&spins);
+		}
+	}
+}
+
+
+/* The own deque first, newest task first. Then one steal attempt on each
+	other worker, starting from a pseudo random one */
+static int FindTaskIMP(fork_join_worker_ty *th_, fork_join_task_ty **task_)
+{
+	fork_join_ty *pool = th_->m_pool;
+	void *task = NULL;
+	size_t first = 0;
+	size_t victim = 0;
+	size_t i = 0;
+
+	if (SUCCESS == WorkDequePop(th_->m_deque, &task))
+	{
+		*task_ = (fork_join_task_ty *)task;
+		return SUCCESS;
+	}
+
+	/* xorshift */
+	th_->m_seed ^= th_->m_seed << 13;
+	th_->m_seed ^= th_->m_seed >> 7;
+	th_->m_seed ^= th_->m_seed << 17;
+	first = th_->m_seed % pool->m_n_threads;
+
+	for (i = 0; i < pool->m_n_threads; ++i)
+	{
+		victim = (first + i) % pool->m_n_threads;
+
+		if (victim != th_->m_id &&
+		    SUCCESS == WorkDequeSteal(pool->m_workers[victim].m_deque, &task))
+		{
+			*task_ = (fork_join_task_ty *)task;
+			return SUCCESS;
+		}
+	}
+
+	return FUNC_FAILED;
+}
+
+
+static void RunTaskIMP(fork_join_worker_ty *th_, fork_join_task_ty *task_)
+{
+	task_->m_func(th_, task_->m_param);
+
+	/* Releases the task's results to its joiner */
+	__atomic_store_n(&task_->m_done, 1, __ATOMIC_RELEASE);
+}
+
+
+/* Spins a while, then gives the CPU away on every call */
+static void WaitIMP(int *spins_)
+{
+	if (SPINS_BEFORE_YIELD > *spins_)
+	{
+		++*spins_;
+	}
+	else
+	{
+		sched_yield();
+	}
+}
+
+
+/* Stops and joins the first n_started_ workers, frees everything */
+static void StopIMP(fork_join_ty *th_, size_t n_started_)
+{
+	size_t i = 0;
+
+	pthread_mutex_lock(&th_->m_lock);
+	th_->m_stop = 1;
+	pthread_cond_broadcast(&th_->m_wake);
+	pthread_mutex_unlock(&th_->m_lock);
+
+	for (i = 0; i < n_started_; ++i)
+	{
+		pthread_join(th_->m_workers[i].m_thread, NULL);
+	}
+
+	for (i = 0; i < th_->m_n_threads && NULL != th_->m_workers[i].m_deque; ++i)
+	{
+		WorkDequeDestroy(th_->m_workers[i].m_deque);
+	}
+
+	pthread_cond_destroy(&th_->m_finished);
+	pthread_cond_destroy(&th_->m_wake);
+	pthread_mutex_destroy(&th_->m_lock);
+
+	free(th_->m_workers);
+	free(th_);
+}
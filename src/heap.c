@@ -16,8 +16,7 @@
 #include "vector.h"
 #include "heap.h"
 
-#define VECTOR_CAPACITY       100LU /* Size of the allocated vector container */
-#define VECTOR_SIZE           0LU 
+#define VECTOR_CAPACITY       8LU   /* Elements kept inside the vector struct */
 #define ROOT_INDEX            0LU
 #define FIRST_ELEMENT         0
 
@@ -54,7 +53,7 @@ heap_ty *HeapCreate(heap_cmp_ty heap_cmp_func_ ,const void *param_)
       heap = (heap_ty*)malloc(sizeof(heap_ty));
       RETURN_IF_BAD(heap, "HeapCreate: Allocation Error", NULL);
 
-      elements = VectorCreate(VECTOR_CAPACITY, VECTOR_SIZE);
+      elements = VectorCreateSmall(VECTOR_CAPACITY);
       if (!elements)
       {
            free(heap);
@@ -0,0 +1,300 @@
+/*******************************************************************************
+****************************** - ID ALLOCATOR - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a hierarchical bitmap ID allocator
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/id_alloc.c src/bitset.c src/bitarray.c
+*					test/id_alloc_test.c -I ./include
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, free */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "bitarray.h"		/* BitArrCountTrailingZeros */
+#include "bitset.h"
+#include "id_alloc.h"
+
+#define WORD_BITS				64LU
+#define ALL_ON					(~(bit_array_ty)0)
+#define MAX_LEVELS				11		/* 64^11 > 2^64 */
+#define NO_FREE_BIT				((size_t)-1)
+
+#define DIV_ROUND_UP(a, b)		(((a) + (b) - 1) / (b))
+#define MASK_FROM(offset)		(ALL_ON << (offset))
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "ID ALLOCATOR is not allocated");
+
+struct id_alloc
+{
+	bitset_ty *m_levels[MAX_LEVELS];	/* level 0 holds the IDs, a bit of
+										   level l + 1 is set when its word
+										   in level l is full */
+	size_t m_n_levels;
+	size_t m_capacity;
+	size_t m_used;
+};
+
+
+static void MarkRangeIMP(id_alloc_ty *th_, size_t first_, size_t end_, int state_);
+static size_t NextFreeIMP(const id_alloc_ty *th_, size_t level_, size_t from_);
+
+
+/*******************************************************************************
+******************************* IDAllocCreate *********************************/
+id_alloc_ty *IDAllocCreate(size_t capacity_)
+{
+	id_alloc_ty *id_alloc = NULL;
+	size_t level_bits = capacity_;
+	size_t padded_bits = 0;
+
+	assert (0 != capacity_ && "IDAllocCreate: Capacity cannot be zero");
+
+	id_alloc = (id_alloc_ty *)malloc(sizeof(id_alloc_ty));
+	RETURN_IF_BAD(id_alloc, "IDAllocCreate: Allocation Error", NULL);
+
+	id_alloc->m_n_levels = 0;
+	id_alloc->m_capacity = capacity_;
+	id_alloc->m_used = 0;
+
+	/* Each level is rounded up to whole words, the padding bits are
+		marked in use so they are never handed out */
+	do
+	{
+		padded_bits = DIV_ROUND_UP(level_bits, WORD_BITS) * WORD_BITS;
+
+		id_alloc->m_levels[id_alloc->m_n_levels] = BitSetCreate(padded_bits);
+		if (NULL == id_alloc->m_levels[id_alloc->m_n_levels])
+		{
+			IDAllocDestroy(id_alloc);
+			return NULL;
+		}
+
+		BitSetSetRange(id_alloc->m_levels[id_alloc->m_n_levels], level_bits, padded_bits);
+
+		++id_alloc->m_n_levels;
+		level_bits = padded_bits / WORD_BITS;
+	}
+	while (padded_bits > WORD_BITS);
+
+	return id_alloc;
+}
+
+
+/*******************************************************************************
+****************************** IDAllocDestroy *********************************/
+void IDAllocDestroy(id_alloc_ty *th_)
+{
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	for (i = 0; i < th_->m_n_levels; ++i)
+	{
+		BitSetDestroy(th_->m_levels[i]);
+		DEBUG_MODE(
+			th_->m_levels[i] = DEAD_MEM(bitset_ty *);
+		)
+	}
+
+	free(th_);
+}
+
+
+/*******************************************************************************
+******************************* IDAllocAlloc **********************************/
+size_t IDAllocAlloc(id_alloc_ty *th_)
+{
+	size_t level = 0;
+	size_t index = 0;
+	bit_array_ty word = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	level = th_->m_n_levels - 1;
+	word = BitSetGetArray(th_->m_levels[level])[0];
+
+	if (ALL_ON == word)
+	{
+		return th_->m_capacity;
+	}
+
+	/* Follow the first non full word down to level 0 */
+	index = BitArrCountTrailingZeros(~word);
+
+	while (level > 0)
+	{
+		--level;
+		word = BitSetGetArray(th_->m_levels[level])[index];
+		index = index * WORD_BITS + BitArrCountTrailingZeros(~word);
+	}
+
+	MarkRangeIMP(th_, index, index + 1, 1);
+	++th_->m_used;
+
+	return index;
+}
+
+
+/*******************************************************************************
+***************************** IDAllocAllocRange *******************************/
+size_t IDAllocAllocRange(id_alloc_ty *th_, size_t n_)
+{
+	size_t first = 0;
+	size_t end = 0;
+
+	ASSERT_IS_ALLOC(th_);
+	assert (0 != n_ && "IDAllocAllocRange: Range cannot be empty");
+
+	while (NO_FREE_BIT != (first = NextFreeIMP(th_, 0, end)))
+	{
+		/* The free run ends at the next used ID, or at the padding */
+		end = BitSetFindNextSet(th_->m_levels[0], first);
+
+		if (end - first >= n_)
+		{
+			MarkRangeIMP(th_, first, first + n_, 1);
+			th_->m_used += n_;
+
+			return first;
+		}
+	}
+
+	return th_->m_capacity;
+}
+
+
+/*******************************************************************************
+******************************* IDAllocFree ***********************************/
+void IDAllocFree(id_alloc_ty *th_, size_t id_)
+{
+	IDAllocFreeRange(th_, id_, 1);
+}
+
+
+/*******************************************************************************
+***************************** IDAllocFreeRange ********************************/
+void IDAllocFreeRange(id_alloc_ty *th_, size_t first_id_, size_t n_)
+{
+	ASSERT_IS_ALLOC(th_);
+	assert (first_id_ + n_ <= th_->m_capacity && "IDAllocFree: ID is out of range");
+	assert (n_ <= th_->m_used && "IDAllocFree: ID is not in use");
+
+	if (0 == n_)
+	{
+		return;
+	}
+
+	MarkRangeIMP(th_, first_id_, first_id_ + n_, 0);
+	th_->m_used -= n_;
+}
+
+
+/*******************************************************************************
+****************************** IDAllocIsUsed **********************************/
+int IDAllocIsUsed(const id_alloc_ty *th_, size_t id_)
+{
+	ASSERT_IS_ALLOC(th_);
+	assert (id_ < th_->m_capacity && "IDAllocIsUsed: ID is out of range");
+
+	return BitSetGetVal(th_->m_levels[0], id_);
+}
+
+
+/*******************************************************************************
+******************************* IDAllocCount **********************************/
+size_t IDAllocCount(const id_alloc_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	return th_->m_used;
+}
+
+
+/*******************************************************************************
+***************************** IDAllocCapacity *********************************/
+size_t IDAllocCapacity(const id_alloc_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	return th_->m_capacity;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+
+/* Set level 0 bits in [first_, end_) to state_, then update the summary bits
+	of every word touched, level by level */
+static void MarkRangeIMP(id_alloc_ty *th_, size_t first_, size_t end_, int state_)
+{
+	const bit_array_ty *words = NULL;
+	size_t low = first_ / WORD_BITS;
+	size_t high = (end_ - 1) / WORD_BITS;
+	size_t level = 0;
+	size_t i = 0;
+
+	assert (first_ < end_);
+
+	if (state_)
+	{
+		BitSetSetRange(th_->m_levels[0], first_, end_);
+	}
+	else
+	{
+		BitSetClearRange(th_->m_levels[0], first_, end_);
+	}
+
+	for (level = 0; level + 1 < th_->m_n_levels; ++level)
+	{
+		words = BitSetGetArray(th_->m_levels[level]);
+
+		for (i = low; i <= high; ++i)
+		{
+			BitSetSetBit(th_->m_levels[level + 1], i, (ALL_ON == words[i]));
+		}
+
+		low /= WORD_BITS;
+		high /= WORD_BITS;
+	}
+}
+
+/* Lowest clear bit at from_ or above it in a level, skipping full words
+	through the level above */
+static size_t NextFreeIMP(const id_alloc_ty *th_, size_t level_, size_t from_)
+{
+	const bit_array_ty *words = BitSetGetArray(th_->m_levels[level_]);
+	size_t word_index = from_ / WORD_BITS;
+	size_t parent = 0;
+	bit_array_ty word = 0;
+
+	if (from_ >= BitSetSize(th_->m_levels[level_]))
+	{
+		return NO_FREE_BIT;
+	}
+
+	word = ~words[word_index] & MASK_FROM(from_ % WORD_BITS);
+
+	if (0 != word)
+	{
+		return word_index * WORD_BITS + BitArrCountTrailingZeros(word);
+	}
+
+	/* The top level is a single word */
+	if (level_ + 1 == th_->m_n_levels)
+	{
+		return NO_FREE_BIT;
+	}
+
+	parent = NextFreeIMP(th_, level_ + 1, word_index + 1);
+
+	if (NO_FREE_BIT == parent)
+	{
+		return NO_FREE_BIT;
+	}
+
+	return parent * WORD_BITS + BitArrCountTrailingZeros(~words[parent]);
+}
@@ -0,0 +1,283 @@
+/*******************************************************************************
+************************** - MULTI PRODUCER QUEUE - ****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a bounded lock-free multi producer /
+*					multi consumer queue with sequence numbered slots
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/mpmc_queue.c test/mpmc_queue_test.c
+*					-I ./include -pthread
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* sched_yield */
+
+#include <stdlib.h>			/* malloc, calloc, free */
+#include <assert.h>			/* assert */
+#include <sched.h>			/* sched_yield */
+
+#include "utilities.h"
+#include "mpmc_queue.h"
+
+#ifndef __GNUC__
+#error "mpmc_queue requires the GCC / Clang __atomic builtins"
+#endif
+
+#define QUEUE_FULL				2
+#define QUEUE_EMPTY				3
+
+#define CACHE_LINE				64LU
+#define MIN_CAPACITY			2LU
+#define SPINS_BEFORE_YIELD		64
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "MPMC QUEUE is not allocated");
+
+/* The slot of position p is free for the enqueue of p when its sequence is
+	p, and holds the element for the dequeue of p when it is p + 1. The
+	dequeue sets it to p + capacity, the next enqueue to use the slot. */
+typedef struct slot
+{
+	size_t m_sequence;
+	void *m_element;
+} slot_ty;
+
+struct mpmc_queue
+{
+	slot_ty *m_slots;
+	size_t m_mask;
+	char m_pad0[CACHE_LINE - sizeof(slot_ty *) - sizeof(size_t)];
+	size_t m_enqueue_pos;
+	char m_pad1[CACHE_LINE - sizeof(size_t)];
+	size_t m_dequeue_pos;
+	char m_pad2[CACHE_LINE - sizeof(size_t)];
+};
+
+
+static void WaitIMP(int *spins_);
+
+
+/*******************************************************************************
+****************************** MpmcQueueCreate ********************************/
+mpmc_queue_ty *MpmcQueueCreate(size_t capacity_)
+{
+	mpmc_queue_ty *queue = NULL;
+	size_t slots = MIN_CAPACITY;
+	size_t i = 0;
+
+	/* calloc leaves both positions 0 */
+	queue = (mpmc_queue_ty *)calloc(1, sizeof(mpmc_queue_ty));
+	RETURN_IF_BAD(queue, "MpmcQueueCreate: Allocation Error", NULL);
+
+	while (slots < capacity_)
+	{
+		slots <<= 1;
+	}
+
+	queue->m_slots = (slot_ty *)malloc(slots * sizeof(slot_ty));
+
+	if (NULL == queue->m_slots)
+	{
+		free(queue);
+		return NULL;
+	}
+
+	for (i = 0; i < slots; ++i)
+	{
+		queue->m_slots[i].m_sequence = i;
+		queue->m_slots[i].m_element = NULL;
+	}
+
+	queue->m_mask = slots - 1;
+
+	return queue;
+}
+
+
+/*******************************************************************************
+***************************** MpmcQueueDestroy ********************************/
+void MpmcQueueDestroy(mpmc_queue_ty *queue_)
+{
+	ASSERT_IS_ALLOC(queue_);
+
+	free(queue_->m_slots);
+	DEBUG_MODE(
+	queue_->m_slots = DEAD_MEM(slot_ty *);
+	);
+
+	free(queue_);
+}
+
+
+/*******************************************************************************
+**************************** MpmcQueueTryEnqueue ******************************/
+int MpmcQueueTryEnqueue(mpmc_queue_ty *queue_, void *element_)
+{
+	slot_ty *slot = NULL;
+	size_t pos = 0;
+	size_t sequence = 0;
+	long diff = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+
+	pos = __atomic_load_n(&queue_->m_enqueue_pos, __ATOMIC_RELAXED);
+
+	while (1)
+	{
+		slot = &queue_->m_slots[pos & queue_->m_mask];
+		sequence = __atomic_load_n(&slot->m_sequence, __ATOMIC_ACQUIRE);
+		diff = (long)sequence - (long)pos;
+
+		/* Free for pos: claim it. A failed CAS reloads pos */
+		if (0 == diff)
+		{
+			if (__atomic_compare_exchange_n(&queue_->m_enqueue_pos, &pos, pos + 1, 1,
+			                                __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				break;
+			}
+		}
+		/* Still holds the element of pos - capacity */
+		else if (0 > diff)
+		{
+			return QUEUE_FULL;
+		}
+		/* Another enqueue took pos already */
+		else
+		{
+			pos = __atomic_load_n(&queue_->m_enqueue_pos, __ATOMIC_RELAXED);
+		}
+	}
+
+	slot->m_element = element_;
+
+	/* Releases the element to the dequeue of pos */
+	__atomic_store_n(&slot->m_sequence, pos + 1, __ATOMIC_RELEASE);
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+****************************** MpmcQueueEnqueue *******************************/
+void MpmcQueueEnqueue(mpmc_queue_ty *queue_, void *element_)
+{
+	int spins = 0;
+
+	while (SUCCESS != MpmcQueueTryEnqueue(queue_, element_))
+	{
+		WaitIMP(&spins);
+	}
+}
+
+
+/*******************************************************************************
+**************************** MpmcQueueTryDequeue ******************************/
+int MpmcQueueTryDequeue(mpmc_queue_ty *queue_, void **element_)
+{
+	slot_ty *slot = NULL;
+	size_t pos = 0;
+	size_t sequence = 0;
+	long diff = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+	assert (NULL != element_);
+
+	pos = __atomic_load_n(&queue_->m_dequeue_pos, __ATOMIC_RELAXED);
+
+	while (1)
+	{
+		slot = &queue_->m_slots[pos & queue_->m_mask];
+		sequence = __atomic_load_n(&slot->m_sequence, __ATOMIC_ACQUIRE);
+		diff = (long)sequence - (long)(pos + 1);
+
+		/* Holds the element of pos: claim it. A failed CAS reloads pos */
+		if (0 == diff)
+		{
+			if (__atomic_compare_exchange_n(&queue_->m_dequeue_pos, &pos, pos + 1, 1,
+			                                __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			{
+				break;
+			}
+		}
+		/* The enqueue of pos has not written it yet */
+		else if (0 > diff)
+		{
+			return QUEUE_EMPTY;
+		}
+		/* Another dequeue took pos already */
+		else
+		{
+			pos = __atomic_load_n(&queue_->m_dequeue_pos, __ATOMIC_RELAXED);
+		}
+	}
+
+	*element_ = slot->m_element;
+
+	/* Hands the slot to the enqueue of pos + capacity */
+	__atomic_store_n(&slot->m_sequence, pos + queue_->m_mask + 1, __ATOMIC_RELEASE);
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+****************************** MpmcQueueDequeue *******************************/
+void *MpmcQueueDequeue(mpmc_queue_ty *queue_)
+{
+	void *element = NULL;
+	int spins = 0;
+
+	while (SUCCESS != MpmcQueueTryDequeue(queue_, &element))
+	{
+		WaitIMP(&spins);
+	}
+
+	return element;
+}
+
+
+/*******************************************************************************
+****************************** MpmcQueueSize **********************************/
+size_t MpmcQueueSize(const mpmc_queue_ty *queue_)
+{
+	size_t dequeue_pos = 0;
+	size_t enqueue_pos = 0;
+	size_t size = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+
+	/* Dequeue first: it never passes the enqueue position read after it.
+		Dequeues between the two loads may let the difference pass capacity */
+	dequeue_pos = __atomic_load_n(&queue_->m_dequeue_pos, __ATOMIC_ACQUIRE);
+	enqueue_pos = __atomic_load_n(&queue_->m_enqueue_pos, __ATOMIC_ACQUIRE);
+	size = enqueue_pos - dequeue_pos;
+
+	return (size > queue_->m_mask + 1) ? queue_->m_mask + 1 : size;
+}
+
+
+/*******************************************************************************
+**************************** MpmcQueueCapacity ********************************/
+size_t MpmcQueueCapacity(const mpmc_queue_ty *queue_)
+{
+	ASSERT_IS_ALLOC(queue_);
+
+	return queue_->m_mask + 1;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+/* Spins a while, then gives the CPU away on every call */
+static void WaitIMP(int *spins_)
+{
+	if (SPINS_BEFORE_YIELD > *spins_)
+	{
+		++*spins_;
+	}
+	else
+	{
+		sched_yield();
+	}
+}
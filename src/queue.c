@@ -2,12 +2,14 @@
 ******************************** - QUEUE - *************************************
 ***************************** DATA STRUCTURES **********************************
 *
-*	DESCRIPTION		Implementation of Queue ADT using a linked_list
+*	DESCRIPTION		Implementation of Queue ADT using a linked_list, or a
+*					ring buffer
 *	NAME 			Liad Raz
 
 *******************************************************************************/
 
 #include <stdlib.h>			/* malloc, free*/
+#include <string.h>			/* memcpy */
 #include <assert.h>			/* assert */
 
 #include "utilities.h"		/* INVALID_PTR, SUCCESS */
@@ -19,12 +21,25 @@
 #define ASSERT_IS_ALLOC(ptr)									\
 		assert (0 != (queue_ty *)ptr && "QUEUE is not allocated");
 
+#define MIN_RING_CAPACITY	8LU
+#define IS_RING(queue)		(NULL != (queue)->ring)
+
+/* head and tail only grow, a slot is found by masking them */
+#define RING_SLOT(queue, position)	((queue)->ring[(position) & (queue)->mask])
+
+/* A ring queue has no list, a list queue has no ring */
 struct queue
 {
-    llist_ty *front;         /* LIST POINTING the FIRST NODE */
-    llist_itr_ty back;  	/* ITERATOR POINTING the LAST NODE */
+    llist_ty *front;        /* LIST POINTING the FIRST NODE */
+    void **ring;			/* Power of two slots */
+    size_t mask;			/* Slots - 1 */
+    size_t head;			/* Position of the front entity */
+    size_t tail;			/* Position the next entity goes to */
 };
 
+/* side function */
+static int GrowRing(queue_ty *queue);
+
 
 /*******************************************************************************
 ****************************** Queue Create ***********************************/
@@ -45,8 +60,45 @@ queue_ty *QueueCreate(void)
 		return NULL;
 	}
 	
-	/* Iterator back will point the last node (one before the TAIL DUMMY)*/
-	queue->back = LListEnd(queue->front);
+	queue->ring = NULL;
+	queue->mask = 0;
+	queue->head = 0;
+	queue->tail = 0;
+	
+	return queue;
+}
+
+
+/*******************************************************************************
+**************************** Queue Create Ring ********************************/
+queue_ty *QueueCreateRing(size_t capacity)
+{
+	queue_ty *queue = (queue_ty *)malloc(sizeof(queue_ty));
+	size_t slots = MIN_RING_CAPACITY;
+	
+	if (NULL == queue)
+	{
+		return NULL;
+	}
+	
+	/* Round capacity up to a power of two */
+	while (slots < capacity)
+	{
+		slots <<= 1;
+	}
+	
+	queue->ring = (void **)malloc(slots * SIZE_PTR);
+	
+	if (NULL == queue->ring)
+	{
+		free(queue);
+		return NULL;
+	}
+	
+	queue->front = NULL;
+	queue->mask = slots - 1;
+	queue->head = 0;
+	queue->tail = 0;
 	
 	return queue;
 }
@@ -58,8 +110,16 @@ void QueueDestroy(queue_ty *queue)
 {
 	ASSERT_IS_ALLOC(queue);
 	
-	LListDestroy(queue->front);
-	DEBUG_MODE(queue->front = INVALID_PTR;)
+	if (IS_RING(queue))
+	{
+		free(queue->ring);
+		DEBUG_MODE(queue->ring = INVALID_PTR;)
+	}
+	else
+	{
+		LListDestroy(queue->front);
+		DEBUG_MODE(queue->front = INVALID_PTR;)
+	}
 	
 	free(queue);
 }
@@ -69,16 +129,33 @@ void QueueDestroy(queue_ty *queue)
 ****************************** Queue Enqueue **********************************/
 int QueueEnqueue(queue_ty *queue, void *user_input)
 {
+	llist_itr_ty back = {NULL};
+	llist_itr_ty tail_dummy = {NULL};
+	
 	ASSERT_IS_ALLOC(queue);
 	
-	if (LListIsSameIter(queue->back, LListEnd(queue->front)))
+	if (IS_RING(queue))
 	{
-		return ALLOC_ERR;
+		/* A full ring doubles, keeping the entities in order */
+		if (queue->tail - queue->head > queue->mask && SUCCESS != GrowRing(queue))
+		{
+			return ALLOC_ERR;
+		}
+		
+		RING_SLOT(queue, queue->tail) = user_input;
+		++queue->tail;
+		
+		return SUCCESS;
 	}
 	
-	/* update the last node */
-	queue->back = LListNext(queue->back);
-	UNUSED(user_input);
+	/* Insert after the last node; a failed insert returns the TAIL DUMMY */
+	back = LListEnd(queue->front);
+	tail_dummy = LListNext(back);
+	
+	if (LListIsSameIter(LListInsert(back, user_input), tail_dummy))
+	{
+		return ALLOC_ERR;
+	}
 	
 	return SUCCESS;
 }
@@ -91,13 +168,13 @@ void QueueDequeue(queue_ty *queue)
 	ASSERT_IS_ALLOC(queue);
 	assert (0 == QueueIsEmpty(queue) && "Cannot Dequeue when queue is empty");
 	
-	LListRemove(LListBegin(queue->front));
-	
-	/* Checks if the queue is empty, prevents invalidate back iterator */
-	if (LListIsEmpty(queue->front))
+	if (IS_RING(queue))
 	{
-		queue->back = LListBegin(queue->front);
+		++queue->head;
+		return;
 	}
+	
+	LListRemove(LListBegin(queue->front));
 }
 
 
@@ -107,6 +184,13 @@ void *QueuePeek(const queue_ty *queue)
 {
 	ASSERT_IS_ALLOC(queue);
 	
+	if (IS_RING(queue))
+	{
+		assert (0 == QueueIsEmpty(queue) && "Cannot Peek when queue is empty");
+		
+		return RING_SLOT(queue, queue->head);
+	}
+	
 	return LListGetData(LListBegin(queue->front));
 }
 
@@ -117,6 +201,11 @@ size_t QueueSize(const queue_ty *queue)
 {
 	ASSERT_IS_ALLOC(queue);
 	
+	if (IS_RING(queue))
+	{
+		return queue->tail - queue->head;
+	}
+	
 	return LListCount(queue->front);
 }
 
@@ -125,10 +214,27 @@ size_t QueueSize(const queue_ty *queue)
 ****************************** Queue IsEmpty **********************************/
 int QueueIsEmpty(const queue_ty *queue)
 {
+	ASSERT_IS_ALLOC(queue);
+	
+	if (IS_RING(queue))
+	{
+		return queue->tail == queue->head;
+	}
+	
 	return LListIsEmpty(queue->front);
 }
 
 
+/*******************************************************************************
+**************************** Queue Capacity ***********************************/
+size_t QueueCapacity(const queue_ty *queue)
+{
+	ASSERT_IS_ALLOC(queue);
+	
+	return IS_RING(queue) ? queue->mask + 1 : 0;
+}
+
+
 /*******************************************************************************
 ****************************** Queue Append ***********************************/
 /*	TODO TODO
@@ -143,6 +249,34 @@ queue_ty *QueueAppend(queue_ty *queue_dest, queue_ty *queue_src)
 
 
 
+/*******************************************************************************
+****************************** Side Functions *********************************/
+/* Copies the entities, front first, to the start of a ring twice the size */
+static int GrowRing(queue_ty *queue)
+{
+	size_t slots = queue->mask + 1;
+	size_t first = queue->head & queue->mask;
+	void **new_ring = (void **)malloc(2 * slots * SIZE_PTR);
+	
+	if (NULL == new_ring)
+	{
+		return ALLOC_ERR;
+	}
+	
+	/* The ring is full: front .. end of the ring, then start .. front */
+	memcpy(new_ring, queue->ring + first, (slots - first) * SIZE_PTR);
+	memcpy(new_ring + slots - first, queue->ring, first * SIZE_PTR);
+	
+	free(queue->ring);
+	queue->ring = new_ring;
+	queue->mask = 2 * slots - 1;
+	queue->head = 0;
+	queue->tail = slots;
+	
+	return SUCCESS;
+}
+
+
 /*******************************************************************************
 ****************************** PsuedoCode **************************************
 ********************************************************************************
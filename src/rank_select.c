@@ -0,0 +1,386 @@
+/*******************************************************************************
+****************************** - RANK SELECT - *********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a Rank / Select directory over a bit set
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/rank_select.c src/bitset.c src/bitarray.c
+*					test/rank_select_test.c -I ./include
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, calloc, realloc, free */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "bitarray.h"		/* BitArrCountOn */
+#include "bitset.h"
+#include "rank_select.h"
+
+#define WORD_BITS				64LU
+#define BYTE_BITS				8LU
+#define BYTE_MASK				((bit_array_ty)0xFF)
+
+#define WORDS_IN_BLOCK			8LU			/* 512 bits per block */
+#define BLOCKS_IN_SUPER			128LU		/* 64K bits per super block */
+#define WORDS_IN_SUPER			(WORDS_IN_BLOCK * BLOCKS_IN_SUPER)
+#define BITS_IN_SUPER			(WORDS_IN_SUPER * WORD_BITS)
+#define SELECT_SAMPLE			4096LU		/* set bits between samples */
+
+#define DIV_ROUND_UP(a, b)		(((a) + (b) - 1) / (b))
+#define LOW_BITS_MASK(n)		(((bit_array_ty)1 << (n)) - 1)
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "RANK SELECT is not allocated");
+
+struct rank_select
+{
+	const bitset_ty *m_bitset;
+	size_t *m_supers;			/* Set bits before each super block,
+								   the extra last entry is the total */
+	unsigned short *m_blocks;	/* Set bits from the super block start */
+	size_t *m_samples;			/* Block of every SELECT_SAMPLE-th set bit */
+	size_t m_n_samples;
+	size_t m_n_blocks;
+	size_t m_n_supers;
+};
+
+
+static void BuildSupersIMP(rank_select_ty *th_, size_t first_super_, size_t dirty_end_);
+static size_t CountSuperIMP(rank_select_ty *th_, size_t super_);
+static int BuildSamplesIMP(rank_select_ty *th_);
+static size_t BlockRankIMP(const rank_select_ty *th_, size_t block_);
+static size_t SelectInWordIMP(bit_array_ty word_, size_t k_);
+
+
+/*******************************************************************************
+**************************** RankSelectCreate *********************************/
+rank_select_ty *RankSelectCreate(const bitset_ty *bitset_)
+{
+	rank_select_ty *rank_select = NULL;
+	size_t n_words = 0;
+
+	ASSERT_NOT_NULL(bitset_, "RankSelectCreate: Bit set is not allocated");
+
+	rank_select = (rank_select_ty *)malloc(sizeof(rank_select_ty));
+	RETURN_IF_BAD(rank_select, "RankSelectCreate: Allocation Error", NULL);
+
+	n_words = BitSetWordsCount(bitset_);
+
+	rank_select->m_bitset = bitset_;
+	rank_select->m_n_blocks = DIV_ROUND_UP(n_words, WORDS_IN_BLOCK);
+	rank_select->m_n_supers = DIV_ROUND_UP(rank_select->m_n_blocks, BLOCKS_IN_SUPER);
+	rank_select->m_samples = NULL;
+	rank_select->m_n_samples = 0;
+
+	rank_select->m_supers = (size_t *)calloc(rank_select->m_n_supers + 1, sizeof(size_t));
+	rank_select->m_blocks = (unsigned short *)malloc(rank_select->m_n_blocks *
+	                                                 sizeof(unsigned short));
+	if (NULL == rank_select->m_supers || NULL == rank_select->m_blocks)
+	{
+		free(rank_select->m_supers);
+		free(rank_select->m_blocks);
+		free(rank_select);
+		return NULL;
+	}
+
+	BuildSupersIMP(rank_select, 0, rank_select->m_n_supers);
+
+	if (SUCCESS != BuildSamplesIMP(rank_select))
+	{
+		RankSelectDestroy(rank_select);
+		return NULL;
+	}
+
+	return rank_select;
+}
+
+
+/*******************************************************************************
+**************************** RankSelectDestroy ********************************/
+void RankSelectDestroy(rank_select_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	free(th_->m_supers);
+	free(th_->m_blocks);
+	free(th_->m_samples);
+
+	DEBUG_MODE(
+		th_->m_supers = DEAD_MEM(size_t *);
+		th_->m_blocks = DEAD_MEM(unsigned short *);
+		th_->m_samples = DEAD_MEM(size_t *);
+		th_->m_bitset = DEAD_MEM(const bitset_ty *);
+	)
+
+	free(th_);
+}
+
+
+/*******************************************************************************
+***************************** RankSelectRank **********************************/
+size_t RankSelectRank(const rank_select_ty *th_, size_t index_)
+{
+	const bit_array_ty *words = NULL;
+	size_t word_index = index_ / WORD_BITS;
+	size_t block = word_index / WORDS_IN_BLOCK;
+	size_t rank = 0;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+	assert (index_ <= BitSetSize(th_->m_bitset) && "Index is out of range");
+
+	if (index_ == BitSetSize(th_->m_bitset))
+	{
+		return RankSelectCountOn(th_);
+	}
+
+	words = BitSetGetArray(th_->m_bitset);
+	rank = BlockRankIMP(th_, block);
+
+	/* At most 7 full words, then the part of the word before index */
+	for (i = block * WORDS_IN_BLOCK; i < word_index; ++i)
+	{
+		rank += BitArrCountOn(words[i]);
+	}
+
+	rank += BitArrCountOn(words[word_index] & LOW_BITS_MASK(index_ % WORD_BITS));
+
+	return rank;
+}
+
+
+/*******************************************************************************
+**************************** RankSelectRankOff ********************************/
+size_t RankSelectRankOff(const rank_select_ty *th_, size_t index_)
+{
+	return index_ - RankSelectRank(th_, index_);
+}
+
+
+/*******************************************************************************
+**************************** RankSelectSelect *********************************/
+size_t RankSelectSelect(const rank_select_ty *th_, size_t k_)
+{
+	const bit_array_ty *words = NULL;
+	size_t sample = 0;
+	size_t low = 0;
+	size_t high = 0;
+	size_t middle = 0;
+	size_t word_index = 0;
+	size_t words_end = 0;
+	size_t count = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	if (k_ >= RankSelectCountOn(th_))
+	{
+		return BitSetSize(th_->m_bitset);
+	}
+
+	/* The k-th set bit lies between two consecutive samples */
+	sample = k_ / SELECT_SAMPLE;
+	low = th_->m_samples[sample];
+	high = (sample + 1 < th_->m_n_samples) ? th_->m_samples[sample + 1] :
+	                                          th_->m_n_blocks - 1;
+
+	/* Last block in [low, high] that starts with at most k set bits before it */
+	while (low < high)
+	{
+		middle = low + (high - low + 1) / 2;
+
+		if (BlockRankIMP(th_, middle) <= k_)
+		{
+			low = middle;
+		}
+		else
+		{
+			high = middle - 1;
+		}
+	}
+
+	k_ -= BlockRankIMP(th_, low);
+
+	words = BitSetGetArray(th_->m_bitset);
+	word_index = low * WORDS_IN_BLOCK;
+	words_end = BitSetWordsCount(th_->m_bitset);
+
+	for (; word_index < words_end; ++word_index)
+	{
+		count = BitArrCountOn(words[word_index]);
+
+		if (k_ < count)
+		{
+			break;
+		}
+
+		k_ -= count;
+	}
+
+	assert (word_index < words_end && "RankSelectSelect: Directory is stale");
+
+	return word_index * WORD_BITS + SelectInWordIMP(words[word_index], k_);
+}
+
+
+/*******************************************************************************
+*************************** RankSelectCountOn *********************************/
+size_t RankSelectCountOn(const rank_select_ty *th_)
+{
+	ASSERT_IS_ALLOC(th_);
+
+	return th_->m_supers[th_->m_n_supers];
+}
+
+
+/*******************************************************************************
+*************************** RankSelectRefresh *********************************/
+int RankSelectRefresh(rank_select_ty *th_, size_t from_, size_t to_)
+{
+	ASSERT_IS_ALLOC(th_);
+	assert (from_ <= to_ && to_ <= BitSetSize(th_->m_bitset) && "Invalid range");
+
+	if (from_ == to_)
+	{
+		return SUCCESS;
+	}
+
+	BuildSupersIMP(th_, from_ / BITS_IN_SUPER, DIV_ROUND_UP(to_, BITS_IN_SUPER));
+
+	return BuildSamplesIMP(th_);
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+
+/* Count the super blocks in [first_super_, dirty_end_) again, shift the ones
+	after them by the change in count. m_supers[first_super_] stays valid */
+static void BuildSupersIMP(rank_select_ty *th_, size_t first_super_, size_t dirty_end_)
+{
+	size_t old_start = th_->m_supers[first_super_];
+	size_t old_next = 0;
+	size_t total = 0;
+	size_t super = 0;
+
+	for (super = first_super_; super < th_->m_n_supers; ++super)
+	{
+		old_next = th_->m_supers[super + 1];
+
+		if (super < dirty_end_)
+		{
+			total = CountSuperIMP(th_, super);
+		}
+		else if (th_->m_supers[super] == old_start)
+		{
+			/* No change in count, the rest of the directory is valid */
+			return;
+		}
+		else
+		{
+			total = old_next - old_start;
+		}
+
+		th_->m_supers[super + 1] = th_->m_supers[super] + total;
+		old_start = old_next;
+	}
+}
+
+/* Fill the relative block counts of a super block, return its count */
+static size_t CountSuperIMP(rank_select_ty *th_, size_t super_)
+{
+	const bit_array_ty *words = BitSetGetArray(th_->m_bitset);
+	size_t n_words = BitSetWordsCount(th_->m_bitset);
+	size_t word_index = super_ * WORDS_IN_SUPER;
+	size_t words_end = word_index + WORDS_IN_SUPER;
+	size_t relative = 0;
+
+	if (words_end > n_words)
+	{
+		words_end = n_words;
+	}
+
+	for (; word_index < words_end; ++word_index)
+	{
+		if (0 == word_index % WORDS_IN_BLOCK)
+		{
+			th_->m_blocks[word_index / WORDS_IN_BLOCK] = (unsigned short)relative;
+		}
+
+		relative += BitArrCountOn(words[word_index]);
+	}
+
+	return relative;
+}
+
+/* Record the block of every SELECT_SAMPLE-th set bit */
+static int BuildSamplesIMP(rank_select_ty *th_)
+{
+	size_t n_samples = DIV_ROUND_UP(RankSelectCountOn(th_), SELECT_SAMPLE);
+	size_t *samples = th_->m_samples;
+	size_t next_target = 0;
+	size_t block_end = 0;
+	size_t block = 0;
+	size_t i = 0;
+
+	if (n_samples != th_->m_n_samples || NULL == samples)
+	{
+		/* One extra entry keeps the allocation non-zero for empty sets */
+		samples = (size_t *)realloc(th_->m_samples, (n_samples + 1) * sizeof(size_t));
+		RETURN_IF_BAD(samples, "RankSelect: Allocation Error", ALLOC_ERR);
+
+		th_->m_samples = samples;
+		th_->m_n_samples = n_samples;
+	}
+
+	for (block = 0; block < th_->m_n_blocks && i < n_samples; ++block)
+	{
+		block_end = (block + 1 < th_->m_n_blocks) ? BlockRankIMP(th_, block + 1) :
+		                                            RankSelectCountOn(th_);
+
+		while (i < n_samples && next_target < block_end)
+		{
+			samples[i] = block;
+			next_target += SELECT_SAMPLE;
+			++i;
+		}
+	}
+
+	return SUCCESS;
+}
+
+/* Set bits before the block */
+static size_t BlockRankIMP(const rank_select_ty *th_, size_t block_)
+{
+	return th_->m_supers[block_ / BLOCKS_IN_SUPER] + th_->m_blocks[block_];
+}
+
+/* Position of the k-th set bit in a word, skip whole bytes first */
+static size_t SelectInWordIMP(bit_array_ty word_, size_t k_)
+{
+	size_t position = 0;
+	size_t count = BitArrCountOn(word_ & BYTE_MASK);
+
+	while (k_ >= count)
+	{
+		k_ -= count;
+		word_ >>= BYTE_BITS;
+		position += BYTE_BITS;
+		count = BitArrCountOn(word_ & BYTE_MASK);
+	}
+
+	for (;; ++position, word_ >>= 1)
+	{
+		if (word_ & 1)
+		{
+			if (0 == k_)
+			{
+				break;
+			}
+
+			--k_;
+		}
+	}
+
+	return position;
+}
@@ -0,0 +1,1365 @@
+/*******************************************************************************
+***************************** - ROARING BITMAP - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a compressed (roaring) bitmap
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/roaring.c src/bitarray.c test/roaring_test.c
+*					-I ./include
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, realloc, free */
+#include <string.h>			/* memset, memcpy, memmove */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "bitarray.h"		/* bit_array_ty, BitArrCountOn,
+							   BitArrCountTrailingZeros */
+#include "roaring.h"
+
+#define WORD_BITS				64LU
+#define ALL_ON					(~(bit_array_ty)0)
+#define CHUNK_BITS				16
+#define CHUNK_VALUES			65536LU
+#define CHUNK_WORDS				(CHUNK_VALUES / WORD_BITS)
+#define ARRAY_MAX				4096LU
+#define INIT_CAPACITY			4LU
+
+#define KEY(value)				((value) >> CHUNK_BITS)
+#define LOW(value)				((value) & (CHUNK_VALUES - 1))
+
+/* Bytes of each representation of a chunk */
+#define ARRAY_BYTES(card)		((card) * sizeof(unsigned short))
+#define BITSET_BYTES			(CHUNK_WORDS * sizeof(bit_array_ty))
+#define RUN_BYTES(runs)			((runs) * 2 * sizeof(unsigned short))
+
+#define SHORTS(c)				((unsigned short *)(c)->m_data)
+#define WORDS(c)				((bit_array_ty *)(c)->m_data)
+#define RUN_START(c, i)			(SHORTS(c)[2 * (i)])
+#define RUN_LENGTH(c, i)		(SHORTS(c)[2 * (i) + 1])
+#define RUN_END(c, i)			((size_t)RUN_START(c, i) + RUN_LENGTH(c, i))
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "ROARING BITMAP is not allocated");
+
+typedef enum container_type
+{
+	ARRAY_CONTAINER,
+	BITSET_CONTAINER,
+	RUN_CONTAINER
+} container_type_ty;
+
+typedef struct container
+{
+	size_t m_key;				/* value >> 16 of the chunk */
+	size_t m_cardinality;
+	size_t m_size;				/* array values / run pairs in use */
+	size_t m_capacity;			/* array values / run pairs allocated */
+	void *m_data;
+	container_type_ty m_type;
+} container_ty;
+
+struct roaring
+{
+	container_ty *m_containers;	/* sorted by key */
+	size_t m_size;
+	size_t m_capacity;
+};
+
+
+static container_ty *FindContainerIMP(const roaring_ty *th_, size_t key_, size_t *pos_);
+static container_ty *InsertContainerIMP(roaring_ty *th_, size_t pos_, size_t key_);
+static void EraseContainerIMP(roaring_ty *th_, size_t pos_);
+
+static int ContainerAddIMP(container_ty *c_, size_t low_);
+static int ContainerRemoveIMP(container_ty *c_, size_t low_);
+static int ContainerContainsIMP(const container_ty *c_, size_t low_);
+static int ContainerCopyIMP(container_ty *dest_, const container_ty *src_);
+static int ContainerOrIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_);
+static int ContainerAndIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_);
+static int ArrayOrIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_);
+static int ArrayFilterIMP(container_ty *dest_, const container_ty *array_,
+                          const container_ty *other_);
+static int RunOrIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_);
+static int RunAndIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_);
+static int RunShrinkIMP(container_ty *c_);
+static int BitsetShrinkIMP(container_ty *c_);
+static int ReserveIMP(container_ty *c_, size_t needed_);
+static int AllocDataIMP(container_ty *c_, container_type_ty type_, size_t capacity_);
+
+static void ToWordsIMP(const container_ty *c_, bit_array_ty *words_);
+static int FromWordsIMP(container_ty *c_, const bit_array_ty *words_,
+                        container_type_ty type_);
+static container_type_ty DenseTypeIMP(size_t cardinality_);
+static size_t CountWordsIMP(const bit_array_ty *words_);
+static size_t CountRunsIMP(const bit_array_ty *words_);
+static size_t NextInWordsIMP(const bit_array_ty *words_, size_t from_, int state_);
+static void SetRangeIMP(bit_array_ty *words_, size_t first_, size_t last_);
+static size_t LowerBoundIMP(const unsigned short *arr_, size_t n_, size_t stride_,
+                            size_t key_);
+
+
+/*******************************************************************************
+******************************* RoaringCreate *********************************/
+roaring_ty *RoaringCreate(void)
+{
+	roaring_ty *roaring = (roaring_ty *)malloc(sizeof(roaring_ty));
+	RETURN_IF_BAD(roaring, "RoaringCreate: Allocation Error", NULL);
+
+	roaring->m_containers = NULL;
+	roaring->m_size = 0;
+	roaring->m_capacity = 0;
+
+	return roaring;
+}
+
+
+/*******************************************************************************
+****************************** RoaringDestroy *********************************/
+void RoaringDestroy(roaring_ty *th_)
+{
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	for (i = 0; i < th_->m_size; ++i)
+	{
+		free(th_->m_containers[i].m_data);
+	}
+
+	free(th_->m_containers);
+	DEBUG_MODE(
+		th_->m_containers = DEAD_MEM(container_ty *);
+	)
+
+	free(th_);
+}
+
+
+/*******************************************************************************
+******************************** RoaringAdd ***********************************/
+int RoaringAdd(roaring_ty *th_, size_t value_)
+{
+	container_ty *container = NULL;
+	size_t pos = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(th_);
+
+	container = FindContainerIMP(th_, KEY(value_), &pos);
+
+	if (NULL == container)
+	{
+		container = InsertContainerIMP(th_, pos, KEY(value_));
+		RETURN_IF_BAD(container, "RoaringAdd: Allocation Error", ALLOC_ERR);
+	}
+
+	status = ContainerAddIMP(container, LOW(value_));
+
+	if (0 == container->m_cardinality)
+	{
+		EraseContainerIMP(th_, pos);
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+****************************** RoaringRemove **********************************/
+int RoaringRemove(roaring_ty *th_, size_t value_)
+{
+	container_ty *container = NULL;
+	size_t pos = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(th_);
+
+	container = FindContainerIMP(th_, KEY(value_), &pos);
+
+	if (NULL == container)
+	{
+		return SUCCESS;
+	}
+
+	status = ContainerRemoveIMP(container, LOW(value_));
+
+	if (0 == container->m_cardinality)
+	{
+		EraseContainerIMP(th_, pos);
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+***************************** RoaringContains *********************************/
+int RoaringContains(const roaring_ty *th_, size_t value_)
+{
+	const container_ty *container = NULL;
+	size_t pos = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	container = FindContainerIMP(th_, KEY(value_), &pos);
+
+	return (NULL != container) && ContainerContainsIMP(container, LOW(value_));
+}
+
+
+/*******************************************************************************
+**************************** RoaringCardinality *******************************/
+size_t RoaringCardinality(const roaring_ty *th_)
+{
+	size_t counter = 0;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	for (i = 0; i < th_->m_size; ++i)
+	{
+		counter += th_->m_containers[i].m_cardinality;
+	}
+
+	return counter;
+}
+
+
+/*******************************************************************************
+********************************* RoaringOr ***********************************/
+roaring_ty *RoaringOr(const roaring_ty *roaring1_, const roaring_ty *roaring2_)
+{
+	roaring_ty *result = NULL;
+	const container_ty *c1 = NULL;
+	const container_ty *c2 = NULL;
+	container_ty *dest = NULL;
+	size_t i = 0;
+	size_t j = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(roaring1_);
+	ASSERT_IS_ALLOC(roaring2_);
+
+	result = RoaringCreate();
+	RETURN_IF_BAD(result, "RoaringOr: Allocation Error", NULL);
+
+	while (SUCCESS == status && (i < roaring1_->m_size || j < roaring2_->m_size))
+	{
+		c1 = (i < roaring1_->m_size) ? roaring1_->m_containers + i : NULL;
+		c2 = (j < roaring2_->m_size) ? roaring2_->m_containers + j : NULL;
+
+		/* A missing container sorts last */
+		if (NULL == c2 || (NULL != c1 && c1->m_key < c2->m_key))
+		{
+			c2 = NULL;
+			++i;
+		}
+		else if (NULL == c1 || c2->m_key < c1->m_key)
+		{
+			c1 = c2;
+			c2 = NULL;
+			++j;
+		}
+		else
+		{
+			++i;
+			++j;
+		}
+
+		dest = InsertContainerIMP(result, result->m_size, c1->m_key);
+		if (NULL == dest)
+		{
+			status = ALLOC_ERR;
+			break;
+		}
+
+		status = (NULL == c2) ? ContainerCopyIMP(dest, c1) :
+		                        ContainerOrIMP(dest, c1, c2);
+
+		if (SUCCESS != status)
+		{
+			EraseContainerIMP(result, result->m_size - 1);
+		}
+	}
+
+	if (SUCCESS != status)
+	{
+		RoaringDestroy(result);
+		return NULL;
+	}
+
+	return result;
+}
+
+
+/*******************************************************************************
+******************************** RoaringAnd ***********************************/
+roaring_ty *RoaringAnd(const roaring_ty *roaring1_, const roaring_ty *roaring2_)
+{
+	roaring_ty *result = NULL;
+	const container_ty *c1 = NULL;
+	const container_ty *c2 = NULL;
+	container_ty *dest = NULL;
+	size_t i = 0;
+	size_t j = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(roaring1_);
+	ASSERT_IS_ALLOC(roaring2_);
+
+	result = RoaringCreate();
+	RETURN_IF_BAD(result, "RoaringAnd: Allocation Error", NULL);
+
+	while (SUCCESS == status && i < roaring1_->m_size && j < roaring2_->m_size)
+	{
+		c1 = roaring1_->m_containers + i;
+		c2 = roaring2_->m_containers + j;
+
+		if (c1->m_key != c2->m_key)
+		{
+			i += (c1->m_key < c2->m_key);
+			j += (c2->m_key < c1->m_key);
+			continue;
+		}
+
+		++i;
+		++j;
+
+		dest = InsertContainerIMP(result, result->m_size, c1->m_key);
+		if (NULL == dest)
+		{
+			status = ALLOC_ERR;
+			break;
+		}
+
+		status = ContainerAndIMP(dest, c1, c2);
+
+		/* Disjoint chunks leave no container */
+		if (SUCCESS != status || 0 == dest->m_cardinality)
+		{
+			EraseContainerIMP(result, result->m_size - 1);
+		}
+	}
+
+	if (SUCCESS != status)
+	{
+		RoaringDestroy(result);
+		return NULL;
+	}
+
+	return result;
+}
+
+
+/*******************************************************************************
+**************************** RoaringRunOptimize *******************************/
+int RoaringRunOptimize(roaring_ty *th_)
+{
+	bit_array_ty words[CHUNK_WORDS];
+	container_ty *container = NULL;
+	container_type_ty best = ARRAY_CONTAINER;
+	size_t best_bytes = 0;
+	size_t i = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(th_);
+
+	for (i = 0; i < th_->m_size; ++i)
+	{
+		container = th_->m_containers + i;
+
+		memset(words, 0, sizeof(words));
+		ToWordsIMP(container, words);
+
+		best = DenseTypeIMP(container->m_cardinality);
+		best_bytes = (ARRAY_CONTAINER == best) ?
+		             ARRAY_BYTES(container->m_cardinality) : BITSET_BYTES;
+
+		if (RUN_BYTES(CountRunsIMP(words)) < best_bytes)
+		{
+			best = RUN_CONTAINER;
+		}
+
+		if (best != container->m_type && SUCCESS != FromWordsIMP(container, words, best))
+		{
+			status = ALLOC_ERR;
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+**************************** RoaringMemoryUsage *******************************/
+size_t RoaringMemoryUsage(const roaring_ty *th_)
+{
+	const container_ty *container = NULL;
+	size_t bytes = 0;
+	size_t i = 0;
+
+	ASSERT_IS_ALLOC(th_);
+
+	bytes = sizeof(roaring_ty) + th_->m_capacity * sizeof(container_ty);
+
+	for (i = 0; i < th_->m_size; ++i)
+	{
+		container = th_->m_containers + i;
+
+		switch (container->m_type)
+		{
+			case ARRAY_CONTAINER:
+				bytes += ARRAY_BYTES(container->m_capacity);
+				break;
+
+			case BITSET_CONTAINER:
+				bytes += BITSET_BYTES;
+				break;
+
+			case RUN_CONTAINER:
+				bytes += RUN_BYTES(container->m_capacity);
+				break;
+		}
+	}
+
+	return bytes;
+}
+
+
+/*******************************************************************************
+****************************** RoaringForEach *********************************/
+int RoaringForEach(const roaring_ty *th_, roaring_action_ty action_, void *param_)
+{
+	const container_ty *container = NULL;
+	size_t base = 0;
+	size_t low = 0;
+	size_t i = 0;
+	size_t j = 0;
+	int status = 0;
+
+	ASSERT_IS_ALLOC(th_);
+	assert (NULL != action_ && "RoaringForEach: action is NULL");
+
+	for (i = 0; i < th_->m_size && 0 == status; ++i)
+	{
+		container = th_->m_containers + i;
+		base = container->m_key << CHUNK_BITS;
+
+		switch (container->m_type)
+		{
+			case ARRAY_CONTAINER:
+				for (j = 0; j < container->m_size && 0 == status; ++j)
+				{
+					status = action_(base + SHORTS(container)[j], param_);
+				}
+				break;
+
+			case BITSET_CONTAINER:
+				for (low = NextInWordsIMP(WORDS(container), 0, 1);
+				     low < CHUNK_VALUES && 0 == status;
+				     low = NextInWordsIMP(WORDS(container), low + 1, 1))
+				{
+					status = action_(base + low, param_);
+				}
+				break;
+
+			case RUN_CONTAINER:
+				for (j = 0; j < container->m_size && 0 == status; ++j)
+				{
+					for (low = RUN_START(container, j);
+					     low <= RUN_END(container, j) && 0 == status; ++low)
+					{
+						status = action_(base + low, param_);
+					}
+				}
+				break;
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+
+/* Binary search of a chunk. pos_ is set to the container's position, or to
+	the position it should be inserted at */
+static container_ty *FindContainerIMP(const roaring_ty *th_, size_t key_, size_t *pos_)
+{
+	size_t low = 0;
+	size_t high = th_->m_size;
+	size_t mid = 0;
+
+	while (low < high)
+	{
+		mid = low + (high - low) / 2;
+
+		if (th_->m_containers[mid].m_key < key_)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	*pos_ = low;
+
+	if (low < th_->m_size && key_ == th_->m_containers[low].m_key)
+	{
+		return th_->m_containers + low;
+	}
+
+	return NULL;
+}
+
+/* Inserts an empty array container */
+static container_ty *InsertContainerIMP(roaring_ty *th_, size_t pos_, size_t key_)
+{
+	container_ty *containers = NULL;
+	size_t capacity = 0;
+
+	if (th_->m_size == th_->m_capacity)
+	{
+		capacity = (0 == th_->m_capacity) ? INIT_CAPACITY : th_->m_capacity * 2;
+		containers = (container_ty *)realloc(th_->m_containers,
+		                                     capacity * sizeof(container_ty));
+		if (NULL == containers)
+		{
+			return NULL;
+		}
+
+		th_->m_containers = containers;
+		th_->m_capacity = capacity;
+	}
+
+	memmove(th_->m_containers + pos_ + 1, th_->m_containers + pos_,
+	        (th_->m_size - pos_) * sizeof(container_ty));
+	++th_->m_size;
+
+	th_->m_containers[pos_].m_key = key_;
+	th_->m_containers[pos_].m_cardinality = 0;
+	th_->m_containers[pos_].m_size = 0;
+	th_->m_containers[pos_].m_capacity = 0;
+	th_->m_containers[pos_].m_data = NULL;
+	th_->m_containers[pos_].m_type = ARRAY_CONTAINER;
+
+	return th_->m_containers + pos_;
+}
+
+static void EraseContainerIMP(roaring_ty *th_, size_t pos_)
+{
+	free(th_->m_containers[pos_].m_data);
+
+	--th_->m_size;
+	memmove(th_->m_containers + pos_, th_->m_containers + pos_ + 1,
+	        (th_->m_size - pos_) * sizeof(container_ty));
+}
+
+static int ContainerAddIMP(container_ty *c_, size_t low_)
+{
+	bit_array_ty *word = NULL;
+	size_t pos = 0;
+	int extend_prev = 0;
+	int extend_next = 0;
+
+	switch (c_->m_type)
+	{
+		case ARRAY_CONTAINER:
+			pos = LowerBoundIMP(SHORTS(c_), c_->m_size, 1, low_);
+
+			if (pos < c_->m_size && low_ == SHORTS(c_)[pos])
+			{
+				return SUCCESS;
+			}
+
+			if (ARRAY_MAX == c_->m_size)
+			{
+				bit_array_ty words[CHUNK_WORDS];
+
+				memset(words, 0, sizeof(words));
+				ToWordsIMP(c_, words);
+
+				if (SUCCESS != FromWordsIMP(c_, words, BITSET_CONTAINER))
+				{
+					return ALLOC_ERR;
+				}
+
+				return ContainerAddIMP(c_, low_);
+			}
+
+			if (SUCCESS != ReserveIMP(c_, c_->m_size + 1))
+			{
+				return ALLOC_ERR;
+			}
+
+			memmove(SHORTS(c_) + pos + 1, SHORTS(c_) + pos,
+			        (c_->m_size - pos) * sizeof(unsigned short));
+			SHORTS(c_)[pos] = (unsigned short)low_;
+			++c_->m_size;
+			break;
+
+		case BITSET_CONTAINER:
+			word = WORDS(c_) + low_ / WORD_BITS;
+
+			if (*word & ((bit_array_ty)1 << (low_ % WORD_BITS)))
+			{
+				return SUCCESS;
+			}
+
+			*word |= (bit_array_ty)1 << (low_ % WORD_BITS);
+			break;
+
+		case RUN_CONTAINER:
+			/* pos is one past the last run starting at low_ or before it */
+			pos = LowerBoundIMP(SHORTS(c_), c_->m_size, 2, low_ + 1);
+
+			if (0 < pos && low_ <= RUN_END(c_, pos - 1))
+			{
+				return SUCCESS;
+			}
+
+			extend_prev = (0 < pos && RUN_END(c_, pos - 1) + 1 == low_);
+			extend_next = (pos < c_->m_size && low_ + 1 == RUN_START(c_, pos));
+
+			if (extend_prev && extend_next)
+			{
+				RUN_LENGTH(c_, pos - 1) = (unsigned short)(RUN_END(c_, pos) -
+				                                           RUN_START(c_, pos - 1));
+				--c_->m_size;
+				memmove(SHORTS(c_) + 2 * pos, SHORTS(c_) + 2 * (pos + 1),
+				        (c_->m_size - pos) * 2 * sizeof(unsigned short));
+			}
+			else if (extend_prev)
+			{
+				++RUN_LENGTH(c_, pos - 1);
+			}
+			else if (extend_next)
+			{
+				--RUN_START(c_, pos);
+				++RUN_LENGTH(c_, pos);
+			}
+			else
+			{
+				if (SUCCESS != ReserveIMP(c_, c_->m_size + 1))
+				{
+					return ALLOC_ERR;
+				}
+
+				memmove(SHORTS(c_) + 2 * (pos + 1), SHORTS(c_) + 2 * pos,
+				        (c_->m_size - pos) * 2 * sizeof(unsigned short));
+				RUN_START(c_, pos) = (unsigned short)low_;
+				RUN_LENGTH(c_, pos) = 0;
+				++c_->m_size;
+			}
+
+			++c_->m_cardinality;
+
+			/* Still valid if shrinking fails, only larger */
+			RunShrinkIMP(c_);
+			return SUCCESS;
+	}
+
+	++c_->m_cardinality;
+
+	return SUCCESS;
+}
+
+static int ContainerRemoveIMP(container_ty *c_, size_t low_)
+{
+	bit_array_ty *word = NULL;
+	size_t pos = 0;
+	size_t end = 0;
+
+	switch (c_->m_type)
+	{
+		case ARRAY_CONTAINER:
+			pos = LowerBoundIMP(SHORTS(c_), c_->m_size, 1, low_);
+
+			if (pos == c_->m_size || low_ != SHORTS(c_)[pos])
+			{
+				return SUCCESS;
+			}
+
+			--c_->m_size;
+			memmove(SHORTS(c_) + pos, SHORTS(c_) + pos + 1,
+			        (c_->m_size - pos) * sizeof(unsigned short));
+			break;
+
+		case BITSET_CONTAINER:
+			word = WORDS(c_) + low_ / WORD_BITS;
+
+			if (0 == (*word & ((bit_array_ty)1 << (low_ % WORD_BITS))))
+			{
+				return SUCCESS;
+			}
+
+			*word &= ~((bit_array_ty)1 << (low_ % WORD_BITS));
+			--c_->m_cardinality;
+
+			/* Restore the value if the array cannot be allocated */
+			if (SUCCESS != BitsetShrinkIMP(c_))
+			{
+				*word |= (bit_array_ty)1 << (low_ % WORD_BITS);
+				++c_->m_cardinality;
+				return ALLOC_ERR;
+			}
+
+			return SUCCESS;
+
+		case RUN_CONTAINER:
+			pos = LowerBoundIMP(SHORTS(c_), c_->m_size, 2, low_ + 1);
+
+			if (0 == pos || low_ > RUN_END(c_, pos - 1))
+			{
+				return SUCCESS;
+			}
+
+			--pos;
+			end = RUN_END(c_, pos);
+
+			if (RUN_START(c_, pos) == end)
+			{
+				--c_->m_size;
+				memmove(SHORTS(c_) + 2 * pos, SHORTS(c_) + 2 * (pos + 1),
+				        (c_->m_size - pos) * 2 * sizeof(unsigned short));
+			}
+			else if (RUN_START(c_, pos) == low_)
+			{
+				++RUN_START(c_, pos);
+				--RUN_LENGTH(c_, pos);
+			}
+			else if (end == low_)
+			{
+				--RUN_LENGTH(c_, pos);
+			}
+			else
+			{
+				/* Split the run around low_ */
+				if (SUCCESS != ReserveIMP(c_, c_->m_size + 1))
+				{
+					return ALLOC_ERR;
+				}
+
+				memmove(SHORTS(c_) + 2 * (pos + 2), SHORTS(c_) + 2 * (pos + 1),
+				        (c_->m_size - pos - 1) * 2 * sizeof(unsigned short));
+				RUN_LENGTH(c_, pos) = (unsigned short)(low_ - 1 - RUN_START(c_, pos));
+				RUN_START(c_, pos + 1) = (unsigned short)(low_ + 1);
+				RUN_LENGTH(c_, pos + 1) = (unsigned short)(end - low_ - 1);
+				++c_->m_size;
+			}
+
+			--c_->m_cardinality;
+
+			RunShrinkIMP(c_);
+			return SUCCESS;
+	}
+
+	--c_->m_cardinality;
+
+	return SUCCESS;
+}
+
+static int ContainerContainsIMP(const container_ty *c_, size_t low_)
+{
+	size_t pos = 0;
+
+	switch (c_->m_type)
+	{
+		case ARRAY_CONTAINER:
+			pos = LowerBoundIMP(SHORTS(c_), c_->m_size, 1, low_);
+			return (pos < c_->m_size && low_ == SHORTS(c_)[pos]);
+
+		case BITSET_CONTAINER:
+			return !!(WORDS(c_)[low_ / WORD_BITS] & ((bit_array_ty)1 << (low_ % WORD_BITS)));
+
+		case RUN_CONTAINER:
+			pos = LowerBoundIMP(SHORTS(c_), c_->m_size, 2, low_ + 1);
+			return (0 < pos && low_ <= RUN_END(c_, pos - 1));
+	}
+
+	return 0;
+}
+
+static int ContainerCopyIMP(container_ty *dest_, const container_ty *src_)
+{
+	size_t units = (BITSET_CONTAINER == src_->m_type) ? 0 : src_->m_size;
+
+	if (SUCCESS != AllocDataIMP(dest_, src_->m_type, units))
+	{
+		return ALLOC_ERR;
+	}
+
+	switch (src_->m_type)
+	{
+		case ARRAY_CONTAINER:
+			memcpy(dest_->m_data, src_->m_data, ARRAY_BYTES(units));
+			break;
+
+		case BITSET_CONTAINER:
+			memcpy(dest_->m_data, src_->m_data, BITSET_BYTES);
+			break;
+
+		case RUN_CONTAINER:
+			memcpy(dest_->m_data, src_->m_data, RUN_BYTES(units));
+			break;
+	}
+
+	dest_->m_size = src_->m_size;
+	dest_->m_cardinality = src_->m_cardinality;
+
+	return SUCCESS;
+}
+
+static int ContainerOrIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_)
+{
+	if (ARRAY_CONTAINER == c1_->m_type && ARRAY_CONTAINER == c2_->m_type &&
+	    c1_->m_cardinality + c2_->m_cardinality <= ARRAY_MAX)
+	{
+		return ArrayOrIMP(dest_, c1_, c2_);
+	}
+
+	if (RUN_CONTAINER == c1_->m_type && RUN_CONTAINER == c2_->m_type)
+	{
+		return RunOrIMP(dest_, c1_, c2_);
+	}
+
+	/* Build the union straight in a bitset container */
+	if (SUCCESS != AllocDataIMP(dest_, BITSET_CONTAINER, 0))
+	{
+		return ALLOC_ERR;
+	}
+
+	memset(dest_->m_data, 0, BITSET_BYTES);
+	ToWordsIMP(c1_, WORDS(dest_));
+	ToWordsIMP(c2_, WORDS(dest_));
+	dest_->m_cardinality = CountWordsIMP(WORDS(dest_));
+
+	return BitsetShrinkIMP(dest_);
+}
+
+static int ContainerAndIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_)
+{
+	const container_ty *bitset = c1_;
+	const container_ty *other = c2_;
+	size_t i = 0;
+
+	/* Probe the smaller array in the other container */
+	if (ARRAY_CONTAINER == c1_->m_type && (ARRAY_CONTAINER != c2_->m_type ||
+	    c1_->m_cardinality <= c2_->m_cardinality))
+	{
+		return ArrayFilterIMP(dest_, c1_, c2_);
+	}
+
+	if (ARRAY_CONTAINER == c2_->m_type)
+	{
+		return ArrayFilterIMP(dest_, c2_, c1_);
+	}
+
+	if (RUN_CONTAINER == c1_->m_type && RUN_CONTAINER == c2_->m_type)
+	{
+		return RunAndIMP(dest_, c1_, c2_);
+	}
+
+	/* At least one bitset is left, mask it with the other's words */
+	if (BITSET_CONTAINER != bitset->m_type)
+	{
+		bitset = c2_;
+		other = c1_;
+	}
+
+	if (SUCCESS != AllocDataIMP(dest_, BITSET_CONTAINER, 0))
+	{
+		return ALLOC_ERR;
+	}
+
+	memset(dest_->m_data, 0, BITSET_BYTES);
+	ToWordsIMP(other, WORDS(dest_));
+
+	for (i = 0; i < CHUNK_WORDS; ++i)
+	{
+		WORDS(dest_)[i] &= WORDS(bitset)[i];
+	}
+
+	dest_->m_cardinality = CountWordsIMP(WORDS(dest_));
+
+	return BitsetShrinkIMP(dest_);
+}
+
+/* Merge of two sorted arrays, fitting in an array container */
+static int ArrayOrIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_)
+{
+	const unsigned short *values1 = SHORTS(c1_);
+	const unsigned short *values2 = SHORTS(c2_);
+	unsigned short *out = NULL;
+	size_t i = 0;
+	size_t j = 0;
+	size_t n = 0;
+
+	if (SUCCESS != AllocDataIMP(dest_, ARRAY_CONTAINER,
+	                            c1_->m_size + c2_->m_size))
+	{
+		return ALLOC_ERR;
+	}
+
+	out = SHORTS(dest_);
+
+	while (i < c1_->m_size && j < c2_->m_size)
+	{
+		if (values1[i] < values2[j])
+		{
+			out[n++] = values1[i++];
+		}
+		else if (values2[j] < values1[i])
+		{
+			out[n++] = values2[j++];
+		}
+		else
+		{
+			out[n++] = values1[i++];
+			++j;
+		}
+	}
+
+	while (i < c1_->m_size)
+	{
+		out[n++] = values1[i++];
+	}
+
+	while (j < c2_->m_size)
+	{
+		out[n++] = values2[j++];
+	}
+
+	dest_->m_size = n;
+	dest_->m_cardinality = n;
+
+	return SUCCESS;
+}
+
+/* Values of an array container that are also in another container */
+static int ArrayFilterIMP(container_ty *dest_, const container_ty *array_,
+                          const container_ty *other_)
+{
+	size_t n = 0;
+	size_t i = 0;
+
+	if (SUCCESS != AllocDataIMP(dest_, ARRAY_CONTAINER, array_->m_size))
+	{
+		return ALLOC_ERR;
+	}
+
+	for (i = 0; i < array_->m_size; ++i)
+	{
+		if (ContainerContainsIMP(other_, SHORTS(array_)[i]))
+		{
+			SHORTS(dest_)[n++] = SHORTS(array_)[i];
+		}
+	}
+
+	dest_->m_size = n;
+	dest_->m_cardinality = n;
+
+	return SUCCESS;
+}
+
+/* Merge of two sorted run lists, touching runs are joined */
+static int RunOrIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_)
+{
+	const container_ty *next = NULL;
+	size_t i = 0;
+	size_t j = 0;
+	size_t start = 0;
+	size_t end = 0;
+	size_t n = 0;
+	size_t cardinality = 0;
+	int open = 0;
+
+	if (SUCCESS != AllocDataIMP(dest_, RUN_CONTAINER, c1_->m_size + c2_->m_size))
+	{
+		return ALLOC_ERR;
+	}
+
+	while (i < c1_->m_size || j < c2_->m_size)
+	{
+		/* Next run in start order */
+		if (j == c2_->m_size ||
+		    (i < c1_->m_size && RUN_START(c1_, i) <= RUN_START(c2_, j)))
+		{
+			next = c1_;
+			start = RUN_START(c1_, i);
+			++i;
+		}
+		else
+		{
+			next = c2_;
+			start = RUN_START(c2_, j);
+			++j;
+		}
+
+		if (open && start <= RUN_END(dest_, n - 1) + 1)
+		{
+			end = (next == c1_) ? RUN_END(c1_, i - 1) : RUN_END(c2_, j - 1);
+
+			if (end > RUN_END(dest_, n - 1))
+			{
+				RUN_LENGTH(dest_, n - 1) = (unsigned short)(end - RUN_START(dest_, n - 1));
+			}
+
+			continue;
+		}
+
+		RUN_START(dest_, n) = (unsigned short)start;
+		RUN_LENGTH(dest_, n) = (next == c1_) ? RUN_LENGTH(c1_, i - 1) :
+		                                       RUN_LENGTH(c2_, j - 1);
+		++n;
+		open = 1;
+	}
+
+	for (i = 0; i < n; ++i)
+	{
+		cardinality += RUN_LENGTH(dest_, i) + 1LU;
+	}
+
+	dest_->m_size = n;
+	dest_->m_cardinality = cardinality;
+
+	return RunShrinkIMP(dest_);
+}
+
+/* Overlaps of two sorted run lists */
+static int RunAndIMP(container_ty *dest_, const container_ty *c1_, const container_ty *c2_)
+{
+	size_t i = 0;
+	size_t j = 0;
+	size_t start = 0;
+	size_t end = 0;
+	size_t n = 0;
+	size_t cardinality = 0;
+
+	if (SUCCESS != AllocDataIMP(dest_, RUN_CONTAINER, c1_->m_size + c2_->m_size))
+	{
+		return ALLOC_ERR;
+	}
+
+	while (i < c1_->m_size && j < c2_->m_size)
+	{
+		start = (RUN_START(c1_, i) > RUN_START(c2_, j)) ? RUN_START(c1_, i) :
+		                                                  RUN_START(c2_, j);
+		end = (RUN_END(c1_, i) < RUN_END(c2_, j)) ? RUN_END(c1_, i) : RUN_END(c2_, j);
+
+		if (start <= end)
+		{
+			RUN_START(dest_, n) = (unsigned short)start;
+			RUN_LENGTH(dest_, n) = (unsigned short)(end - start);
+			cardinality += end - start + 1;
+			++n;
+		}
+
+		/* The run that ends first cannot overlap anything else */
+		if (RUN_END(c1_, i) < RUN_END(c2_, j))
+		{
+			++i;
+		}
+		else
+		{
+			++j;
+		}
+	}
+
+	dest_->m_size = n;
+	dest_->m_cardinality = cardinality;
+
+	return RunShrinkIMP(dest_);
+}
+
+/* Converts a run container that grew larger than its array / bitset form */
+static int RunShrinkIMP(container_ty *c_)
+{
+	bit_array_ty words[CHUNK_WORDS];
+	container_type_ty dense = DenseTypeIMP(c_->m_cardinality);
+	size_t dense_bytes = (ARRAY_CONTAINER == dense) ?
+	                     ARRAY_BYTES(c_->m_cardinality) : BITSET_BYTES;
+
+	if (RUN_BYTES(c_->m_size) <= dense_bytes || 0 == c_->m_cardinality)
+	{
+		return SUCCESS;
+	}
+
+	memset(words, 0, sizeof(words));
+	ToWordsIMP(c_, words);
+
+	return FromWordsIMP(c_, words, dense);
+}
+
+/* Converts a bitset container that holds few enough values for an array */
+static int BitsetShrinkIMP(container_ty *c_)
+{
+	if (ARRAY_MAX < c_->m_cardinality)
+	{
+		return SUCCESS;
+	}
+
+	return FromWordsIMP(c_, WORDS(c_), ARRAY_CONTAINER);
+}
+
+/* Grows an array / run container to hold needed_ values / pairs */
+static int ReserveIMP(container_ty *c_, size_t needed_)
+{
+	size_t capacity = (0 == c_->m_capacity) ? INIT_CAPACITY : c_->m_capacity;
+	size_t unit = (ARRAY_CONTAINER == c_->m_type) ? ARRAY_BYTES(1) : RUN_BYTES(1);
+	void *data = NULL;
+
+	if (needed_ <= c_->m_capacity)
+	{
+		return SUCCESS;
+	}
+
+	while (capacity < needed_)
+	{
+		capacity *= 2;
+	}
+
+	data = realloc(c_->m_data, capacity * unit);
+	RETURN_IF_BAD(data, "Roaring: Allocation Error", ALLOC_ERR);
+
+	c_->m_data = data;
+	c_->m_capacity = capacity;
+
+	return SUCCESS;
+}
+
+/* Replaces the data of a container with an empty buffer of type_ */
+static int AllocDataIMP(container_ty *c_, container_type_ty type_, size_t capacity_)
+{
+	size_t bytes = BITSET_BYTES;
+	void *data = NULL;
+
+	if (0 == capacity_)
+	{
+		capacity_ = 1;
+	}
+
+	if (ARRAY_CONTAINER == type_)
+	{
+		bytes = ARRAY_BYTES(capacity_);
+	}
+	else if (RUN_CONTAINER == type_)
+	{
+		bytes = RUN_BYTES(capacity_);
+	}
+
+	data = malloc(bytes);
+	RETURN_IF_BAD(data, "Roaring: Allocation Error", ALLOC_ERR);
+
+	free(c_->m_data);
+	c_->m_data = data;
+	c_->m_type = type_;
+	c_->m_capacity = (BITSET_CONTAINER == type_) ? 0 : capacity_;
+	c_->m_size = 0;
+
+	return SUCCESS;
+}
+
+/* ORs the values of a container into a 65536 bits chunk */
+static void ToWordsIMP(const container_ty *c_, bit_array_ty *words_)
+{
+	size_t i = 0;
+
+	switch (c_->m_type)
+	{
+		case ARRAY_CONTAINER:
+			for (i = 0; i < c_->m_size; ++i)
+			{
+				words_[SHORTS(c_)[i] / WORD_BITS] |=
+					(bit_array_ty)1 << (SHORTS(c_)[i] % WORD_BITS);
+			}
+			break;
+
+		case BITSET_CONTAINER:
+			for (i = 0; i < CHUNK_WORDS; ++i)
+			{
+				words_[i] |= WORDS(c_)[i];
+			}
+			break;
+
+		case RUN_CONTAINER:
+			for (i = 0; i < c_->m_size; ++i)
+			{
+				SetRangeIMP(words_, RUN_START(c_, i), RUN_END(c_, i));
+			}
+			break;
+	}
+}
+
+/* Rebuilds a container as type_ from a 65536 bits chunk. words_ may be the
+	container's own bitset, it is read before the old data is freed */
+static int FromWordsIMP(container_ty *c_, const bit_array_ty *words_,
+                        container_type_ty type_)
+{
+	container_ty built = {0};
+	size_t cardinality = CountWordsIMP(words_);
+	size_t start = 0;
+	size_t end = 0;
+	size_t capacity = cardinality;
+
+	built.m_key = c_->m_key;
+
+	if (RUN_CONTAINER == type_)
+	{
+		capacity = CountRunsIMP(words_);
+	}
+
+	if (SUCCESS != AllocDataIMP(&built, type_, capacity))
+	{
+		return ALLOC_ERR;
+	}
+
+	switch (type_)
+	{
+		case ARRAY_CONTAINER:
+			for (start = NextInWordsIMP(words_, 0, 1); start < CHUNK_VALUES;
+			     start = NextInWordsIMP(words_, start + 1, 1))
+			{
+				SHORTS(&built)[built.m_size++] = (unsigned short)start;
+			}
+			break;
+
+		case BITSET_CONTAINER:
+			memcpy(built.m_data, words_, BITSET_BYTES);
+			break;
+
+		case RUN_CONTAINER:
+			for (start = NextInWordsIMP(words_, 0, 1); start < CHUNK_VALUES;
+			     start = NextInWordsIMP(words_, end, 1))
+			{
+				end = NextInWordsIMP(words_, start, 0);
+				RUN_START(&built, built.m_size) = (unsigned short)start;
+				RUN_LENGTH(&built, built.m_size) = (unsigned short)(end - 1 - start);
+				++built.m_size;
+			}
+			break;
+	}
+
+	built.m_cardinality = cardinality;
+
+	free(c_->m_data);
+	*c_ = built;
+
+	return SUCCESS;
+}
+
+/* Array or bitset, whichever is smaller for the cardinality */
+static container_type_ty DenseTypeIMP(size_t cardinality_)
+{
+	return (cardinality_ <= ARRAY_MAX) ? ARRAY_CONTAINER : BITSET_CONTAINER;
+}
+
+static size_t CountWordsIMP(const bit_array_ty *words_)
+{
+	size_t counter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < CHUNK_WORDS; ++i)
+	{
+		counter += BitArrCountOn(words_[i]);
+	}
+
+	return counter;
+}
+
+/* A run starts at each set bit whose lower neighbour is clear */
+static size_t CountRunsIMP(const bit_array_ty *words_)
+{
+	bit_array_ty carry = 0;
+	size_t counter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < CHUNK_WORDS; ++i)
+	{
+		counter += BitArrCountOn(words_[i] & ~((words_[i] << 1) | carry));
+		carry = words_[i] >> (WORD_BITS - 1);
+	}
+
+	return counter;
+}
+
+/* Index of the first bit in state_ at from_ or above; CHUNK_VALUES if none */
+static size_t NextInWordsIMP(const bit_array_ty *words_, size_t from_, int state_)
+{
+	size_t index = from_ / WORD_BITS;
+	bit_array_ty word = 0;
+
+	if (from_ >= CHUNK_VALUES)
+	{
+		return CHUNK_VALUES;
+	}
+
+	word = (state_ ? words_[index] : ~words_[index]) & (ALL_ON << (from_ % WORD_BITS));
+
+	while (0 == word)
+	{
+		if (++index == CHUNK_WORDS)
+		{
+			return CHUNK_VALUES;
+		}
+
+		word = state_ ? words_[index] : ~words_[index];
+	}
+
+	return index * WORD_BITS + BitArrCountTrailingZeros(word);
+}
+
+/* Sets bits in range [first_, last_] */
+static void SetRangeIMP(bit_array_ty *words_, size_t first_, size_t last_)
+{
+	size_t low = first_ / WORD_BITS;
+	size_t high = last_ / WORD_BITS;
+	bit_array_ty first_mask = ALL_ON << (first_ % WORD_BITS);
+	bit_array_ty last_mask = ALL_ON >> (WORD_BITS - 1 - last_ % WORD_BITS);
+	size_t i = 0;
+
+	if (low == high)
+	{
+		words_[low] |= first_mask & last_mask;
+		return;
+	}
+
+	words_[low] |= first_mask;
+
+	for (i = low + 1; i < high; ++i)
+	{
+		words_[i] = ALL_ON;
+	}
+
+	words_[high] |= last_mask;
+}
+
+/* First position i in [0, n_) with arr_[i * stride_] >= key_, or n_ */
+static size_t LowerBoundIMP(const unsigned short *arr_, size_t n_, size_t stride_,
+                            size_t key_)
+{
+	size_t low = 0;
+	size_t high = n_;
+	size_t mid = 0;
+
+	while (low < high)
+	{
+		mid = low + (high - low) / 2;
+
+		if (arr_[mid * stride_] < key_)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return low;
+}
@@ -0,0 +1,399 @@
+/*******************************************************************************
+***************************** - SEGMENTED VECTOR - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a stable-address segmented vector
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/seg_vector.c test/seg_vector_test.c -I ./include
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* calloc, free */
+#include <string.h>			/* memcpy, memset */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "seg_vector.h"
+
+#define FIRST_CHUNK_LOG			6LU
+#define FIRST_CHUNK				(1LU << FIRST_CHUNK_LOG)	/* 64 elements */
+#define MAX_CHUNKS				(64 - FIRST_CHUNK_LOG)
+
+/* Chunk k holds FIRST_CHUNK << k elements, starting at index CHUNK_START(k) */
+#define CHUNK_START(k)			(FIRST_CHUNK * ((1LU << (k)) - 1))
+#define CHUNK_ELEMENTS(k)		(FIRST_CHUNK << (k))
+
+#ifdef __GNUC__
+#define MSB_INDEX(x)			(63 - (size_t)__builtin_clzl(x))
+#else
+#define MSB_INDEX(x)			MsbIndexIMP(x)
+#endif
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "SEG VECTOR is not allocated");
+
+struct seg_vector
+{
+	char *m_chunks[MAX_CHUNKS];	/* Directory, never reallocated */
+	size_t m_n_chunks;
+	size_t m_size;
+	size_t m_element_size;
+};
+
+
+static char *ElementIMP(const seg_vector_ty *th_, size_t index_);
+static int AddChunkIMP(seg_vector_ty *th_);
+static void ZeroRangeIMP(seg_vector_ty *th_, size_t from_, size_t to_);
+#ifndef __GNUC__
+static size_t MsbIndexIMP(size_t x_);
+#endif
+
+
+/*******************************************************************************
+***************************** SegVectorCreate *********************************/
+seg_vector_ty *SegVectorCreate(size_t capacity_, size_t size_)
+{
+	return SegVectorCreateTyped(sizeof(void *), capacity_, size_);
+}
+
+
+/*******************************************************************************
+************************** SegVectorCreateTyped *******************************/
+seg_vector_ty *SegVectorCreateTyped(size_t element_size_, size_t capacity_,
+                                    size_t size_)
+{
+	seg_vector_ty *vector = NULL;
+
+	assert (0 != element_size_ && "Element size cannot be zero");
+
+	/* calloc leaves the directory all NULL */
+	vector = (seg_vector_ty *)calloc(1, sizeof(seg_vector_ty));
+	RETURN_IF_BAD(vector, "SegVectorCreate: Allocation Error", NULL);
+
+	vector->m_element_size = element_size_;
+
+	if (capacity_ < size_)
+	{
+		capacity_ = size_;
+	}
+
+	/* New chunks are calloced, the size elements are already zero */
+	if (SUCCESS != AddChunkIMP(vector) ||
+	    SUCCESS != SegVectorReserve(vector, capacity_))
+	{
+		SegVectorDestroy(vector);
+		return NULL;
+	}
+
+	vector->m_size = size_;
+
+	return vector;
+}
+
+
+/*******************************************************************************
+***************************** SegVectorDestroy ********************************/
+void SegVectorDestroy(seg_vector_ty *vector_)
+{
+	size_t k = 0;
+
+	ASSERT_IS_ALLOC(vector_);
+
+	for (k = 0; k < vector_->m_n_chunks; ++k)
+	{
+		free(vector_->m_chunks[k]);
+		DEBUG_MODE(
+		vector_->m_chunks[k] = DEAD_MEM(char *);
+		);
+	}
+
+	free(vector_);
+}
+
+
+/*******************************************************************************
+******************************* SegVectorSet **********************************/
+void SegVectorSet(seg_vector_ty *vector_, void *value_, size_t index_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (sizeof(void *) == vector_->m_element_size &&
+	        "Vector holds values, use the Value functions");
+	assert (index_ < SegVectorCapacity(vector_) &&
+	        "Index is out of vector capacity range");
+
+	*(void **)ElementIMP(vector_, index_) = value_;
+}
+
+
+/*******************************************************************************
+******************************* SegVectorGet **********************************/
+void *SegVectorGet(const seg_vector_ty *vector_, size_t index_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (sizeof(void *) == vector_->m_element_size &&
+	        "Vector holds values, use the Value functions");
+	assert (index_ < vector_->m_size && "Index must be in size value range");
+
+	return *(void **)ElementIMP(vector_, index_);
+}
+
+
+/*******************************************************************************
+**************************** SegVectorSetValue ********************************/
+void SegVectorSetValue(seg_vector_ty *vector_, size_t index_, const void *value_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (index_ < SegVectorCapacity(vector_) &&
+	        "Index is out of vector capacity range");
+
+	memcpy(ElementIMP(vector_, index_), value_, vector_->m_element_size);
+}
+
+
+/*******************************************************************************
+**************************** SegVectorGetValue ********************************/
+void SegVectorGetValue(const seg_vector_ty *vector_, size_t index_, void *value_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (index_ < vector_->m_size && "Index must be in size value range");
+
+	memcpy(value_, ElementIMP(vector_, index_), vector_->m_element_size);
+}
+
+
+/*******************************************************************************
+******************************* SegVectorAt ***********************************/
+void *SegVectorAt(const seg_vector_ty *vector_, size_t index_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (index_ < SegVectorCapacity(vector_) &&
+	        "Index is out of vector capacity range");
+
+	return ElementIMP(vector_, index_);
+}
+
+
+/*******************************************************************************
+****************************** SegVectorSize **********************************/
+size_t SegVectorSize(const seg_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	return vector_->m_size;
+}
+
+
+/*******************************************************************************
+**************************** SegVectorCapacity ********************************/
+size_t SegVectorCapacity(const seg_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	return CHUNK_START(vector_->m_n_chunks);
+}
+
+
+/*******************************************************************************
+************************** SegVectorElementSize *******************************/
+size_t SegVectorElementSize(const seg_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	return vector_->m_element_size;
+}
+
+
+/*******************************************************************************
+***************************** SegVectorResize *********************************/
+int SegVectorResize(seg_vector_ty *vector_, size_t new_size_)
+{
+	size_t old_capacity = 0;
+	int err = SUCCESS;
+
+	ASSERT_IS_ALLOC(vector_);
+
+	old_capacity = SegVectorCapacity(vector_);
+
+	err = SegVectorReserve(vector_, new_size_);
+
+	if (SUCCESS != err)
+	{
+		return err;
+	}
+
+	/* Chunks added by Reserve are calloced, only reused slots are zeroed */
+	if (new_size_ > vector_->m_size)
+	{
+		ZeroRangeIMP(vector_, vector_->m_size,
+		             (new_size_ < old_capacity) ? new_size_ : old_capacity);
+	}
+
+	vector_->m_size = new_size_;
+
+	return err;
+}
+
+
+/*******************************************************************************
+***************************** SegVectorReserve ********************************/
+int SegVectorReserve(seg_vector_ty *vector_, size_t new_capacity_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	while (SegVectorCapacity(vector_) < new_capacity_)
+	{
+		if (SUCCESS != AddChunkIMP(vector_))
+		{
+			return ALLOC_ERR;
+		}
+	}
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+***************************** SegVectorShrink *********************************/
+void SegVectorShrink(seg_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	while (vector_->m_n_chunks > 1 &&
+	       CHUNK_START(vector_->m_n_chunks - 1) >= vector_->m_size)
+	{
+		--vector_->m_n_chunks;
+		free(vector_->m_chunks[vector_->m_n_chunks]);
+		vector_->m_chunks[vector_->m_n_chunks] = NULL;
+	}
+}
+
+
+/*******************************************************************************
+**************************** SegVectorPushBack ********************************/
+int SegVectorPushBack(seg_vector_ty *vector_, void *element_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (sizeof(void *) == vector_->m_element_size &&
+	        "Vector holds values, use the Value functions");
+
+	return SegVectorPushBackValue(vector_, &element_);
+}
+
+
+/*******************************************************************************
+************************* SegVectorPushBackValue ******************************/
+int SegVectorPushBackValue(seg_vector_ty *vector_, const void *value_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	if (vector_->m_size == SegVectorCapacity(vector_) &&
+	    SUCCESS != AddChunkIMP(vector_))
+	{
+		return ALLOC_ERR;
+	}
+
+	memcpy(ElementIMP(vector_, vector_->m_size), value_, vector_->m_element_size);
+	++vector_->m_size;
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+**************************** SegVectorPopBack *********************************/
+void *SegVectorPopBack(seg_vector_ty *vector_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (sizeof(void *) == vector_->m_element_size &&
+	        "Vector holds values, use the Value functions");
+	assert (0 != vector_->m_size && "Cannot pop an empty vector");
+
+	--vector_->m_size;
+
+	return *(void **)ElementIMP(vector_, vector_->m_size);
+}
+
+
+/*******************************************************************************
+************************** SegVectorPopBackValue ******************************/
+void SegVectorPopBackValue(seg_vector_ty *vector_, void *value_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (0 != vector_->m_size && "Cannot pop an empty vector");
+
+	--vector_->m_size;
+
+	if (NULL != value_)
+	{
+		memcpy(value_, ElementIMP(vector_, vector_->m_size),
+		       vector_->m_element_size);
+	}
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+/* index + FIRST_CHUNK has its MSB at FIRST_CHUNK_LOG + k for chunk k, the
+	bits below the MSB are the offset inside the chunk */
+static char *ElementIMP(const seg_vector_ty *th_, size_t index_)
+{
+	size_t biased = index_ + FIRST_CHUNK;
+	size_t msb = MSB_INDEX(biased);
+	size_t chunk = msb - FIRST_CHUNK_LOG;
+	size_t offset = biased - (1LU << msb);
+
+	return th_->m_chunks[chunk] + offset * th_->m_element_size;
+}
+
+static int AddChunkIMP(seg_vector_ty *th_)
+{
+	size_t k = th_->m_n_chunks;
+	char *chunk = NULL;
+
+	if (MAX_CHUNKS == k)
+	{
+		return ALLOC_ERR;
+	}
+
+	chunk = (char *)calloc(CHUNK_ELEMENTS(k), th_->m_element_size);
+
+	if (NULL == chunk)
+	{
+		return ALLOC_ERR;
+	}
+
+	th_->m_chunks[k] = chunk;
+	++th_->m_n_chunks;
+
+	return SUCCESS;
+}
+
+/* Zeroes [from_, to_) chunk by chunk, to_ <= capacity */
+static void ZeroRangeIMP(seg_vector_ty *th_, size_t from_, size_t to_)
+{
+	size_t chunk_end = 0;
+	size_t end = 0;
+
+	while (from_ < to_)
+	{
+		chunk_end = CHUNK_START(MSB_INDEX(from_ + FIRST_CHUNK) - FIRST_CHUNK_LOG + 1);
+		end = (to_ < chunk_end) ? to_ : chunk_end;
+
+		memset(ElementIMP(th_, from_), 0, (end - from_) * th_->m_element_size);
+		from_ = end;
+	}
+}
+
+#ifndef __GNUC__
+static size_t MsbIndexIMP(size_t x_)
+{
+	size_t msb = 0;
+
+	while (x_ >>= 1)
+	{
+		++msb;
+	}
+
+	return msb;
+}
+#endif
@@ -0,0 +1,287 @@
+/*******************************************************************************
+************************* - SINGLE PRODUCER QUEUE - ****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a lock-free single producer / single
+*					consumer ring queue
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/spsc_queue.c test/spsc_queue_test.c
+*					-I ./include -pthread
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, calloc, free */
+#include <string.h>			/* memcpy */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "spsc_queue.h"
+
+#ifndef __GNUC__
+#error "spsc_queue requires the GCC / Clang __atomic builtins"
+#endif
+
+#define QUEUE_FULL				2
+#define QUEUE_EMPTY				3
+
+#define CACHE_LINE				64LU
+#define MIN_CAPACITY			2LU
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "SPSC QUEUE is not allocated");
+
+/* head and tail only grow, a slot is found by masking them.
+	Read-only fields, producer fields and consumer fields each have their own
+	cache line, so the two threads only share a line when one of them must
+	read the other's index. */
+struct spsc_queue
+{
+	void **m_slots;
+	size_t m_mask;
+	char m_pad0[CACHE_LINE - sizeof(void **) - sizeof(size_t)];
+	size_t m_tail;				/* Written by the producer */
+	size_t m_head_cache;		/* Producer's copy of m_head */
+	char m_pad1[CACHE_LINE - 2 * sizeof(size_t)];
+	size_t m_head;				/* Written by the consumer */
+	size_t m_tail_cache;		/* Consumer's copy of m_tail */
+	char m_pad2[CACHE_LINE - 2 * sizeof(size_t)];
+};
+
+
+static size_t FreeSlotsIMP(spsc_queue_ty *th_, size_t tail_, size_t wanted_);
+static size_t UsedSlotsIMP(spsc_queue_ty *th_, size_t head_, size_t wanted_);
+
+
+/*******************************************************************************
+****************************** SpscQueueCreate ********************************/
+spsc_queue_ty *SpscQueueCreate(size_t capacity_)
+{
+	spsc_queue_ty *queue = NULL;
+	size_t slots = MIN_CAPACITY;
+
+	/* calloc leaves all the indexes 0 */
+	queue = (spsc_queue_ty *)calloc(1, sizeof(spsc_queue_ty));
+	RETURN_IF_BAD(queue, "SpscQueueCreate: Allocation Error", NULL);
+
+	while (slots < capacity_)
+	{
+		slots <<= 1;
+	}
+
+	queue->m_slots = (void **)malloc(slots * sizeof(void *));
+
+	if (NULL == queue->m_slots)
+	{
+		free(queue);
+		return NULL;
+	}
+
+	queue->m_mask = slots - 1;
+
+	return queue;
+}
+
+
+/*******************************************************************************
+***************************** SpscQueueDestroy ********************************/
+void SpscQueueDestroy(spsc_queue_ty *queue_)
+{
+	ASSERT_IS_ALLOC(queue_);
+
+	free(queue_->m_slots);
+	DEBUG_MODE(
+	queue_->m_slots = DEAD_MEM(void **);
+	);
+
+	free(queue_);
+}
+
+
+/*******************************************************************************
+***************************** SpscQueueEnqueue ********************************/
+int SpscQueueEnqueue(spsc_queue_ty *queue_, void *element_)
+{
+	size_t tail = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+
+	tail = queue_->m_tail;
+
+	if (0 == FreeSlotsIMP(queue_, tail, 1))
+	{
+		return QUEUE_FULL;
+	}
+
+	queue_->m_slots[tail & queue_->m_mask] = element_;
+
+	/* Releases the slot to the consumer */
+	__atomic_store_n(&queue_->m_tail, tail + 1, __ATOMIC_RELEASE);
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+***************************** SpscQueueDequeue ********************************/
+int SpscQueueDequeue(spsc_queue_ty *queue_, void **element_)
+{
+	size_t head = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+	assert (NULL != element_);
+
+	head = queue_->m_head;
+
+	if (0 == UsedSlotsIMP(queue_, head, 1))
+	{
+		return QUEUE_EMPTY;
+	}
+
+	*element_ = queue_->m_slots[head & queue_->m_mask];
+
+	/* Hands the slot back to the producer */
+	__atomic_store_n(&queue_->m_head, head + 1, __ATOMIC_RELEASE);
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+***************************** SpscQueueEnqueueN *******************************/
+size_t SpscQueueEnqueueN(spsc_queue_ty *queue_, void *const *elements_, size_t n_)
+{
+	size_t tail = 0;
+	size_t first = 0;
+	size_t until_end = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+	assert (NULL != elements_ || 0 == n_);
+
+	tail = queue_->m_tail;
+	n_ = FreeSlotsIMP(queue_, tail, n_);
+
+	if (0 == n_)
+	{
+		return 0;
+	}
+
+	/* The run may wrap around the end of the slots */
+	first = tail & queue_->m_mask;
+	until_end = queue_->m_mask + 1 - first;
+
+	if (n_ <= until_end)
+	{
+		memcpy(queue_->m_slots + first, elements_, n_ * sizeof(void *));
+	}
+	else
+	{
+		memcpy(queue_->m_slots + first, elements_, until_end * sizeof(void *));
+		memcpy(queue_->m_slots, elements_ + until_end, (n_ - until_end) * sizeof(void *));
+	}
+
+	__atomic_store_n(&queue_->m_tail, tail + n_, __ATOMIC_RELEASE);
+
+	return n_;
+}
+
+
+/*******************************************************************************
+***************************** SpscQueueDequeueN *******************************/
+size_t SpscQueueDequeueN(spsc_queue_ty *queue_, void **elements_, size_t n_)
+{
+	size_t head = 0;
+	size_t first = 0;
+	size_t until_end = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+	assert (NULL != elements_ || 0 == n_);
+
+	head = queue_->m_head;
+	n_ = UsedSlotsIMP(queue_, head, n_);
+
+	if (0 == n_)
+	{
+		return 0;
+	}
+
+	first = head & queue_->m_mask;
+	until_end = queue_->m_mask + 1 - first;
+
+	if (n_ <= until_end)
+	{
+		memcpy(elements_, queue_->m_slots + first, n_ * sizeof(void *));
+	}
+	else
+	{
+		memcpy(elements_, queue_->m_slots + first, until_end * sizeof(void *));
+		memcpy(elements_ + until_end, queue_->m_slots, (n_ - until_end) * sizeof(void *));
+	}
+
+	__atomic_store_n(&queue_->m_head, head + n_, __ATOMIC_RELEASE);
+
+	return n_;
+}
+
+
+/*******************************************************************************
+****************************** SpscQueueSize **********************************/
+size_t SpscQueueSize(const spsc_queue_ty *queue_)
+{
+	size_t head = 0;
+	size_t tail = 0;
+
+	ASSERT_IS_ALLOC(queue_);
+
+	/* head first: it never passes the tail read after it */
+	head = __atomic_load_n(&queue_->m_head, __ATOMIC_ACQUIRE);
+	tail = __atomic_load_n(&queue_->m_tail, __ATOMIC_ACQUIRE);
+
+	return tail - head;
+}
+
+
+/*******************************************************************************
+**************************** SpscQueueCapacity ********************************/
+size_t SpscQueueCapacity(const spsc_queue_ty *queue_)
+{
+	ASSERT_IS_ALLOC(queue_);
+
+	return queue_->m_mask + 1;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+/* Producer side. Returns min(free slots, wanted_), reading the consumer's
+	head only when the cached copy does not leave wanted_ free slots. */
+static size_t FreeSlotsIMP(spsc_queue_ty *th_, size_t tail_, size_t wanted_)
+{
+	size_t capacity = th_->m_mask + 1;
+	size_t free_slots = capacity - (tail_ - th_->m_head_cache);
+
+	if (free_slots < wanted_)
+	{
+		/* Acquires the slots the consumer is done reading */
+		th_->m_head_cache = __atomic_load_n(&th_->m_head, __ATOMIC_ACQUIRE);
+		free_slots = capacity - (tail_ - th_->m_head_cache);
+	}
+
+	return (free_slots < wanted_) ? free_slots : wanted_;
+}
+
+
+/* Consumer side. Returns min(used slots, wanted_), reading the producer's
+	tail only when the cached copy does not show wanted_ elements. */
+static size_t UsedSlotsIMP(spsc_queue_ty *th_, size_t head_, size_t wanted_)
+{
+	size_t used_slots = th_->m_tail_cache - head_;
+
+	if (used_slots < wanted_)
+	{
+		/* Acquires the elements the producer has written */
+		th_->m_tail_cache = __atomic_load_n(&th_->m_tail, __ATOMIC_ACQUIRE);
+		used_slots = th_->m_tail_cache - head_;
+	}
+
+	return (used_slots < wanted_) ? used_slots : wanted_;
+}
@@ -8,15 +8,21 @@
 *
 *******************************************************************************/
 
+#define _GNU_SOURCE	/* MAP_ANONYMOUS, MAP_NORESERVE, madvise */
+
 #include <stddef.h>	/* size_t */
-#include <stdlib.h>	/* malloc */
+#include <stdlib.h>	/* malloc, free */
 #include <assert.h>	/* assert */
+#include <sys/mman.h>	/* mmap, mprotect, madvise, munmap */
 
 #include "stack.h"
 
 #define SIZE_PTR 		sizeof(void *)
 #define STRUCT_MEMBERS 	sizeof(stack_ty)
 
+#define SUCCESS			0
+#define ALLOC_ERR		1
+
 #define DEAD_MEM(POINTER) (POINTER)0xDEADBEEF
 
 #ifdef NDEBUG
@@ -25,103 +31,317 @@
 #define DEBUG_ONLY(x) x
 #endif
 
+/* A reserved stack commits and releases its range in steps of
+	COMMIT_BYTES, a multiple of the page size */
+#define COMMIT_BYTES	(64LU << 10)
+#define COMMIT_ROUND(bytes)	(((bytes) + COMMIT_BYTES - 1) & ~(COMMIT_BYTES - 1))
+#define IS_RESERVED(stack)	(0 != (stack)->reserved)
+
+/* The elements of a segment follow its header */
+#define SEGMENT_ELEMENTS(segment) ((void **)((segment) + 1))
+
+typedef struct segment segment_ty;
+
+struct segment
+{
+	segment_ty *prev;
+	size_t capacity;
+};
 
-struct stack 
+/* top, start and end bound the current (top most) segment only.
+	A reserved stack has no segments, start and end bound its whole range
+	and only start .. committed is readable and writable. */
+struct stack
 {
 	void **top;
 	void **start;
 	void **end;
+	void **committed;		/* Push needs more room at committed */
+	segment_ty *segment;
+	segment_ty *spare;		/* Empty segment above the current one, kept */
+	size_t below;			/* Elements in the segments under the current one */
+	size_t reserved;		/* Bytes mapped by a reserved stack, 0 otherwise */
 };
 
 
+static segment_ty *CreateSegment(segment_ty *prev, size_t capacity);
+static void EnterSegment(stack_ty *stack, segment_ty *segment);
+static int NextSegment(stack_ty *stack);
+static void PrevSegment(stack_ty *stack);
+static int CommitPages(stack_ty *stack);
+static void ReleasePages(stack_ty *stack);
+
+
 stack_ty *StackCreate(const size_t capacity)
 {
-	/* Create a stack struct the size of 3 pointer */
+	/* Create a stack struct */
 	stack_ty *stack = (stack_ty *)malloc(STRUCT_MEMBERS);
 
 	if (NULL == stack)
 	{
 		return NULL;
 	}
-	
-	/* Create a stack array in data buff member the size of capacity */
-	stack->start = (void **)malloc(capacity * SIZE_PTR);
 
-	if (NULL == stack->start)
+	/* Check that capacity is above zero */
+	assert (capacity != 0 && "stack size must be at least one");
+
+	/* The first segment holds capacity elements */
+	stack->segment = CreateSegment(NULL, capacity);
+
+	if (NULL == stack->segment)
 	{
 		free(stack);
 		return NULL;
 	}
 
-	/* Check that capacity is above zero */
-	assert (capacity != 0 && "stack size must be at least one");
-	
-	/* top pointer will point the start of the struct */
+	stack->spare = NULL;
+	stack->below = 0;
+	stack->reserved = 0;
+	EnterSegment(stack, stack->segment);
+
+	/* top pointer will point the start of the segment */
 	stack->top = stack->start;
-	
-	/* end pointer will point the end */
-	stack->end = stack->start + capacity;
-	
+
+	return stack;
+}
+
+stack_ty *StackCreateReserved(const size_t max_capacity)
+{
+	stack_ty *stack = NULL;
+	void *range = NULL;
+
+	assert (max_capacity != 0 && "stack size must be at least one");
+
+	stack = (stack_ty *)malloc(STRUCT_MEMBERS);
+
+	if (NULL == stack)
+	{
+		return NULL;
+	}
+
+	/* Address space only: no memory and no swap is claimed for it */
+	stack->reserved = COMMIT_ROUND(max_capacity * SIZE_PTR);
+	range = mmap(NULL, stack->reserved, PROT_NONE,
+	             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+	if (MAP_FAILED == range)
+	{
+		free(stack);
+		return NULL;
+	}
+
+	stack->start = (void **)range;
+	stack->end = stack->start + stack->reserved / SIZE_PTR;
+	stack->committed = stack->start;
+	stack->top = stack->start;
+	stack->segment = NULL;
+	stack->spare = NULL;
+	stack->below = 0;
+
 	return stack;
 }
 
 void StackDestory(stack_ty *stack)
 {
+	segment_ty *prev = NULL;
+
 	assert (stack != NULL && "stack is not allocated");
 
-/*	DEAD_MEM(stack->top);*/
-/*	DEAD_MEM(stack->start);*/
-/*	DEAD_MEM(stack->end);*/
-	
-	free(stack->start);
+	if (IS_RESERVED(stack))
+	{
+		munmap(stack->start, stack->reserved);
+	}
+
+	while (NULL != stack->segment)
+	{
+		prev = stack->segment->prev;
+		free(stack->segment);
+		stack->segment = prev;
+	}
+
+	free(stack->spare);
+
+	stack->top = DEAD_MEM(void **);
+	stack->start = DEAD_MEM(void **);
+	stack->end = DEAD_MEM(void **);
+
 	free(stack);
 }
 
 void StackPop(stack_ty *stack)
 {
 	assert (stack != NULL && "stack is not allocated");
-	assert (stack->top >= stack->start && "Pop cannot be executed while stack is empty");
-	
-/*	DEBUG_ONLY(*DEAD_MEM(stack->top));*/
+	assert (stack->top > stack->start && "Pop cannot be executed while stack is empty");
+
 	--stack->top;
+
+	if (IS_RESERVED(stack))
+	{
+		ReleasePages(stack);
+	}
+	else if (stack->top == stack->start && NULL != stack->segment->prev)
+	{
+		PrevSegment(stack);
+	}
 }
 
-void StackPush(stack_ty *stack, void *element)
+int StackPush(stack_ty *stack, void *element)
 {
+	int status = SUCCESS;
+
 	assert (stack != NULL && "stack is not allocated");
-	assert (stack->top <= stack->end && "Push element will cause an overflow");
-	
+
+	if (stack->top == stack->committed)
+	{
+		status = IS_RESERVED(stack) ? CommitPages(stack) : NextSegment(stack);
+
+		if (SUCCESS != status)
+		{
+			return status;
+		}
+	}
+
 	*(stack->top) = element;
 	++stack->top;
+
+	return SUCCESS;
 }
 
 void *StackPeek(const stack_ty *stack)
 {
 	assert (stack != NULL && "stack is not allocated");
-	assert (stack->top >= stack->start && "Peek cannot be executed while stack is empty");
-	
+	assert (stack->top > stack->start && "Peek cannot be executed while stack is empty");
+
 	return *(stack->top - 1);
 }
 
 size_t StackSize(const stack_ty *stack)
 {
 	assert (stack != NULL && "stack is not allocated");
-	
-	return (stack->top - stack->start);
+
+	return (stack->below + (stack->top - stack->start));
 }
 
 int StackIsEmpty(const stack_ty *stack)
 {
 	assert (stack != NULL && "stack is not allocated");
-	
+
 	return !!(stack->start == stack->top);
 }
 
 size_t StackCapacity(const stack_ty *stack)
 {
 	assert (stack != NULL && "stack is not allocated");
-	
-	return (stack->end - stack->start);
+
+	/* A reserved stack counts its whole range */
+	return (stack->below + (stack->end - stack->start) +
+	        ((NULL != stack->spare) ? stack->spare->capacity : 0));
+}
+
+
+/*******************************************************************************
+***************************** Side Functions **********************************/
+static segment_ty *CreateSegment(segment_ty *prev, size_t capacity)
+{
+	segment_ty *segment = (segment_ty *)malloc(sizeof(segment_ty) + capacity * SIZE_PTR);
+
+	if (NULL == segment)
+	{
+		return NULL;
+	}
+
+	segment->prev = prev;
+	segment->capacity = capacity;
+
+	return segment;
+}
+
+/* Points start and end at segment's elements, top is left to the caller */
+static void EnterSegment(stack_ty *stack, segment_ty *segment)
+{
+	stack->start = SEGMENT_ELEMENTS(segment);
+	stack->end = stack->start + segment->capacity;
+	stack->committed = stack->end;
+}
+
+/* A full segment continues in a new one twice its size, no element moves */
+static int NextSegment(stack_ty *stack)
+{
+	segment_ty *next = stack->spare;
+
+	if (NULL == next)
+	{
+		next = CreateSegment(stack->segment, 2 * stack->segment->capacity);
+
+		if (NULL == next)
+		{
+			return ALLOC_ERR;
+		}
+	}
+
+	stack->spare = NULL;
+	next->prev = stack->segment;
+
+	stack->below += stack->segment->capacity;
+	stack->segment = next;
+	EnterSegment(stack, next);
+	stack->top = stack->start;
+
+	return SUCCESS;
+}
+
+/* Leaving an emptied segment, it becomes the spare so pushing right back
+	over the boundary does not allocate again. Keeping the empty segment is
+	also what keeps top > start in a non empty stack. */
+static void PrevSegment(stack_ty *stack)
+{
+	segment_ty *emptied = stack->segment;
+
+	free(stack->spare);
+	stack->spare = emptied;
+
+	stack->below -= emptied->prev->capacity;
+	stack->segment = emptied->prev;
+	EnterSegment(stack, stack->segment);
+	stack->top = stack->end;
 }
 
+/* Makes the next COMMIT_BYTES of the range writable, its pages are
+	allocated by the kernel when first touched */
+static int CommitPages(stack_ty *stack)
+{
+	if (stack->committed == stack->end ||
+	    0 != mprotect(stack->committed, COMMIT_BYTES, PROT_READ | PROT_WRITE))
+	{
+		return ALLOC_ERR;
+	}
 
+	stack->committed += COMMIT_BYTES / SIZE_PTR;
+
+	return SUCCESS;
+}
+
+/* Once top is two steps under committed, the pages above the step holding
+	top are given back and made inaccessible again. The step of slack stops
+	push / pop around a boundary from calling the kernel each time. */
+static void ReleasePages(stack_ty *stack)
+{
+	void **keep = NULL;
+	size_t release_bytes = 0;
+
+	if ((size_t)(stack->committed - stack->top) * SIZE_PTR < 2 * COMMIT_BYTES)
+	{
+		return;
+	}
+
+	keep = stack->start +
+	       (COMMIT_ROUND((stack->top - stack->start) * SIZE_PTR) + COMMIT_BYTES) / SIZE_PTR;
+	release_bytes = (stack->committed - keep) * SIZE_PTR;
+
+	madvise(keep, release_bytes, MADV_DONTNEED);
+
+	if (0 == mprotect(keep, release_bytes, PROT_NONE))
+	{
+		stack->committed = keep;
+	}
+}
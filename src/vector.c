@@ -8,10 +8,13 @@
 *	gc src/vector.c test/vector_test.c -I ./include/ -I ../
 *******************************************************************************/
 
+#define _GNU_SOURCE		/* mremap, MAP_ANONYMOUS */
+
 #include <stddef.h>  		/* size_t */
 #include <stdlib.h>		/* malloc, realloc */
-#include <string.h>		/* memset */
+#include <string.h>		/* memset, memcpy */
 #include <assert.h>		/* assert */
+#include <sys/mman.h>		/* mmap, mremap, munmap */
 
 #include <stdio.h>		/* printf */
 
@@ -21,29 +24,72 @@
 #define SIZEOF_STRUCT	SIZEOF_TYPE(vector_ty)
 #define GROW_FACTOR		2
 #define MIN_CAPACITY	1LU
+#define SHRINK_RATIO	4		/* PopBack shrinks when size <= capacity / 4 */
+
+#define PAGE_SIZE		4096LU
+#define PAGE_ROUND(bytes)	(((bytes) + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1))
+
+/* Buffers of this size and above are mapped, they grow and shrink with
+	mremap which moves pages instead of copying elements */
+#ifdef MREMAP_MAYMOVE
+#define MAP_THRESHOLD	(1LU << 20)
+#endif
 
 #define SUCCESS			0
 #define ALLOC_ERR 		1
 #define FUNC_FAILED 		2
 
+/* Inline slots of a small vector follow the struct, 16 bytes aligned */
+#define INLINE_OFFSET	((SIZEOF_STRUCT + 15) & ~15LU)
+#define INLINE_BUFFER(vector)	((char *)(vector) + INLINE_OFFSET)
+#define IS_INLINE(vector)	(0 != (vector)->inline_capacity && \
+							 (vector)->first == INLINE_BUFFER(vector))
+
+#define ELEMENT_AT(vector, index)	((vector)->first + (index) * (vector)->element_size)
+
 #define ASSERT_VECTOR_ALLOC	assert (0 != vector && "VECTOR is not allocated");
+#define ASSERT_POINTERS		assert (SIZE_PTR == vector->element_size && \
+							"Vector holds values, use the Value functions");
 
 struct vector
 {
-	void **curr_element;
-	void **first;
+	char *first;
+	size_t size;
 	size_t capacity;
+	size_t element_size;	/* SIZE_PTR for vectors of void* */
+	size_t min_capacity;	/* PopBack does not shrink below it */
+	size_t map_size;		/* mapped bytes, 0 when first is malloced */
+	size_t inline_capacity;	/* slots after the struct, 0 for a regular vector */
+	vector_growth_ty growth;
+	size_t increment;		/* VECTOR_GROW_FIXED step */
 };
 
 static int GrowVectorCapacity(vector_ty *vector, size_t new_capacity);
 static int ShrinkVectorCapacity(vector_ty *vector, size_t new_capacity);
+static int ResizeBuffer(vector_ty *vector, size_t new_capacity);
+static void FreeBuffer(vector_ty *vector);
+static size_t NextCapacity(const vector_ty *vector);
+static void AutoShrink(vector_ty *vector);
+static int EnsureRoom(vector_ty *vector, size_t n);
 
 
 /*******************************************************************************
 ****************************** VectorCreate ***********************************/
 vector_ty *VectorCreate(size_t capacity, const size_t size)
 { 
-	vector_ty *vector = (vector_ty *)malloc(SIZEOF_STRUCT);
+	return VectorCreateTyped(SIZE_PTR, capacity, size);
+}
+
+
+/*******************************************************************************
+*************************** VectorCreateTyped *********************************/
+vector_ty *VectorCreateTyped(size_t element_size, size_t capacity, const size_t size)
+{ 
+	vector_ty *vector = NULL;
+	
+	assert (0 != element_size && "Element size cannot be zero");
+	
+	vector = (vector_ty *)malloc(SIZEOF_STRUCT);
 	
 	if (NULL == vector)
 	{
@@ -56,7 +102,7 @@ vector_ty *VectorCreate(size_t capacity, const size_t size)
 		capacity = (0 != size) ? size : MIN_CAPACITY; 
 	}
 	
-	vector->first = (void **)malloc(capacity * SIZE_PTR);
+	vector->first = (char *)malloc(capacity * element_size);
 	
 	if (NULL == vector->first)
 	{
@@ -65,23 +111,82 @@ vector_ty *VectorCreate(size_t capacity, const size_t size)
 	}
 	
 	/* Initi elements in size_array to zero value */
-	memset(vector->first, 0, (size * SIZE_PTR));
+	memset(vector->first, 0, size * element_size);
 
-	vector->curr_element = vector->first + size;
+	vector->size = size;
 	vector->capacity = capacity;
+	vector->element_size = element_size;
+	vector->min_capacity = capacity;
+	vector->map_size = 0;
+	vector->inline_capacity = 0;
+	vector->growth = VECTOR_GROW_DOUBLE;
+	vector->increment = 0;
 	
 	return vector;
 }
 
+
+/*******************************************************************************
+****************************** VectorCreateSmall ******************************/
+vector_ty *VectorCreateSmall(size_t inline_capacity)
+{ 
+	return VectorCreateSmallTyped(SIZE_PTR, inline_capacity);
+}
+
+
+/*******************************************************************************
+*************************** VectorCreateSmallTyped ****************************/
+vector_ty *VectorCreateSmallTyped(size_t element_size, size_t inline_capacity)
+{ 
+	vector_ty *vector = NULL;
+	
+	assert (0 != element_size && "Element size cannot be zero");
+	assert (0 != inline_capacity && "Inline capacity cannot be zero");
+	
+	/* One allocation holds the struct and the inline slots */
+	vector = (vector_ty *)malloc(INLINE_OFFSET + inline_capacity * element_size);
+	
+	if (NULL == vector)
+	{
+		return NULL;
+	}
+	
+	vector->first = INLINE_BUFFER(vector);
+	vector->size = 0;
+	vector->capacity = inline_capacity;
+	vector->element_size = element_size;
+	vector->min_capacity = inline_capacity;
+	vector->map_size = 0;
+	vector->inline_capacity = inline_capacity;
+	vector->growth = VECTOR_GROW_DOUBLE;
+	vector->increment = 0;
+	
+	return vector;
+}
+
+
+/*******************************************************************************
+***************************** VectorSetGrowth *********************************/
+void VectorSetGrowth(vector_ty *vector, vector_growth_ty growth, size_t increment)
+{
+	ASSERT_VECTOR_ALLOC;
+	assert ((VECTOR_GROW_FIXED != growth || 0 != increment) 
+			&& "Fixed growth needs a non zero increment");
+	
+	vector->growth = growth;
+	vector->increment = increment;
+}
+
 /*******************************************************************************
 ******************************* VectorSet *************************************/
 /* Changes an element value at a given index */
 void VectorSet(vector_ty *vector, void *value, size_t index)
 {
 	ASSERT_VECTOR_ALLOC;
+	ASSERT_POINTERS;
 	assert (index < vector->capacity && "Index is out of vector capacity range");
 	
-	*(vector->first + index) = value;
+	((void **)vector->first)[index] = value;
 }
 
 
@@ -90,9 +195,43 @@ void VectorSet(vector_ty *vector, void *value, size_t index)
 void *VectorGet(const vector_ty *vector, size_t index)
 {
 	ASSERT_VECTOR_ALLOC;
+	ASSERT_POINTERS;
 	assert (index < VectorSize(vector) && "Index must be in size value range");
 	
-	return vector->first[index];
+	return ((void **)vector->first)[index];
+}
+
+
+/*******************************************************************************
+**************************** VectorSetValue ***********************************/
+void VectorSetValue(vector_ty *vector, size_t index, const void *value)
+{
+	ASSERT_VECTOR_ALLOC;
+	assert (index < vector->capacity && "Index is out of vector capacity range");
+	
+	memcpy(ELEMENT_AT(vector, index), value, vector->element_size);
+}
+
+
+/*******************************************************************************
+**************************** VectorGetValue ***********************************/
+void VectorGetValue(const vector_ty *vector, size_t index, void *value)
+{
+	ASSERT_VECTOR_ALLOC;
+	assert (index < vector->size && "Index must be in size value range");
+	
+	memcpy(value, ELEMENT_AT(vector, index), vector->element_size);
+}
+
+
+/*******************************************************************************
+******************************* VectorAt **************************************/
+void *VectorAt(const vector_ty *vector, size_t index)
+{
+	ASSERT_VECTOR_ALLOC;
+	assert (index < vector->size && "Index must be in size value range");
+	
+	return ELEMENT_AT(vector, index);
 }
 
 
@@ -112,13 +251,34 @@ size_t VectorSize(const vector_ty *vector)
 {
 	ASSERT_VECTOR_ALLOC;
 	
-	return vector->curr_element - vector->first;
+	return vector->size;
+}
+
+
+/*******************************************************************************
+************************** VectorElementSize **********************************/
+size_t VectorElementSize(const vector_ty *vector)
+{
+	ASSERT_VECTOR_ALLOC;
+	
+	return vector->element_size;
 }
 
 
 /*******************************************************************************
 ***************************** VectorGetArray **********************************/
 void **VectorGetArray(const vector_ty *vector)
+{
+	ASSERT_VECTOR_ALLOC;
+	ASSERT_POINTERS;
+	
+	return (void **)vector->first;
+}
+
+
+/*******************************************************************************
+******************************* VectorData ************************************/
+void *VectorData(const vector_ty *vector)
 {
 	ASSERT_VECTOR_ALLOC;
 	
@@ -130,14 +290,12 @@ void **VectorGetArray(const vector_ty *vector)
 ****************************** VectorShrink ***********************************/
 int VectorShrink(vector_ty *vector)
 {
-	size_t new_size = vector->curr_element - vector->first;
 	int err = SUCCESS;
 	
 	ASSERT_VECTOR_ALLOC;
-	assert (vector->curr_element != vector->first &&
-	"Vector cannot be shrinked when size equals zero");
 	
-	err = ShrinkVectorCapacity(vector, new_size);
+	err = ShrinkVectorCapacity(vector, 
+	                           (0 != vector->size) ? vector->size : MIN_CAPACITY);
 
 	return err;
 }
@@ -147,32 +305,30 @@ int VectorShrink(vector_ty *vector)
 **************************** VectorResize *************************************/
 int VectorResize(vector_ty *vector, size_t new_size)
 {
-	void **new_size_ptr = vector->first + new_size;	
-	void **org_capacity_ptr = vector->first + vector->capacity;	
 	int err = SUCCESS;
 	
 	ASSERT_VECTOR_ALLOC;
 	
-	/*	new_size < size */
-	if (new_size_ptr < vector->curr_element)
-	{
-		vector->curr_element = new_size_ptr;
-	}
-	/*	(new_size > size) && (size < capacity) */
-	else if (new_size_ptr < org_capacity_ptr)
+	/* new_size > capacity */
+	if (new_size > vector->capacity)
 	{
-		/*	null add pointer*/
-		memset(vector->curr_element, 0, (new_size_ptr - vector->curr_element) * SIZE_PTR - 1); 
+		err = GrowVectorCapacity(vector, new_size);
 		
-		vector->curr_element = new_size_ptr;
+		if (SUCCESS != err)
+		{
+			return err;
+		}
 	}
 	
-	/* new_size > capacity */
-	if (new_size_ptr > org_capacity_ptr)
+	/*	new_size > size, zero the added elements (NULL pointers) */
+	if (new_size > vector->size)
 	{
-		err = VectorReserve(vector, new_size);
+		memset(ELEMENT_AT(vector, vector->size), 0, 
+		       (new_size - vector->size) * vector->element_size); 
 	}
 	
+	vector->size = new_size;
+	
 	return err;
 }
 
@@ -195,15 +351,26 @@ int VectorReserve(vector_ty *vector, size_t new_capacity)
 /*******************************************************************************
 ***************************** VectorPushBack **********************************/
 int VectorPushBack(vector_ty *vector, void *element)
+{
+	ASSERT_VECTOR_ALLOC;
+	ASSERT_POINTERS;
+	
+	return VectorPushBackValue(vector, &element);
+}
+
+
+/*******************************************************************************
+************************** VectorPushBackValue ********************************/
+int VectorPushBackValue(vector_ty *vector, const void *value)
 {
 	int err = SUCCESS;
 	
 	ASSERT_VECTOR_ALLOC;
 	
 	/* Enlarge the capacity of vector when vector is full */
-	if (vector->curr_element == (vector->first + vector->capacity))
+	if (vector->size == vector->capacity)
 	{
-		err = GrowVectorCapacity(vector, GROW_FACTOR * vector->capacity);
+		err = GrowVectorCapacity(vector, NextCapacity(vector));
 
 		if (0 != err)
 		{
@@ -211,8 +378,8 @@ int VectorPushBack(vector_ty *vector, void *element)
 		}
 	}
 	
-	*(vector->curr_element) = element;
-	++vector->curr_element;
+	memcpy(ELEMENT_AT(vector, vector->size), value, vector->element_size);
+	++vector->size;
 	
 	return err;
 }
@@ -220,25 +387,158 @@ int VectorPushBack(vector_ty *vector, void *element)
 /*******************************************************************************
 ***************************** VectorPopBack ***********************************/
 void *VectorPopBack(vector_ty *vector)
+{
+	void *element = NULL;
+	
+	ASSERT_VECTOR_ALLOC;
+	ASSERT_POINTERS;
+	assert (0 != vector->size && "First element cannot be popped");
+	
+	--vector->size;
+	element = ((void **)vector->first)[vector->size];
+	
+	AutoShrink(vector);
+
+	return element;
+}
+
+/*******************************************************************************
+************************** VectorPopBackValue *********************************/
+void VectorPopBackValue(vector_ty *vector, void *value)
 {
 	ASSERT_VECTOR_ALLOC;
-	assert (vector->curr_element != vector->first && "First element cannot be popped");
+	assert (0 != vector->size && "First element cannot be popped");
 	
-	--vector->curr_element;
+	--vector->size;
 
-	return (vector->curr_element);
+	if (NULL != value)
+	{
+		memcpy(value, ELEMENT_AT(vector, vector->size), vector->element_size);
+	}
+	
+	AutoShrink(vector);
 }
 
+/*******************************************************************************
+**************************** VectorPushBackN **********************************/
+int VectorPushBackN(vector_ty *vector, const void *src, size_t n)
+{
+	int err = SUCCESS;
+	
+	ASSERT_VECTOR_ALLOC;
+	assert ((NULL != src || 0 == n) && "Source is not valid");
+	
+	if (0 == n)
+	{
+		return SUCCESS;
+	}
+	
+	err = EnsureRoom(vector, n);
+	
+	if (SUCCESS != err)
+	{
+		return err;
+	}
+	
+	memcpy(ELEMENT_AT(vector, vector->size), src, n * vector->element_size);
+	vector->size += n;
+	
+	return err;
+}
+
+
+/*******************************************************************************
+***************************** VectorAppend ************************************/
+int VectorAppend(vector_ty *dest, const vector_ty *src)
+{
+	size_t n = 0;
+	int err = SUCCESS;
+	
+	assert (NULL != dest && NULL != src && "VECTOR is not allocated");
+	assert (dest->element_size == src->element_size && 
+			"Vectors must hold elements of the same size");
+	
+	n = src->size;
+	err = EnsureRoom(dest, n);
+	
+	if (SUCCESS != err)
+	{
+		return err;
+	}
+	
+	/* src->first is read after the growth, dest may be src */
+	memcpy(ELEMENT_AT(dest, dest->size), src->first, n * dest->element_size);
+	dest->size += n;
+	
+	return err;
+}
+
+
+/*******************************************************************************
+*************************** VectorInsertRange *********************************/
+int VectorInsertRange(vector_ty *vector, size_t at, const void *src, size_t n)
+{
+	int err = SUCCESS;
+	
+	ASSERT_VECTOR_ALLOC;
+	assert (at <= vector->size && "Index must be in size value range");
+	assert ((NULL != src || 0 == n) && "Source is not valid");
+	
+	if (0 == n)
+	{
+		return SUCCESS;
+	}
+	
+	err = EnsureRoom(vector, n);
+	
+	if (SUCCESS != err)
+	{
+		return err;
+	}
+	
+	memmove(ELEMENT_AT(vector, at + n), ELEMENT_AT(vector, at), 
+	        (vector->size - at) * vector->element_size);
+	memcpy(ELEMENT_AT(vector, at), src, n * vector->element_size);
+	vector->size += n;
+	
+	return err;
+}
+
+
+/*******************************************************************************
+**************************** VectorEraseRange *********************************/
+void VectorEraseRange(vector_ty *vector, size_t from, size_t to)
+{
+	ASSERT_VECTOR_ALLOC;
+	assert (from <= to && to <= vector->size && "Range is out of size range");
+	
+	memmove(ELEMENT_AT(vector, from), ELEMENT_AT(vector, to), 
+	        (vector->size - to) * vector->element_size);
+	vector->size -= to - from;
+	
+	AutoShrink(vector);
+}
+
+
+/*******************************************************************************
+**************************** VectorAvailable **********************************/
+size_t VectorAvailable(const vector_ty *vector)
+{
+	ASSERT_VECTOR_ALLOC;
+	
+	return vector->capacity - vector->size;
+}
+
+
 /*******************************************************************************
 ****************************** VectorDestroy **********************************/
 void VectorDestroy(vector_ty *vector)
 {
 	ASSERT_VECTOR_ALLOC;
 
-	free(vector->first);
+	FreeBuffer(vector);
 	DEBUG_MODE(
-	vector->first = DEAD_MEM(void *);
-	vector->curr_element = DEAD_MEM(void *);
+	vector->first = DEAD_MEM(char *);
 	);
 
 	free(vector);
@@ -252,9 +552,106 @@ void VectorDestroy(vector_ty *vector)
 *************************** Side Functions ************************************/
 static int GrowVectorCapacity(vector_ty *vector, size_t new_capacity)
 {
-	size_t curr_vector_size = vector->curr_element - vector->first;
-	size_t new_capacity_bytes = new_capacity * SIZE_PTR;
-	void **tmp_buffer = (void **)realloc(vector->first , new_capacity_bytes);
+	return ResizeBuffer(vector, new_capacity);
+}
+
+
+static int ShrinkVectorCapacity(vector_ty *vector, size_t new_capacity)
+{
+	assert (new_capacity >= vector->size);
+	
+	if (new_capacity >= vector->capacity)
+	{
+		return SUCCESS;
+	}
+	
+	return ResizeBuffer(vector, new_capacity);
+}
+
+
+/* Moves the elements into a buffer of new_capacity elements, 
+	new_capacity >= size. Small buffers are malloced and realloced, 
+	big ones are mapped and remapped. Mapped capacity is rounded up 
+	to whole pages. A small vector moves back to its inline slots 
+	when they are enough. */
+static int ResizeBuffer(vector_ty *vector, size_t new_capacity)
+{
+	size_t new_capacity_bytes = new_capacity * vector->element_size;
+	size_t size_bytes = vector->size * vector->element_size;
+	char *tmp_buffer = NULL;
+	
+	if (new_capacity <= vector->inline_capacity)
+	{
+		if (!IS_INLINE(vector))
+		{
+			memcpy(INLINE_BUFFER(vector), vector->first, size_bytes);
+			FreeBuffer(vector);
+			
+			vector->first = INLINE_BUFFER(vector);
+			vector->map_size = 0;
+		}
+		
+		vector->capacity = vector->inline_capacity;
+		
+		return SUCCESS;
+	}
+	
+#ifdef MAP_THRESHOLD
+	if (new_capacity_bytes >= MAP_THRESHOLD)
+	{
+		size_t map_size = PAGE_ROUND(new_capacity_bytes);
+		
+		if (0 != vector->map_size)
+		{
+			tmp_buffer = (char *)mremap(vector->first, vector->map_size, 
+			                            map_size, MREMAP_MAYMOVE);
+		}
+		else
+		{
+			tmp_buffer = (char *)mmap(NULL, map_size, PROT_READ | PROT_WRITE, 
+			                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			
+			if (MAP_FAILED != tmp_buffer)
+			{
+				memcpy(tmp_buffer, vector->first, size_bytes);
+				FreeBuffer(vector);
+			}
+		}
+		
+		if (MAP_FAILED == tmp_buffer)
+		{
+			return ALLOC_ERR;
+		}
+		
+		vector->first = tmp_buffer;
+		vector->map_size = map_size;
+		vector->capacity = map_size / vector->element_size;
+		
+		return SUCCESS;
+	}
+#endif
+	
+	if (0 != vector->map_size || IS_INLINE(vector))
+	{
+		tmp_buffer = (char *)malloc(new_capacity_bytes);
+		
+		if (NULL == tmp_buffer)
+		{
+			return ALLOC_ERR;
+		}
+		
+		memcpy(tmp_buffer, vector->first, size_bytes);
+		FreeBuffer(vector);
+		
+		vector->first = tmp_buffer;
+		vector->map_size = 0;
+		vector->capacity = new_capacity;
+		
+		return SUCCESS;
+	}
+	
+	/* realloc copies the elements when it cannot resize in place */
+	tmp_buffer = (char *)realloc(vector->first, new_capacity_bytes);
 	
 	if (NULL == tmp_buffer)
 	{
@@ -262,33 +659,94 @@ static int GrowVectorCapacity(vector_ty *vector, size_t new_capacity)
 	}
 	
 	vector->first = tmp_buffer;
-	vector->curr_element = vector->first + curr_vector_size;
 	vector->capacity = new_capacity;
 	
 	return SUCCESS;
 }
 
 
-static int ShrinkVectorCapacity(vector_ty *vector, size_t new_capacity)
+/* Releases the buffer, unless it is the inline slots */
+static void FreeBuffer(vector_ty *vector)
 {
-	size_t new_capacity_bytes = new_capacity * SIZE_PTR;
-	void **tmp_buffer = (void **)malloc(new_capacity_bytes);
+	if (IS_INLINE(vector))
+	{
+		return;
+	}
 	
-	if (NULL == tmp_buffer)
+#ifdef MAP_THRESHOLD
+	if (0 != vector->map_size)
 	{
-		return ALLOC_ERR;
+		munmap(vector->first, vector->map_size);
+		return;
 	}
+#endif
 	
-	vector->first = tmp_buffer;
-	vector->curr_element = vector->first + new_capacity;
-	vector->capacity = new_capacity;
+	free(vector->first);
+}
+
+
+static size_t NextCapacity(const vector_ty *vector)
+{
+	size_t capacity = vector->capacity;
 	
-	free(tmp_buffer);
-	DEBUG_MODE(
-	tmp_buffer = DEAD_MEM(void **);
-	); /* DEBUG_ONLY */ 
+	switch (vector->growth)
+	{
+		case VECTOR_GROW_HALF:
+			return capacity + capacity / 2 + 1;
+		
+		case VECTOR_GROW_FIXED:
+			return capacity + vector->increment;
+		
+		case VECTOR_GROW_PAGE:
+			return PAGE_ROUND(GROW_FACTOR * capacity * vector->element_size) 
+			       / vector->element_size;
+		
+		default:
+			return GROW_FACTOR * capacity;
+	}
+}
 
-	return SUCCESS;
+
+/* Grows at most once so n more elements fit. The growth policy step is
+	taken when it is enough, so repeated bulk pushes stay amortized O(1) 
+	per element. */
+static int EnsureRoom(vector_ty *vector, size_t n)
+{
+	size_t needed = vector->size + n;
+	size_t new_capacity = 0;
+	
+	if (needed <= vector->capacity)
+	{
+		return SUCCESS;
+	}
+	
+	new_capacity = NextCapacity(vector);
+	
+	return GrowVectorCapacity(vector, 
+	                          (new_capacity > needed) ? new_capacity : needed);
+}
+
+
+/* Halves the capacity once size drops to a quarter of it. Between the
+	grow point (full) and the shrink point there is always a factor of 2 
+	either way, so alternating Push / Pop never reallocates each time. */
+static void AutoShrink(vector_ty *vector)
+{
+	size_t new_capacity = vector->capacity / 2;
+	
+	if (vector->capacity <= vector->min_capacity || 
+	    vector->size > vector->capacity / SHRINK_RATIO)
+	{
+		return;
+	}
+	
+	if (new_capacity < vector->min_capacity)
+	{
+		new_capacity = vector->min_capacity;
+	}
+	
+	/* A failed shrink leaves the vector as it was */
+	ShrinkVectorCapacity(vector, new_capacity);
 }
 
 
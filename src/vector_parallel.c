@@ -0,0 +1,530 @@
+/*******************************************************************************
+**************************** - PARALLEL VECTOR - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a multi-threaded merge sort and
+*					for-each over a vector
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/vector_parallel.c src/vector.c
+*					test/vector_parallel_test.c -I ./include -pthread
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* pthread_barrier_t, sysconf */
+
+#include <stdlib.h>			/* malloc, free */
+#include <string.h>			/* memcpy */
+#include <assert.h>			/* assert */
+#include <pthread.h>		/* pthread_create, pthread_join, pthread_barrier_t */
+#include <unistd.h>			/* sysconf */
+
+#include "utilities.h"
+#include "vector_parallel.h"
+
+#define MAX_THREADS			256LU
+#define MIN_SORT_RUN		8192LU	/* Fewer elements are not worth a thread */
+#define MIN_EACH_CHUNK		4096LU
+#define INSERTION_RUN		16LU	/* Runs sorted by insertion before merging */
+
+#define MIN(a, b)		((a) < (b) ? (a) : (b))
+
+/* Start of run i out of n_runs_ over size_ elements */
+#define RUN_START(i, n_runs_, size_)	((size_) * (i) / (n_runs_))
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "VECTOR is not allocated");
+
+typedef struct sorter
+{
+	char *m_base;				/* The vector buffer */
+	char *m_buffer;				/* Temporary buffer of the same size */
+	size_t m_size;
+	size_t m_element_size;
+	vector_cmp_ty m_cmp;
+	const void *m_param;
+	int m_by_value;				/* cmp gets addresses rather than pointers */
+	size_t m_n_threads;			/* Final only once the gate is open */
+	pthread_barrier_t m_barrier;
+	pthread_mutex_t m_gate_lock;
+	pthread_cond_t m_gate;
+	int m_gate_open;
+} sorter_ty;
+
+typedef struct sort_worker
+{
+	sorter_ty *m_sorter;
+	size_t m_id;
+} sort_worker_ty;
+
+typedef struct each_worker
+{
+	char *m_first;
+	size_t m_count;
+	size_t m_element_size;
+	vector_action_ty m_action;
+	void *m_param;
+	int m_status;
+} each_worker_ty;
+
+
+static int SortIMP(vector_ty *vector_, vector_cmp_ty cmp_, const void *param_,
+                   size_t n_threads_, int by_value_);
+static void *SortThreadIMP(void *param_);
+static void SortWorkIMP(sorter_ty *sorter_, size_t id_);
+static void SortRunIMP(sorter_ty *sorter_, size_t from_, size_t to_);
+static void MergeSliceIMP(sorter_ty *sorter_, const char *src_, char *dest_,
+                          size_t a_from_, size_t a_to_, size_t b_to_,
+                          size_t out_from_, size_t out_to_);
+static size_t CoRankIMP(sorter_ty *sorter_, size_t k_, const char *a_, size_t a_len_,
+                        const char *b_, size_t b_len_);
+static int CompareIMP(const sorter_ty *sorter_, const void *a_, const void *b_);
+static void CopyIMP(void *dest_, const void *src_, size_t element_size_);
+static void SwapIMP(char *a_, char *b_, size_t element_size_);
+static void *EachThreadIMP(void *param_);
+static size_t ThreadsIMP(size_t n_threads_, size_t size_, size_t min_per_thread_);
+
+
+/*******************************************************************************
+***************************** VectorParallelSort ******************************/
+int VectorParallelSort(vector_ty *vector_, vector_cmp_ty cmp_, const void *param_,
+                       size_t n_threads_)
+{
+	ASSERT_IS_ALLOC(vector_);
+	assert (sizeof(void *) == VectorElementSize(vector_) &&
+	        "VectorParallelSort is for void* vectors");
+
+	return SortIMP(vector_, cmp_, param_, n_threads_, 0);
+}
+
+
+/*******************************************************************************
+************************** VectorParallelSortValues ***************************/
+int VectorParallelSortValues(vector_ty *vector_, vector_cmp_ty cmp_, const void *param_,
+                             size_t n_threads_)
+{
+	ASSERT_IS_ALLOC(vector_);
+
+	return SortIMP(vector_, cmp_, param_, n_threads_, 1);
+}
+
+
+/*******************************************************************************
+*************************** VectorParallelForEach *****************************/
+int VectorParallelForEach(vector_ty *vector_, vector_action_ty action_, void *param_,
+                          size_t n_threads_)
+{
+	pthread_t threads[MAX_THREADS];
+	each_worker_ty workers[MAX_THREADS];
+	int created[MAX_THREADS];
+	size_t size = 0;
+	size_t element_size = 0;
+	size_t from = 0;
+	size_t to = 0;
+	size_t i = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(vector_);
+	assert (NULL != action_);
+
+	size = VectorSize(vector_);
+	element_size = VectorElementSize(vector_);
+	n_threads_ = ThreadsIMP(n_threads_, size, MIN_EACH_CHUNK);
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		from = RUN_START(i, n_threads_, size);
+		to = RUN_START(i + 1, n_threads_, size);
+
+		workers[i].m_first = (char *)VectorData(vector_) + from * element_size;
+		workers[i].m_count = to - from;
+		workers[i].m_element_size = element_size;
+		workers[i].m_action = action_;
+		workers[i].m_param = param_;
+		workers[i].m_status = SUCCESS;
+		created[i] = 0;
+	}
+
+	/* Chunk 0 is the calling thread's, a chunk without a thread is run here too */
+	for (i = 1; i < n_threads_; ++i)
+	{
+		created[i] = (0 == pthread_create(&threads[i], NULL, EachThreadIMP, &workers[i]));
+
+		if (!created[i])
+		{
+			EachThreadIMP(&workers[i]);
+		}
+	}
+
+	EachThreadIMP(&workers[0]);
+
+	for (i = 0; i < n_threads_; ++i)
+	{
+		if (created[i])
+		{
+			pthread_join(threads[i], NULL);
+		}
+
+		if (SUCCESS == status)
+		{
+			status = workers[i].m_status;
+		}
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+/* Threads are created first and wait at a gate; once it is known how many
+	were created, the barrier is sized and the gate is opened. */
+static int SortIMP(vector_ty *vector_, vector_cmp_ty cmp_, const void *param_,
+                   size_t n_threads_, int by_value_)
+{
+	pthread_t threads[MAX_THREADS];
+	sort_worker_ty workers[MAX_THREADS];
+	sorter_ty sorter;
+	size_t n_created = 0;
+	size_t i = 0;
+
+	assert (NULL != cmp_);
+
+	sorter.m_size = VectorSize(vector_);
+	sorter.m_element_size = VectorElementSize(vector_);
+
+	if (2 > sorter.m_size)
+	{
+		return SUCCESS;
+	}
+
+	sorter.m_buffer = (char *)malloc(sorter.m_size * sorter.m_element_size);
+	RETURN_IF_BAD(sorter.m_buffer, "VectorParallelSort: Allocation Error", ALLOC_ERR);
+
+	sorter.m_base = (char *)VectorData(vector_);
+	sorter.m_cmp = cmp_;
+	sorter.m_param = param_;
+	sorter.m_by_value = by_value_;
+	sorter.m_gate_open = 0;
+	pthread_mutex_init(&sorter.m_gate_lock, NULL);
+	pthread_cond_init(&sorter.m_gate, NULL);
+
+	n_threads_ = ThreadsIMP(n_threads_, sorter.m_size, MIN_SORT_RUN);
+
+	for (i = 1; i < n_threads_; ++i)
+	{
+		workers[i].m_sorter = &sorter;
+		workers[i].m_id = i;
+
+		if (0 != pthread_create(&threads[i], NULL, SortThreadIMP, &workers[i]))
+		{
+			break;
+		}
+	}
+
+	n_created = i - 1;
+
+	pthread_mutex_lock(&sorter.m_gate_lock);
+	sorter.m_n_threads = n_created + 1;
+	pthread_barrier_init(&sorter.m_barrier, NULL, (unsigned)sorter.m_n_threads);
+	sorter.m_gate_open = 1;
+	pthread_cond_broadcast(&sorter.m_gate);
+	pthread_mutex_unlock(&sorter.m_gate_lock);
+
+	SortWorkIMP(&sorter, 0);
+
+	for (i = 1; i <= n_created; ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	pthread_barrier_destroy(&sorter.m_barrier);
+	pthread_cond_destroy(&sorter.m_gate);
+	pthread_mutex_destroy(&sorter.m_gate_lock);
+	free(sorter.m_buffer);
+	sorter.m_buffer = DEAD_MEM(char *);
+
+	return SUCCESS;
+}
+
+
+static void *SortThreadIMP(void *param_)
+{
+	sort_worker_ty *worker = (sort_worker_ty *)param_;
+	sorter_ty *sorter = worker->m_sorter;
+
+	pthread_mutex_lock(&sorter->m_gate_lock);
+
+	while (!sorter->m_gate_open)
+	{
+		pthread_cond_wait(&sorter->m_gate, &sorter->m_gate_lock);
+	}
+
+	pthread_mutex_unlock(&sorter->m_gate_lock);
+
+	SortWorkIMP(sorter, worker->m_id);
+
+	return NULL;
+}
+
+
+/* Thread id_ sorts run id_, then takes part in every merge round.
+	Round r merges pairs of runs made of 2^r initial runs each, the threads
+	are split evenly between the pairs and each merges one slice of its
+	pair's output. The rounds move the data between base and buffer. */
+static void SortWorkIMP(sorter_ty *sorter_, size_t id_)
+{
+	size_t n_threads = sorter_->m_n_threads;
+	size_t size = sorter_->m_size;
+	size_t from = RUN_START(id_, n_threads, size);
+	size_t to = RUN_START(id_ + 1, n_threads, size);
+	char *src = sorter_->m_base;
+	char *dest = sorter_->m_buffer;
+	char *tmp = NULL;
+	size_t runs = n_threads;
+	size_t step = 1;
+	size_t pairs = 0;
+	size_t per_pair = 0;
+	size_t pair = 0;
+	size_t slice = 0;
+	size_t a_from = 0;
+	size_t a_to = 0;
+	size_t b_to = 0;
+
+	SortRunIMP(sorter_, from, to);
+
+	while (1 < runs)
+	{
+		pthread_barrier_wait(&sorter_->m_barrier);
+
+		pairs = (runs + 1) / 2;
+		per_pair = n_threads / pairs;
+
+		if (id_ < pairs * per_pair)
+		{
+			pair = id_ / per_pair;
+			slice = id_ % per_pair;
+
+			a_from = RUN_START(MIN(2 * pair * step, n_threads), n_threads, size);
+			a_to = RUN_START(MIN((2 * pair + 1) * step, n_threads), n_threads, size);
+			b_to = RUN_START(MIN((2 * pair + 2) * step, n_threads), n_threads, size);
+
+			MergeSliceIMP(sorter_, src, dest, a_from, a_to, b_to,
+			              RUN_START(slice, per_pair, b_to - a_from),
+			              RUN_START(slice + 1, per_pair, b_to - a_from));
+		}
+
+		tmp = src;
+		src = dest;
+		dest = tmp;
+		runs = pairs;
+		step *= 2;
+	}
+
+	/* Every thread copies back its own run once all the merges are done */
+	if (src != sorter_->m_base)
+	{
+		pthread_barrier_wait(&sorter_->m_barrier);
+		memcpy(sorter_->m_base + from * sorter_->m_element_size,
+		       src + from * sorter_->m_element_size,
+		       (to - from) * sorter_->m_element_size);
+	}
+}
+
+
+/* Bottom-up merge sort of [from_, to_), the result is left in base */
+static void SortRunIMP(sorter_ty *sorter_, size_t from_, size_t to_)
+{
+	size_t element_size = sorter_->m_element_size;
+	char *src = sorter_->m_base;
+	char *dest = sorter_->m_buffer;
+	char *tmp = NULL;
+	size_t width = INSERTION_RUN;
+	size_t start = 0;
+	size_t i = 0;
+	size_t j = 0;
+
+	for (start = from_; start < to_; start += INSERTION_RUN)
+	{
+		for (i = start + 1; i < MIN(start + INSERTION_RUN, to_); ++i)
+		{
+			for (j = i; j > start &&
+			     0 < CompareIMP(sorter_, src + (j - 1) * element_size,
+			                    src + j * element_size); --j)
+			{
+				SwapIMP(src + (j - 1) * element_size, src + j * element_size,
+				        element_size);
+			}
+		}
+	}
+
+	for (; width < to_ - from_; width *= 2)
+	{
+		for (start = from_; start < to_; start += 2 * width)
+		{
+			MergeSliceIMP(sorter_, src, dest, start, MIN(start + width, to_),
+			              MIN(start + 2 * width, to_),
+			              0, MIN(start + 2 * width, to_) - start);
+		}
+
+		tmp = src;
+		src = dest;
+		dest = tmp;
+	}
+
+	if (src != sorter_->m_base)
+	{
+		memcpy(sorter_->m_base + from_ * element_size, src + from_ * element_size,
+		       (to_ - from_) * element_size);
+	}
+}
+
+
+/* Writes positions [out_from_, out_to_) of the merge of the sorted runs
+	[a_from_, a_to_) and [a_to_, b_to_) of src_, into the same positions of
+	dest_. Positions are relative to a_from_. Ties are taken from run a. */
+static void MergeSliceIMP(sorter_ty *sorter_, const char *src_, char *dest_,
+                          size_t a_from_, size_t a_to_, size_t b_to_,
+                          size_t out_from_, size_t out_to_)
+{
+	size_t element_size = sorter_->m_element_size;
+	const char *a = src_ + a_from_ * element_size;
+	const char *b = src_ + a_to_ * element_size;
+	size_t a_len = a_to_ - a_from_;
+	size_t b_len = b_to_ - a_to_;
+	char *out = dest_ + (a_from_ + out_from_) * element_size;
+	size_t i = CoRankIMP(sorter_, out_from_, a, a_len, b, b_len);
+	size_t j = out_from_ - i;
+	size_t i_end = CoRankIMP(sorter_, out_to_, a, a_len, b, b_len);
+	size_t j_end = out_to_ - i_end;
+
+	while (i < i_end && j < j_end)
+	{
+		if (0 > CompareIMP(sorter_, b + j * element_size, a + i * element_size))
+		{
+			CopyIMP(out, b + j * element_size, element_size);
+			++j;
+		}
+		else
+		{
+			CopyIMP(out, a + i * element_size, element_size);
+			++i;
+		}
+
+		out += element_size;
+	}
+
+	memcpy(out, a + i * element_size, (i_end - i) * element_size);
+	out += (i_end - i) * element_size;
+	memcpy(out, b + j * element_size, (j_end - j) * element_size);
+}
+
+
+/* Returns how many of the first k_ merged elements come from a_: the smallest
+	i for which a_[i] does not come before b_[k_ - i - 1] */
+static size_t CoRankIMP(sorter_ty *sorter_, size_t k_, const char *a_, size_t a_len_,
+                        const char *b_, size_t b_len_)
+{
+	size_t element_size = sorter_->m_element_size;
+	size_t low = (k_ > b_len_) ? k_ - b_len_ : 0;
+	size_t high = MIN(k_, a_len_);
+	size_t i = 0;
+
+	while (low < high)
+	{
+		i = low + (high - low) / 2;
+
+		if (0 <= CompareIMP(sorter_, b_ + (k_ - i - 1) * element_size,
+		                    a_ + i * element_size))
+		{
+			low = i + 1;
+		}
+		else
+		{
+			high = i;
+		}
+	}
+
+	return low;
+}
+
+
+static int CompareIMP(const sorter_ty *sorter_, const void *a_, const void *b_)
+{
+	if (sorter_->m_by_value)
+	{
+		return sorter_->m_cmp(a_, b_, sorter_->m_param);
+	}
+
+	return sorter_->m_cmp(*(void *const *)a_, *(void *const *)b_, sorter_->m_param);
+}
+
+
+static void CopyIMP(void *dest_, const void *src_, size_t element_size_)
+{
+	if (sizeof(void *) == element_size_)
+	{
+		*(void **)dest_ = *(void *const *)src_;
+	}
+	else
+	{
+		memcpy(dest_, src_, element_size_);
+	}
+}
+
+
+static void SwapIMP(char *a_, char *b_, size_t element_size_)
+{
+	void *tmp_ptr = NULL;
+	char tmp = 0;
+
+	if (sizeof(void *) == element_size_)
+	{
+		tmp_ptr = *(void **)a_;
+		*(void **)a_ = *(void **)b_;
+		*(void **)b_ = tmp_ptr;
+
+		return;
+	}
+
+	while (0 < element_size_--)
+	{
+		tmp = *a_;
+		*a_++ = *b_;
+		*b_++ = tmp;
+	}
+}
+
+
+static void *EachThreadIMP(void *param_)
+{
+	each_worker_ty *worker = (each_worker_ty *)param_;
+	char *element = worker->m_first;
+	size_t i = 0;
+
+	for (i = 0; i < worker->m_count && SUCCESS == worker->m_status; ++i)
+	{
+		worker->m_status = worker->m_action(element, worker->m_param);
+		element += worker->m_element_size;
+	}
+
+	return NULL;
+}
+
+
+/* 0 means online processors; at most MAX_THREADS, at least min_per_thread_
+	elements per thread and at least one thread */
+static size_t ThreadsIMP(size_t n_threads_, size_t size_, size_t min_per_thread_)
+{
+	long online = 0;
+
+	if (0 == n_threads_)
+	{
+		online = sysconf(_SC_NPROCESSORS_ONLN);
+		n_threads_ = (0 < online) ? (size_t)online : 1;
+	}
+
+	n_threads_ = MIN(n_threads_, MAX_THREADS);
+	n_threads_ = MIN(n_threads_, size_ / min_per_thread_);
+
+	return (0 == n_threads_) ? 1 : n_threads_;
+}
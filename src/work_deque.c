@@ -0,0 +1,273 @@
+/*******************************************************************************
+***************************** - WORK DEQUE - **********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Implementation of a Chase-Lev work-stealing deque over a
+*					growable circular array
+*	AUTHOR 			Liad Raz
+*	COMPILE			gc src/work_deque.c test/work_deque_test.c
+*					-I ./include -pthread
+*
+*******************************************************************************/
+
+#include <stdlib.h>			/* malloc, calloc, free */
+#include <assert.h>			/* assert */
+
+#include "utilities.h"
+#include "work_deque.h"
+
+#ifndef __GNUC__
+#error "work_deque requires the GCC / Clang __atomic builtins"
+#endif
+
+#define DEQUE_EMPTY				3
+#define DEQUE_LOST				4
+
+#define CACHE_LINE				64LU
+#define MIN_CAPACITY			2LU
+
+#define ASSERT_IS_ALLOC(ptr)									\
+		assert (NULL != (ptr) && "WORK DEQUE is not allocated");
+
+/* The slots follow the ring header */
+#define SLOTS(ring)				((void **)((ring) + 1))
+
+typedef struct ring
+{
+	struct ring *m_prev;		/* The array this one replaced */
+	size_t m_mask;
+} ring_ty;
+
+/* top and bottom only grow, bottom - top elements are in the deque.
+	Thieves move top, the owner moves bottom and swaps the ring */
+struct work_deque
+{
+	long m_top;
+	char m_pad0[CACHE_LINE - sizeof(long)];
+	long m_bottom;
+	ring_ty *m_ring;
+	char m_pad1[CACHE_LINE - sizeof(long) - sizeof(ring_ty *)];
+};
+
+
+static ring_ty *CreateRingIMP(size_t capacity_);
+static ring_ty *GrowIMP(work_deque_ty *th_, ring_ty *ring_, long top_, long bottom_);
+
+
+/*******************************************************************************
+****************************** WorkDequeCreate ********************************/
+work_deque_ty *WorkDequeCreate(size_t capacity_)
+{
+	work_deque_ty *deque = NULL;
+	size_t slots = MIN_CAPACITY;
+
+	/* calloc leaves top and bottom 0 */
+	deque = (work_deque_ty *)calloc(1, sizeof(work_deque_ty));
+	RETURN_IF_BAD(deque, "WorkDequeCreate: Allocation Error", NULL);
+
+	while (slots < capacity_)
+	{
+		slots <<= 1;
+	}
+
+	deque->m_ring = CreateRingIMP(slots);
+
+	if (NULL == deque->m_ring)
+	{
+		free(deque);
+		return NULL;
+	}
+
+	return deque;
+}
+
+
+/*******************************************************************************
+***************************** WorkDequeDestroy ********************************/
+void WorkDequeDestroy(work_deque_ty *deque_)
+{
+	ring_ty *ring = NULL;
+
+	ASSERT_IS_ALLOC(deque_);
+
+	while (NULL != deque_->m_ring)
+	{
+		ring = deque_->m_ring;
+		deque_->m_ring = ring->m_prev;
+		free(ring);
+	}
+
+	free(deque_);
+}
+
+
+/*******************************************************************************
+****************************** WorkDequePush **********************************/
+int WorkDequePush(work_deque_ty *deque_, void *element_)
+{
+	ring_ty *ring = NULL;
+	long bottom = 0;
+	long top = 0;
+
+	ASSERT_IS_ALLOC(deque_);
+
+	bottom = __atomic_load_n(&deque_->m_bottom, __ATOMIC_RELAXED);
+	top = __atomic_load_n(&deque_->m_top, __ATOMIC_ACQUIRE);
+	ring = deque_->m_ring;
+
+	if (bottom - top > (long)ring->m_mask)
+	{
+		ring = GrowIMP(deque_, ring, top, bottom);
+
+		if (NULL == ring)
+		{
+			return ALLOC_ERR;
+		}
+	}
+
+	__atomic_store_n(&SLOTS(ring)[bottom & ring->m_mask], element_, __ATOMIC_RELAXED);
+
+	/* Publishes the element to the thieves that acquire the new bottom */
+	__atomic_store_n(&deque_->m_bottom, bottom + 1, __ATOMIC_RELEASE);
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+****************************** WorkDequePop ***********************************/
+int WorkDequePop(work_deque_ty *deque_, void **element_)
+{
+	ring_ty *ring = NULL;
+	long bottom = 0;
+	long top = 0;
+	int status = SUCCESS;
+
+	ASSERT_IS_ALLOC(deque_);
+	assert (NULL != element_);
+
+	/* Reserves the bottom element before looking at top. The full fence
+		orders the two, the thieves do the same from their side */
+	bottom = __atomic_load_n(&deque_->m_bottom, __ATOMIC_RELAXED) - 1;
+	ring = deque_->m_ring;
+	__atomic_store_n(&deque_->m_bottom, bottom, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	top = __atomic_load_n(&deque_->m_top, __ATOMIC_RELAXED);
+
+	if (top > bottom)
+	{
+		__atomic_store_n(&deque_->m_bottom, bottom + 1, __ATOMIC_RELAXED);
+		return DEQUE_EMPTY;
+	}
+
+	*element_ = __atomic_load_n(&SLOTS(ring)[bottom & ring->m_mask], __ATOMIC_RELAXED);
+
+	/* The last element: thieves may want it too */
+	if (top == bottom)
+	{
+		if (!__atomic_compare_exchange_n(&deque_->m_top, &top, top + 1, 0,
+		                                 __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+		{
+			status = DEQUE_LOST;
+		}
+
+		__atomic_store_n(&deque_->m_bottom, bottom + 1, __ATOMIC_RELAXED);
+	}
+
+	return status;
+}
+
+
+/*******************************************************************************
+***************************** WorkDequeSteal **********************************/
+int WorkDequeSteal(work_deque_ty *deque_, void **element_)
+{
+	ring_ty *ring = NULL;
+	void *element = NULL;
+	long top = 0;
+	long bottom = 0;
+
+	ASSERT_IS_ALLOC(deque_);
+	assert (NULL != element_);
+
+	top = __atomic_load_n(&deque_->m_top, __ATOMIC_ACQUIRE);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	bottom = __atomic_load_n(&deque_->m_bottom, __ATOMIC_ACQUIRE);
+
+	if (top >= bottom)
+	{
+		return DEQUE_EMPTY;
+	}
+
+	/* A ring swapped after reading bottom still holds the element at top */
+	ring = __atomic_load_n(&deque_->m_ring, __ATOMIC_ACQUIRE);
+	element = __atomic_load_n(&SLOTS(ring)[top & ring->m_mask], __ATOMIC_RELAXED);
+
+	if (!__atomic_compare_exchange_n(&deque_->m_top, &top, top + 1, 0,
+	                                 __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+	{
+		return DEQUE_LOST;
+	}
+
+	*element_ = element;
+
+	return SUCCESS;
+}
+
+
+/*******************************************************************************
+****************************** WorkDequeSize **********************************/
+size_t WorkDequeSize(const work_deque_ty *deque_)
+{
+	long top = 0;
+	long bottom = 0;
+
+	ASSERT_IS_ALLOC(deque_);
+
+	top = __atomic_load_n(&deque_->m_top, __ATOMIC_ACQUIRE);
+	bottom = __atomic_load_n(&deque_->m_bottom, __ATOMIC_ACQUIRE);
+
+	/* A pop in progress briefly takes bottom below top */
+	return (bottom > top) ? (size_t)(bottom - top) : 0;
+}
+
+
+/*******************************************************************************
+*************************** Auxiliary Functions *******************************/
+static ring_ty *CreateRingIMP(size_t capacity_)
+{
+	ring_ty *ring = (ring_ty *)malloc(sizeof(ring_ty) + capacity_ * sizeof(void *));
+
+	if (NULL != ring)
+	{
+		ring->m_prev = NULL;
+		ring->m_mask = capacity_ - 1;
+	}
+
+	return ring;
+}
+
+
+/* Owner only. Copies the elements of [top_, bottom_) to a ring twice the
+	size, at the same positions, and publishes it */
+static ring_ty *GrowIMP(work_deque_ty *th_, ring_ty *ring_, long top_, long bottom_)
+{
+	ring_ty *bigger = CreateRingIMP(2 * (ring_->m_mask + 1));
+	long i = 0;
+
+	if (NULL == bigger)
+	{
+		return NULL;
+	}
+
+	for (i = top_; i < bottom_; ++i)
+	{
+		SLOTS(bigger)[i & bigger->m_mask] =
+			__atomic_load_n(&SLOTS(ring_)[i & ring_->m_mask], __ATOMIC_RELAXED);
+	}
+
+	bigger->m_prev = ring_;
+	__atomic_store_n(&th_->m_ring, bigger, __ATOMIC_RELEASE);
+
+	return bigger;
+}
@@ -0,0 +1,207 @@
+/*******************************************************************************
+***************************** - ATOMIC BIT SET - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Atomic Bit Set
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <pthread.h>	/* pthread_create, pthread_join */
+
+#include "utilities.h"
+#include "atomic_bitset.h"
+
+#define BITS_NUM		1000LU
+#define THREADS_NUM		4
+
+
+void TestAtomicBitSetCreate(void);
+void TestAtomicBitSetTestAndSet(void);
+void TestAtomicBitSetClaim(void);
+void TestAtomicBitSetConcurrentClaim(void);
+
+static void *ClaimAllIMP(void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+typedef struct claimer
+{
+	atomic_bitset_ty *m_bitset;
+	size_t m_hint;
+	size_t m_claimed;
+} claimer_ty;
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Atomic Bit Set ---\n);
+
+	TestAtomicBitSetCreate();
+	TestAtomicBitSetTestAndSet();
+	TestAtomicBitSetClaim();
+	TestAtomicBitSetConcurrentClaim();
+
+	return 0;
+}
+
+
+void TestAtomicBitSetCreate(void)
+{
+	atomic_bitset_ty *packed = AtomicBitSetCreate(BITS_NUM, ATOMIC_BITSET_PACKED);
+	atomic_bitset_ty *padded = AtomicBitSetCreate(BITS_NUM, ATOMIC_BITSET_PADDED);
+	size_t tcounter = 0;
+
+	if (NULL == packed || NULL == padded)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	if (BITS_NUM == AtomicBitSetSize(packed) && 0 == AtomicBitSetCountOn(packed))
+	{ ++tcounter; }
+
+	if (BITS_NUM == AtomicBitSetSize(padded) && 0 == AtomicBitSetCountOn(padded))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create");
+
+	AtomicBitSetDestroy(packed);
+	AtomicBitSetDestroy(padded);
+}
+
+
+void TestAtomicBitSetTestAndSet(void)
+{
+	atomic_bitset_ty *bitset = AtomicBitSetCreate(BITS_NUM, ATOMIC_BITSET_PADDED);
+	size_t tcounter = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	if (0 == AtomicBitSetTestAndSet(bitset, 700) && 1 == AtomicBitSetTestAndSet(bitset, 700))
+	{ ++tcounter; }
+
+	if (1 == AtomicBitSetGetVal(bitset, 700) && 0 == AtomicBitSetGetVal(bitset, 701))
+	{ ++tcounter; }
+
+	if (1 == AtomicBitSetTestAndClear(bitset, 700) && 0 == AtomicBitSetTestAndClear(bitset, 700))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "TestAndSet / TestAndClear");
+
+	AtomicBitSetDestroy(bitset);
+}
+
+
+void TestAtomicBitSetClaim(void)
+{
+	atomic_bitset_ty *bitset = AtomicBitSetCreate(BITS_NUM, ATOMIC_BITSET_PACKED);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	AtomicBitSetTestAndSet(bitset, 0);
+
+	if (1 == AtomicBitSetClaim(bitset) && 2 == AtomicBitSetClaim(bitset))
+	{ ++tcounter; }
+
+	/* A hint in the last word wraps around after it is full */
+	if (960 == AtomicBitSetClaimFrom(bitset, 960) && 961 == AtomicBitSetClaimFrom(bitset, 999))
+	{ ++tcounter; }
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		AtomicBitSetClaimFrom(bitset, 990);
+	}
+
+	if (BITS_NUM == AtomicBitSetCountOn(bitset) && BITS_NUM == AtomicBitSetClaim(bitset))
+	{ ++tcounter; }
+
+	AtomicBitSetRelease(bitset, 512);
+
+	if (512 == AtomicBitSetClaimFrom(bitset, 900))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "Claim / Release");
+
+	AtomicBitSetDestroy(bitset);
+}
+
+
+void TestAtomicBitSetConcurrentClaim(void)
+{
+	atomic_bitset_ty *bitset = AtomicBitSetCreate(BITS_NUM, ATOMIC_BITSET_PACKED);
+	pthread_t threads[THREADS_NUM];
+	claimer_ty claimers[THREADS_NUM];
+	size_t total = 0;
+	size_t i = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	/* All threads start on the same word to force contention */
+	for (i = 0; i < THREADS_NUM; ++i)
+	{
+		claimers[i].m_bitset = bitset;
+		claimers[i].m_hint = 0;
+		claimers[i].m_claimed = 0;
+		pthread_create(&threads[i], NULL, ClaimAllIMP, &claimers[i]);
+	}
+
+	for (i = 0; i < THREADS_NUM; ++i)
+	{
+		pthread_join(threads[i], NULL);
+		total += claimers[i].m_claimed;
+	}
+
+	/* Every bit was claimed exactly once */
+	PrintTestStatusIMP((BITS_NUM == total) + (BITS_NUM == AtomicBitSetCountOn(bitset)), 
+	                   2, "Concurrent Claim");
+
+	AtomicBitSetDestroy(bitset);
+}
+
+
+static void *ClaimAllIMP(void *param_)
+{
+	claimer_ty *claimer = (claimer_ty *)param_;
+	size_t size = AtomicBitSetSize(claimer->m_bitset);
+
+	while (size != AtomicBitSetClaimFrom(claimer->m_bitset, claimer->m_hint))
+	{
+		++claimer->m_claimed;
+	}
+
+	return NULL;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
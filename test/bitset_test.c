@@ -0,0 +1,555 @@
+/*******************************************************************************
+******************************** - BIT SET - ***********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Bit Set
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+
+#include "utilities.h"
+#include "bitset.h"
+
+#define BITS_NUM		1000LU
+
+
+void TestBitSetCreate(void);
+void TestBitSetSetGet(void);
+void TestBitSetAll(void);
+void TestBitSetOperations(void);
+void TestBitSetCount(void);
+void TestBitSetMirror(void);
+void TestBitSetFind(void);
+void TestBitSetForEach(void);
+void TestBitSetRanges(void);
+void TestBitSetCopyRange(void);
+void TestBitSetShiftRotate(void);
+
+static int PatternIMP(size_t index_);
+static void FillPatternIMP(bitset_ty *bitset_);
+static int SumIndexesIMP(size_t index_, void *param_);
+static int StopAtIMP(size_t index_, void *param_);
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Bit Set ---\n);
+
+	TestBitSetCreate();
+	TestBitSetSetGet();
+	TestBitSetAll();
+	TestBitSetOperations();
+	TestBitSetCount();
+	TestBitSetMirror();
+	TestBitSetFind();
+	TestBitSetForEach();
+	TestBitSetRanges();
+	TestBitSetCopyRange();
+	TestBitSetShiftRotate();
+
+	return 0;
+}
+
+
+void TestBitSetCreate(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t tcounter = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	if (BITS_NUM == BitSetSize(bitset))
+	{ ++tcounter; }
+
+	if (16 == BitSetWordsCount(bitset))
+	{ ++tcounter; }
+
+	if (0 == BitSetCountOn(bitset))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Create");
+
+	BitSetDestroy(bitset);
+}
+
+
+void TestBitSetSetGet(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t indexes[] = {0, 63, 64, 500, 999};
+	size_t n_indexes = sizeof(indexes) / sizeof(indexes[0]);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < n_indexes; ++i)
+	{
+		BitSetSetOn(bitset, indexes[i]);
+	}
+
+	for (i = 0; i < n_indexes; ++i)
+	{
+		if (1 == BitSetGetVal(bitset, indexes[i]))
+		{ ++tcounter; }
+	}
+
+	BitSetSetOff(bitset, 63);
+	BitSetFlip(bitset, 64);
+	BitSetFlip(bitset, 65);
+	BitSetSetBit(bitset, 1, 1);
+
+	if (0 == BitSetGetVal(bitset, 63) && 0 == BitSetGetVal(bitset, 64) &&
+		1 == BitSetGetVal(bitset, 65) && 1 == BitSetGetVal(bitset, 1))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, n_indexes + 1, "Set / Get");
+
+	BitSetDestroy(bitset);
+}
+
+
+void TestBitSetAll(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t tcounter = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	BitSetSetAll(bitset);
+
+	if (BITS_NUM == BitSetCountOn(bitset))
+	{ ++tcounter; }
+
+	BitSetResetAll(bitset);
+
+	if (BITS_NUM == BitSetCountOff(bitset))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "SetAll / ResetAll");
+
+	BitSetDestroy(bitset);
+}
+
+
+void TestBitSetOperations(void)
+{
+	bitset_ty *evens = BitSetCreate(BITS_NUM);
+	bitset_ty *thirds = BitSetCreate(BITS_NUM);
+	bitset_ty *result = BitSetCreate(BITS_NUM);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == evens || NULL == thirds || NULL == result)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		BitSetSetBit(evens, i, (0 == i % 2));
+		BitSetSetBit(thirds, i, (0 == i % 3));
+	}
+
+	/* multiples of 6 in [0, 1000) => 167 */
+	BitSetOr(result, evens);
+	BitSetAnd(result, thirds);
+	if (167 == BitSetCountOn(result))
+	{ ++tcounter; }
+
+	/* 500 evens + 334 thirds - 167 shared */
+	BitSetResetAll(result);
+	BitSetOr(result, evens);
+	BitSetOr(result, thirds);
+	if (667 == BitSetCountOn(result))
+	{ ++tcounter; }
+
+	BitSetXor(result, thirds);
+	if (333 == BitSetCountOn(result))
+	{ ++tcounter; }
+
+	BitSetOr(result, thirds);
+	BitSetAndNot(result, evens);
+	if (167 == BitSetCountOn(result) && 1 == BitSetGetVal(result, 3))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "And / Or / Xor / AndNot");
+
+	BitSetDestroy(evens);
+	BitSetDestroy(thirds);
+	BitSetDestroy(result);
+}
+
+
+void TestBitSetCount(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < BITS_NUM; i += 7)
+	{
+		BitSetSetOn(bitset, i);
+	}
+
+	if (143 == BitSetCountOn(bitset))
+	{ ++tcounter; }
+
+	if (BITS_NUM - 143 == BitSetCountOff(bitset))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Count");
+
+	BitSetDestroy(bitset);
+}
+
+
+void TestBitSetMirror(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t tcounter = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	BitSetSetOn(bitset, 0);
+	BitSetSetOn(bitset, 10);
+	BitSetSetOn(bitset, 700);
+
+	BitSetMirror(bitset);
+
+	if (1 == BitSetGetVal(bitset, 999) && 1 == BitSetGetVal(bitset, 989) &&
+		1 == BitSetGetVal(bitset, 299) && 3 == BitSetCountOn(bitset))
+	{ ++tcounter; }
+
+	BitSetMirror(bitset);
+
+	if (1 == BitSetGetVal(bitset, 0) && 1 == BitSetGetVal(bitset, 10) &&
+		1 == BitSetGetVal(bitset, 700) && 3 == BitSetCountOn(bitset))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Mirror");
+
+	BitSetDestroy(bitset);
+}
+
+
+void TestBitSetFind(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	if (BITS_NUM == BitSetFindFirstSet(bitset) && 0 == BitSetFindFirstClear(bitset) &&
+		BITS_NUM == BitSetFindLastSet(bitset))
+	{ ++tcounter; }
+
+	BitSetSetOn(bitset, 130);
+	BitSetSetOn(bitset, 131);
+	BitSetSetOn(bitset, 900);
+
+	if (130 == BitSetFindFirstSet(bitset) && 131 == BitSetFindNextSet(bitset, 131) &&
+		900 == BitSetFindNextSet(bitset, 132) && 
+		BITS_NUM == BitSetFindNextSet(bitset, 901) &&
+		900 == BitSetFindLastSet(bitset))
+	{ ++tcounter; }
+
+	BitSetSetAll(bitset);
+
+	if (BITS_NUM == BitSetFindFirstClear(bitset) && 
+		BITS_NUM == BitSetFindNextClear(bitset, 990))
+	{ ++tcounter; }
+
+	/* Clear every bit in [0, 700) but 3 */
+	for (i = 0; i < 700; ++i)
+	{
+		BitSetSetBit(bitset, i, (3 == i));
+	}
+
+	if (0 == BitSetFindFirstClear(bitset) && 4 == BitSetFindNextClear(bitset, 3) &&
+		3 == BitSetFindFirstSet(bitset) && 700 == BitSetFindNextSet(bitset, 4) &&
+		BITS_NUM - 1 == BitSetFindLastSet(bitset))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "Find");
+
+	BitSetDestroy(bitset);
+}
+
+
+void TestBitSetForEach(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t sum = 0;
+	size_t stop_at = 640;
+	size_t tcounter = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	BitSetSetOn(bitset, 1);
+	BitSetSetOn(bitset, 64);
+	BitSetSetOn(bitset, 640);
+	BitSetSetOn(bitset, 999);
+
+	if (SUCCESS == BitSetForEachSet(bitset, SumIndexesIMP, &sum) && 1704 == sum)
+	{ ++tcounter; }
+
+	if (1 == BitSetForEachSet(bitset, StopAtIMP, &stop_at))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "ForEachSet");
+
+	BitSetDestroy(bitset);
+}
+
+
+void TestBitSetRanges(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t tcounter = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	BitSetSetRange(bitset, 3, 900);
+
+	if (897 == BitSetCountOn(bitset) && 0 == BitSetGetVal(bitset, 2) &&
+		1 == BitSetGetVal(bitset, 3) && 1 == BitSetGetVal(bitset, 899) &&
+		0 == BitSetGetVal(bitset, 900))
+	{ ++tcounter; }
+
+	/* Exactly one whole word */
+	BitSetClearRange(bitset, 64, 128);
+
+	if (833 == BitSetCountOn(bitset) && 1 == BitSetGetVal(bitset, 63) &&
+		0 == BitSetGetVal(bitset, 64) && 0 == BitSetGetVal(bitset, 127) &&
+		1 == BitSetGetVal(bitset, 128))
+	{ ++tcounter; }
+
+	/* The tail bits stay clear */
+	BitSetFlipRange(bitset, 0, BITS_NUM);
+
+	if (167 == BitSetCountOn(bitset) && 999 == BitSetFindLastSet(bitset))
+	{ ++tcounter; }
+
+	/* Inside a single word, and an empty range */
+	BitSetFlipRange(bitset, 10, 12);
+	BitSetSetRange(bitset, 500, 500);
+
+	if (169 == BitSetCountOn(bitset) && 1 == BitSetGetVal(bitset, 11) &&
+		0 == BitSetGetVal(bitset, 500))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "Set / Clear / Flip Range");
+
+	BitSetDestroy(bitset);
+}
+
+
+void TestBitSetCopyRange(void)
+{
+	bitset_ty *src = BitSetCreate(BITS_NUM);
+	bitset_ty *dest = BitSetCreate(BITS_NUM);
+	size_t mismatches = 0;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == src || NULL == dest)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	FillPatternIMP(src);
+	BitSetSetAll(dest);
+
+	BitSetCopyRange(dest, 101, src, 37, 500);
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		if (BitSetGetVal(dest, i) !=
+		    ((101 <= i && i < 601) ? PatternIMP(i - 101 + 37) : 1))
+		{
+			++mismatches;
+		}
+	}
+
+	if (0 == mismatches)
+	{ ++tcounter; }
+
+	/* Overlapping ranges of the same bit set, in both directions */
+	FillPatternIMP(dest);
+	BitSetCopyRange(dest, 200, dest, 10, 700);
+	BitSetCopyRange(src, 5, src, 300, 690);
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		mismatches += BitSetGetVal(dest, i) !=
+		              ((200 <= i && i < 900) ? PatternIMP(i - 200 + 10) : PatternIMP(i));
+		mismatches += BitSetGetVal(src, i) !=
+		              ((5 <= i && i < 695) ? PatternIMP(i - 5 + 300) : PatternIMP(i));
+	}
+
+	if (0 == mismatches)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Copy Range");
+
+	BitSetDestroy(src);
+	BitSetDestroy(dest);
+}
+
+
+void TestBitSetShiftRotate(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	size_t mismatches = 0;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	FillPatternIMP(bitset);
+	BitSetShiftLeft(bitset, 130);
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		mismatches += BitSetGetVal(bitset, i) != ((i < 130) ? 0 : PatternIMP(i - 130));
+	}
+
+	BitSetShiftRight(bitset, 130);
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		mismatches += BitSetGetVal(bitset, i) != ((i < 870) ? PatternIMP(i) : 0);
+	}
+
+	/* Nothing left, and no bit past the set size */
+	BitSetShiftLeft(bitset, BITS_NUM);
+	mismatches += (0 != BitSetCountOn(bitset));
+
+	if (0 == mismatches)
+	{ ++tcounter; }
+
+	FillPatternIMP(bitset);
+
+	/* RotL 333 saves the top 333 bits, RotL 900 the low 100 bits */
+	if (SUCCESS != BitSetRotL(bitset, 333))
+	{
+		++mismatches;
+	}
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		mismatches += BitSetGetVal(bitset, i) != PatternIMP((i + BITS_NUM - 333) % BITS_NUM);
+	}
+
+	if (SUCCESS != BitSetRotR(bitset, 333) || SUCCESS != BitSetRotL(bitset, 900) ||
+		SUCCESS != BitSetRotL(bitset, 2 * BITS_NUM))
+	{
+		++mismatches;
+	}
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		mismatches += BitSetGetVal(bitset, i) != PatternIMP((i + 100) % BITS_NUM);
+	}
+
+	if (0 == mismatches)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Shift / Rotate");
+
+	BitSetDestroy(bitset);
+}
+
+
+/* An irregular pattern that crosses the word boundaries */
+static int PatternIMP(size_t index_)
+{
+	return (index_ * 7) % 11 < 4;
+}
+
+static void FillPatternIMP(bitset_ty *bitset_)
+{
+	size_t i = 0;
+
+	for (i = 0; i < BitSetSize(bitset_); ++i)
+	{
+		BitSetSetBit(bitset_, i, PatternIMP(i));
+	}
+}
+
+static int SumIndexesIMP(size_t index_, void *param_)
+{
+	*(size_t *)param_ += index_;
+
+	return 0;
+}
+
+static int StopAtIMP(size_t index_, void *param_)
+{
+	return (index_ == *(size_t *)param_);
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
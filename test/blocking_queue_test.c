@@ -0,0 +1,325 @@
+/*******************************************************************************
+**************************** - BLOCKING QUEUE - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Blocking Queue
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#define _POSIX_C_SOURCE 200112L		/* clock_gettime, nanosleep */
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <pthread.h>	/* pthread_create, pthread_join */
+#include <time.h>		/* clock_gettime, nanosleep */
+
+#include "utilities.h"
+#include "blocking_queue.h"
+
+#define PRODUCERS		4LU
+#define CONSUMERS		4LU
+#define PER_PRODUCER	100000LU
+#define BATCH			16LU
+#define TIMEOUT_MS		50L
+
+typedef struct consumer
+{
+	blocking_queue_ty *m_queue;
+	size_t m_id;
+	size_t m_received;
+	size_t m_checksum;
+} consumer_ty;
+
+
+void TestBlockingQueueCreate(void);
+void TestBlockingQueueDequeueWait(void);
+void TestBlockingQueueDequeueBatch(void);
+void TestBlockingQueueThreads(void);
+
+static void *ProduceIMP(void *param_);
+static void *ConsumeIMP(void *param_);
+static void *WaitOneIMP(void *param_);
+static long ElapsedMsIMP(const struct timespec *start_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Blocking Queue ---\n);
+
+	TestBlockingQueueCreate();
+	TestBlockingQueueDequeueWait();
+	TestBlockingQueueDequeueBatch();
+	TestBlockingQueueThreads();
+
+	return 0;
+}
+
+
+void TestBlockingQueueCreate(void)
+{
+	blocking_queue_ty *queue = BlockingQueueCreate(8);
+	void *element = NULL;
+	size_t tcounter = 0;
+
+	if (NULL != queue && 0 == BlockingQueueSize(queue))
+	{ ++tcounter; }
+
+	/* timeout 0 only tries */
+	if (SUCCESS != BlockingQueueDequeueWait(queue, &element, 0) &&
+	    0 == BlockingQueueDequeueBatch(queue, &element, 1, 0))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create");
+
+	BlockingQueueDestroy(queue);
+}
+
+
+void TestBlockingQueueDequeueWait(void)
+{
+	blocking_queue_ty *queue = BlockingQueueCreate(8);
+	struct timespec start;
+	struct timespec delay = { 0, TIMEOUT_MS * 1000000L };
+	pthread_t waiter;
+	void *element = NULL;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	/* FIFO order, past the first ring capacity */
+	for (i = 1; i <= 20 && SUCCESS == BlockingQueueEnqueue(queue, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	for (i = 1; i <= 20 && SUCCESS == BlockingQueueDequeueWait(queue, &element, 0) &&
+	            (void *)i == element; ++i)
+	{
+		/* empty */
+	}
+
+	if (21 == i && 0 == BlockingQueueSize(queue))
+	{ ++tcounter; }
+
+	/* Gives up after the timeout */
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	if (SUCCESS != BlockingQueueDequeueWait(queue, &element, TIMEOUT_MS) &&
+	    TIMEOUT_MS <= ElapsedMsIMP(&start))
+	{ ++tcounter; }
+
+	/* A sleeping consumer wakes up for the element */
+	element = NULL;
+	pthread_create(&waiter, NULL, WaitOneIMP, queue);
+	nanosleep(&delay, NULL);
+	BlockingQueueEnqueue(queue, (void *)7);
+	pthread_join(waiter, &element);
+
+	if ((void *)7 == element && 0 == BlockingQueueSize(queue))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "DequeueWait");
+
+	BlockingQueueDestroy(queue);
+}
+
+
+void TestBlockingQueueDequeueBatch(void)
+{
+	blocking_queue_ty *queue = BlockingQueueCreate(8);
+	struct timespec start;
+	void *out[BATCH];
+	size_t n = 0;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < 20; ++i)
+	{
+		BlockingQueueEnqueue(queue, (void *)i);
+	}
+
+	/* At most max, in order */
+	n = BlockingQueueDequeueBatch(queue, out, BATCH, 0);
+
+	for (i = 0; i < n && (void *)i == out[i]; ++i)
+	{
+		/* empty */
+	}
+
+	if (BATCH == n && BATCH == i && 4 == BlockingQueueSize(queue))
+	{ ++tcounter; }
+
+	/* Fewer when fewer are left */
+	n = BlockingQueueDequeueBatch(queue, out, BATCH, BLOCKING_QUEUE_FOREVER);
+
+	if (4 == n && (void *)BATCH == out[0] && (void *)19 == out[3])
+	{ ++tcounter; }
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	if (0 == BlockingQueueDequeueBatch(queue, out, BATCH, TIMEOUT_MS) &&
+	    TIMEOUT_MS <= ElapsedMsIMP(&start))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "DequeueBatch");
+
+	BlockingQueueDestroy(queue);
+}
+
+
+void TestBlockingQueueThreads(void)
+{
+	blocking_queue_ty *queue = BlockingQueueCreate(8);
+	pthread_t producer_threads[PRODUCERS];
+	pthread_t consumer_threads[CONSUMERS];
+	consumer_ty consumers[CONSUMERS];
+	size_t received = 0;
+	size_t checksum = 0;
+	size_t total = PRODUCERS * PER_PRODUCER;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == queue)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	/* Consumers start first, so they go to sleep on an empty queue */
+	for (i = 0; i < CONSUMERS; ++i)
+	{
+		consumers[i].m_queue = queue;
+		consumers[i].m_id = i;
+		consumers[i].m_received = 0;
+		consumers[i].m_checksum = 0;
+		pthread_create(&consumer_threads[i], NULL, ConsumeIMP, &consumers[i]);
+	}
+
+	for (i = 0; i < PRODUCERS; ++i)
+	{
+		pthread_create(&producer_threads[i], NULL, ProduceIMP, queue);
+	}
+
+	for (i = 0; i < PRODUCERS; ++i)
+	{
+		pthread_join(producer_threads[i], NULL);
+	}
+
+	/* One NULL per consumer tells it to stop */
+	for (i = 0; i < CONSUMERS; ++i)
+	{
+		BlockingQueueEnqueue(queue, NULL);
+	}
+
+	for (i = 0; i < CONSUMERS; ++i)
+	{
+		pthread_join(consumer_threads[i], NULL);
+		received += consumers[i].m_received;
+		checksum += consumers[i].m_checksum;
+	}
+
+	if (total == received && 0 == BlockingQueueSize(queue))
+	{ ++tcounter; }
+
+	/* Every producer sent 1 .. PER_PRODUCER */
+	if (PRODUCERS * PER_PRODUCER * (PER_PRODUCER + 1) / 2 == checksum)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Producer / Consumer Threads");
+
+	BlockingQueueDestroy(queue);
+}
+
+
+static void *ProduceIMP(void *param_)
+{
+	blocking_queue_ty *queue = (blocking_queue_ty *)param_;
+	size_t i = 0;
+
+	for (i = 1; i <= PER_PRODUCER; ++i)
+	{
+		BlockingQueueEnqueue(queue, (void *)i);
+	}
+
+	return NULL;
+}
+
+
+/* Even consumers take one element at a time, odd ones take batches */
+static void *ConsumeIMP(void *param_)
+{
+	consumer_ty *consumer = (consumer_ty *)param_;
+	void *batch[BATCH];
+	size_t stops = 0;
+	size_t n = 0;
+	size_t i = 0;
+
+	while (0 == stops)
+	{
+		if (0 == consumer->m_id % 2)
+		{
+			n = (SUCCESS == BlockingQueueDequeueWait(consumer->m_queue, &batch[0],
+			                                         BLOCKING_QUEUE_FOREVER));
+		}
+		else
+		{
+			n = BlockingQueueDequeueBatch(consumer->m_queue, batch, BATCH,
+			                              BLOCKING_QUEUE_FOREVER);
+		}
+
+		for (i = 0; i < n; ++i)
+		{
+			stops += (NULL == batch[i]);
+			consumer->m_received += (NULL != batch[i]);
+			consumer->m_checksum += (size_t)batch[i];
+		}
+	}
+
+	/* A batch may hold the NULLs of other consumers too */
+	for (i = 1; i < stops; ++i)
+	{
+		BlockingQueueEnqueue(consumer->m_queue, NULL);
+	}
+
+	return NULL;
+}
+
+
+static void *WaitOneIMP(void *param_)
+{
+	void *element = NULL;
+
+	BlockingQueueDequeueWait((blocking_queue_ty *)param_, &element, BLOCKING_QUEUE_FOREVER);
+
+	return element;
+}
+
+
+static long ElapsedMsIMP(const struct timespec *start_)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (long)(now.tv_sec - start_->tv_sec) * 1000L +
+	       (long)(now.tv_nsec - start_->tv_nsec) / 1000000L;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -0,0 +1,243 @@
+/*******************************************************************************
+****************************** - BLOOM FILTER - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Bloom filter and counting Bloom filter
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+
+#include "utilities.h"
+#include "bloom_filter.h"
+
+#define N_ITEMS			10000LU
+#define FP_RATE			0.01
+
+
+void TestBloomSizing(void);
+void TestBloomInsertFind(void);
+void TestBloomBatch(void);
+void TestCountingBloom(void);
+
+static size_t IdentityHashIMP(const void *data_, const void *param_);
+static size_t FalsePositivesIMP(const bloom_ty *bloom_, size_t from_, size_t to_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Bloom Filter ---\n);
+
+	TestBloomSizing();
+	TestBloomInsertFind();
+	TestBloomBatch();
+	TestCountingBloom();
+
+	return 0;
+}
+
+
+void TestBloomSizing(void)
+{
+	size_t tcounter = 0;
+	size_t n_bits = BloomOptimalBits(N_ITEMS, FP_RATE);
+
+	/* 1% => ~9.59 bits and 7 hashes per item */
+	if (95850 < n_bits && n_bits < 95900)
+	{ ++tcounter; }
+
+	if (7 == BloomOptimalHashes(n_bits, N_ITEMS) && 1 == BloomOptimalHashes(10, 100))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Sizing");
+}
+
+
+void TestBloomInsertFind(void)
+{
+	size_t n_bits = BloomOptimalBits(N_ITEMS, FP_RATE);
+	bloom_ty *bloom = BloomCreate(n_bits, BloomOptimalHashes(n_bits, N_ITEMS),
+	                              IdentityHashIMP, NULL, NULL);
+	size_t tcounter = 0;
+	size_t misses = 0;
+	size_t i = 0;
+
+	if (NULL == bloom)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	if (0 == BloomMayContain(bloom, (void *)5))
+	{ ++tcounter; }
+
+	for (i = 0; i < N_ITEMS; ++i)
+	{
+		BloomInsert(bloom, (void *)i);
+	}
+
+	/* No false negatives */
+	for (i = 0; i < N_ITEMS; ++i)
+	{
+		misses += !BloomMayContain(bloom, (void *)i);
+	}
+
+	if (0 == misses)
+	{ ++tcounter; }
+
+	/* False positive rate close to the target, allow twice of it */
+	if (FalsePositivesIMP(bloom, N_ITEMS, 11 * N_ITEMS) < 2 * FP_RATE * 10 * N_ITEMS)
+	{ ++tcounter; }
+
+	BloomClear(bloom);
+
+	if (0 == BloomMayContain(bloom, (void *)5))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "Insert / MayContain");
+
+	BloomDestroy(bloom);
+}
+
+
+void TestBloomBatch(void)
+{
+	bloom_ty *single = BloomCreate(1 << 16, 5, IdentityHashIMP, NULL, NULL);
+	bloom_ty *batch = BloomCreate(1 << 16, 5, IdentityHashIMP, NULL, NULL);
+	const void *keys[1000];
+	int results[1000];
+	size_t mismatches = 0;
+	size_t i = 0;
+
+	if (NULL == single || NULL == batch)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	/* Odd length, so the last group is partial */
+	for (i = 0; i < 999; ++i)
+	{
+		keys[i] = (void *)(i * 3);
+		BloomInsert(single, keys[i]);
+	}
+
+	BloomInsertBatch(batch, keys, 999);
+
+	for (i = 0; i < 999; ++i)
+	{
+		keys[i] = (void *)i;
+	}
+
+	BloomQueryBatch(batch, keys, 999, results);
+
+	for (i = 0; i < 999; ++i)
+	{
+		mismatches += (results[i] != BloomMayContain(single, keys[i]));
+		mismatches += (0 == i % 3 && 1 != results[i]);
+	}
+
+	PrintTestStatusIMP(0 == mismatches, 1, "Batch");
+
+	BloomDestroy(single);
+	BloomDestroy(batch);
+}
+
+
+void TestCountingBloom(void)
+{
+	counting_bloom_ty *bloom = CountingBloomCreate(BloomOptimalBits(N_ITEMS, FP_RATE),
+	                                               7, IdentityHashIMP, NULL, NULL);
+	size_t tcounter = 0;
+	size_t misses = 0;
+	size_t present = 0;
+	size_t i = 0;
+
+	if (NULL == bloom)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < N_ITEMS; ++i)
+	{
+		CountingBloomInsert(bloom, (void *)i);
+	}
+
+	/* Remove the odd items */
+	for (i = 1; i < N_ITEMS; i += 2)
+	{
+		CountingBloomRemove(bloom, (void *)i);
+	}
+
+	for (i = 0; i < N_ITEMS; i += 2)
+	{
+		misses += !CountingBloomMayContain(bloom, (void *)i);
+	}
+
+	if (0 == misses)
+	{ ++tcounter; }
+
+	for (i = 1; i < N_ITEMS; i += 2)
+	{
+		present += CountingBloomMayContain(bloom, (void *)i);
+	}
+
+	if (present < 2 * FP_RATE * N_ITEMS)
+	{ ++tcounter; }
+
+	/* Counters saturate instead of wrapping to 0 */
+	for (i = 0; i < 300; ++i)
+	{
+		CountingBloomInsert(bloom, (void *)N_ITEMS);
+	}
+
+	CountingBloomRemove(bloom, (void *)N_ITEMS);
+
+	if (1 == CountingBloomMayContain(bloom, (void *)N_ITEMS))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Counting Bloom");
+
+	CountingBloomDestroy(bloom);
+}
+
+
+static size_t IdentityHashIMP(const void *data_, const void *param_)
+{
+	UNUSED(param_);
+
+	return (size_t)data_;
+}
+
+static size_t FalsePositivesIMP(const bloom_ty *bloom_, size_t from_, size_t to_)
+{
+	size_t counter = 0;
+
+	for (; from_ < to_; ++from_)
+	{
+		counter += BloomMayContain(bloom_, (void *)from_);
+	}
+
+	return counter;
+}
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -0,0 +1,217 @@
+/*******************************************************************************
+***************************** - CONCURRENT STACK - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Concurrent Stack
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <pthread.h>	/* pthread_create, pthread_join */
+
+#include "utilities.h"
+#include "conc_stack.h"
+
+#define THREADS_NUM			4
+#define ROUNDS_PER_THREAD	50000LU
+#define BURST				8LU
+#define SEQ_BITS			32
+
+typedef struct worker
+{
+	conc_stack_ty *m_stack;
+	size_t m_id;
+	size_t m_pushed_sum;
+	size_t m_popped_sum;
+	size_t m_failed;
+} worker_ty;
+
+
+void TestConcStackCreate(void);
+void TestConcStackPushPop(void);
+void TestConcStackConcurrent(void);
+
+static void *PushPopIMP(void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Concurrent Stack ---\n);
+
+	TestConcStackCreate();
+	TestConcStackPushPop();
+	TestConcStackConcurrent();
+
+	return 0;
+}
+
+
+void TestConcStackCreate(void)
+{
+	conc_stack_ty *stack = ConcStackCreate(10);
+	void *element = NULL;
+	size_t tcounter = 0;
+
+	if (NULL != stack && 10 == ConcStackCapacity(stack) &&
+	    0 == ConcStackSize(stack) && ConcStackIsEmpty(stack))
+	{ ++tcounter; }
+
+	if (SUCCESS != ConcStackPop(stack, &element) && SUCCESS != ConcStackPeek(stack, &element))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create");
+
+	ConcStackDestroy(stack);
+}
+
+
+void TestConcStackPushPop(void)
+{
+	conc_stack_ty *stack = ConcStackCreate(100);
+	void *element = NULL;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < 100 && SUCCESS == ConcStackPush(stack, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	if (100 == i && 100 == ConcStackSize(stack) &&
+	    SUCCESS != ConcStackPush(stack, (void *)i))
+	{ ++tcounter; }
+
+	if (SUCCESS == ConcStackPeek(stack, &element) && (void *)99 == element &&
+	    !ConcStackIsEmpty(stack))
+	{ ++tcounter; }
+
+	for (i = 100; i > 0 && SUCCESS == ConcStackPop(stack, &element) &&
+	     (void *)(i - 1) == element; --i)
+	{
+		/* empty */
+	}
+
+	if (0 == i && ConcStackIsEmpty(stack) && 0 == ConcStackSize(stack))
+	{ ++tcounter; }
+
+	/* Popped nodes are reused */
+	if (SUCCESS == ConcStackPush(stack, (void *)7) &&
+	    SUCCESS == ConcStackPop(stack, &element) && (void *)7 == element)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "Push / Pop / Peek");
+
+	ConcStackDestroy(stack);
+}
+
+
+void TestConcStackConcurrent(void)
+{
+	conc_stack_ty *stack = ConcStackCreate(THREADS_NUM * BURST);
+	pthread_t threads[THREADS_NUM];
+	worker_ty workers[THREADS_NUM];
+	size_t pushed_sum = 0;
+	size_t popped_sum = 0;
+	size_t failed = 0;
+	size_t i = 0;
+	size_t tcounter = 0;
+
+	if (NULL == stack)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < THREADS_NUM; ++i)
+	{
+		workers[i].m_stack = stack;
+		workers[i].m_id = i;
+		workers[i].m_pushed_sum = 0;
+		workers[i].m_popped_sum = 0;
+		workers[i].m_failed = 0;
+		pthread_create(&threads[i], NULL, PushPopIMP, &workers[i]);
+	}
+
+	for (i = 0; i < THREADS_NUM; ++i)
+	{
+		pthread_join(threads[i], NULL);
+		pushed_sum += workers[i].m_pushed_sum;
+		popped_sum += workers[i].m_popped_sum;
+		failed += workers[i].m_failed;
+	}
+
+	/* Every thread pops only what it pushed before, nothing may fail */
+	if (0 == failed && ConcStackIsEmpty(stack) && 0 == ConcStackSize(stack))
+	{ ++tcounter; }
+
+	/* Every element was popped exactly once */
+	if (pushed_sum == popped_sum)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Concurrent Push / Pop");
+
+	ConcStackDestroy(stack);
+}
+
+
+/* Pushes a burst of unique values, then pops as many */
+static void *PushPopIMP(void *param_)
+{
+	worker_ty *worker = (worker_ty *)param_;
+	void *element = NULL;
+	size_t value = 0;
+	size_t i = 0;
+	size_t j = 0;
+
+	for (i = 0; i < ROUNDS_PER_THREAD; ++i)
+	{
+		for (j = 0; j < (i % BURST) + 1; ++j)
+		{
+			value = ((worker->m_id + 1) << SEQ_BITS) | (i * BURST + j);
+
+			if (SUCCESS == ConcStackPush(worker->m_stack, (void *)value))
+			{
+				worker->m_pushed_sum += value;
+			}
+			else
+			{
+				++worker->m_failed;
+			}
+		}
+
+		for (j = 0; j < (i % BURST) + 1; ++j)
+		{
+			if (SUCCESS == ConcStackPop(worker->m_stack, &element))
+			{
+				worker->m_popped_sum += (size_t)element;
+			}
+			else
+			{
+				++worker->m_failed;
+			}
+		}
+	}
+
+	return NULL;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -0,0 +1,229 @@
+/*******************************************************************************
+**************************** - CONCURRENT VECTOR - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Concurrent Vector
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <pthread.h>	/* pthread_create, pthread_join */
+
+#include "utilities.h"
+#include "conc_vector.h"
+
+#define THREADS_NUM			4
+#define PUSHES_PER_THREAD	100000LU
+#define SEQ_BITS			32
+
+typedef struct pusher
+{
+	conc_vector_ty *m_vector;
+	size_t m_id;
+} pusher_ty;
+
+typedef struct reader
+{
+	conc_vector_ty *m_vector;
+	size_t m_bad_reads;
+	size_t m_last_size;
+} reader_ty;
+
+
+void TestConcVectorCreate(void);
+void TestConcVectorPushGet(void);
+void TestConcVectorConcurrentPush(void);
+
+static void *PushAllIMP(void *param_);
+static void *ReadAllIMP(void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Concurrent Vector ---\n);
+
+	TestConcVectorCreate();
+	TestConcVectorPushGet();
+	TestConcVectorConcurrentPush();
+
+	return 0;
+}
+
+
+void TestConcVectorCreate(void)
+{
+	conc_vector_ty *vector = ConcVectorCreate(sizeof(void *));
+	size_t tcounter = 0;
+
+	if (NULL != vector && 0 == ConcVectorSize(vector))
+	{ ++tcounter; }
+
+	if (SUCCESS == ConcVectorReserve(vector, 100000) && 0 == ConcVectorSize(vector))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create / Reserve");
+
+	ConcVectorDestroy(vector);
+}
+
+
+void TestConcVectorPushGet(void)
+{
+	conc_vector_ty *vector = ConcVectorCreate(sizeof(void *));
+	void *element = NULL;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < 1000 && SUCCESS == ConcVectorPushBack(vector, &element); ++i)
+	{
+		element = (void *)(i + 1);
+	}
+
+	if (1000 == i && 1000 == ConcVectorSize(vector))
+	{ ++tcounter; }
+
+	for (i = 0; i < 1000; ++i)
+	{
+		ConcVectorGet(vector, i, &element);
+
+		if ((void *)i != element || (void *)i != *(void **)ConcVectorAt(vector, i))
+		{
+			break;
+		}
+	}
+
+	if (1000 == i)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "PushBack / Get");
+
+	ConcVectorDestroy(vector);
+}
+
+
+void TestConcVectorConcurrentPush(void)
+{
+	conc_vector_ty *vector = ConcVectorCreate(sizeof(size_t));
+	pthread_t threads[THREADS_NUM + 1];
+	pusher_ty pushers[THREADS_NUM];
+	reader_ty reader;
+	size_t next_seq[THREADS_NUM] = {0};
+	size_t total = THREADS_NUM * PUSHES_PER_THREAD;
+	size_t value = 0;
+	size_t id = 0;
+	size_t i = 0;
+	size_t tcounter = 0;
+
+	if (NULL == vector)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	reader.m_vector = vector;
+	reader.m_bad_reads = 0;
+	reader.m_last_size = 0;
+	pthread_create(&threads[THREADS_NUM], NULL, ReadAllIMP, &reader);
+
+	for (i = 0; i < THREADS_NUM; ++i)
+	{
+		pushers[i].m_vector = vector;
+		pushers[i].m_id = i;
+		pthread_create(&threads[i], NULL, PushAllIMP, &pushers[i]);
+	}
+
+	for (i = 0; i <= THREADS_NUM; ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	if (total == ConcVectorSize(vector))
+	{ ++tcounter; }
+
+	/* Every push is there once, in the order its thread made it */
+	for (i = 0; i < total; ++i)
+	{
+		ConcVectorGet(vector, i, &value);
+		id = (value >> SEQ_BITS) - 1;
+
+		if (id >= THREADS_NUM || (value & 0xFFFFFFFFLU) != next_seq[id])
+		{
+			break;
+		}
+
+		++next_seq[id];
+	}
+
+	if (total == i)
+	{ ++tcounter; }
+
+	/* The reader never saw an unwritten element below the published size */
+	if (0 == reader.m_bad_reads && total == reader.m_last_size)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Concurrent Push");
+
+	ConcVectorDestroy(vector);
+}
+
+
+/* Values are (thread id + 1) << 32 | sequence, never 0 */
+static void *PushAllIMP(void *param_)
+{
+	pusher_ty *pusher = (pusher_ty *)param_;
+	size_t value = 0;
+	size_t i = 0;
+
+	for (i = 0; i < PUSHES_PER_THREAD; ++i)
+	{
+		value = ((pusher->m_id + 1) << SEQ_BITS) | i;
+		ConcVectorPushBack(pusher->m_vector, &value);
+	}
+
+	return NULL;
+}
+
+static void *ReadAllIMP(void *param_)
+{
+	reader_ty *reader = (reader_ty *)param_;
+	size_t total = THREADS_NUM * PUSHES_PER_THREAD;
+	size_t size = 0;
+	size_t checked = 0;
+	size_t value = 0;
+
+	while (size < total)
+	{
+		size = ConcVectorSize(reader->m_vector);
+
+		for (; checked < size; ++checked)
+		{
+			ConcVectorGet(reader->m_vector, checked, &value);
+			reader->m_bad_reads += (0 == value);
+		}
+	}
+
+	reader->m_last_size = size;
+
+	return NULL;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -0,0 +1,257 @@
+/*******************************************************************************
+****************************** - FILE VECTOR - *********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests File Vector
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t, remove, fopen */
+
+#include "utilities.h"
+#include "file_vector.h"
+
+#define FILE_PATH		"file_vector_test.bin"
+#define ELEMENTS_NUM	100000LU
+
+typedef struct record
+{
+	size_t m_offset;
+	int m_length;
+} record_ty;
+
+
+void TestFileVectorCreate(void);
+void TestFileVectorPushGet(void);
+void TestFileVectorReopen(void);
+void TestFileVectorResize(void);
+void TestFileVectorBadFile(void);
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests File Vector ---\n);
+
+	TestFileVectorCreate();
+	TestFileVectorPushGet();
+	TestFileVectorReopen();
+	TestFileVectorResize();
+	TestFileVectorBadFile();
+
+	remove(FILE_PATH);
+
+	return 0;
+}
+
+
+void TestFileVectorCreate(void)
+{
+	file_vector_ty *vector = FileVectorCreate(FILE_PATH, sizeof(record_ty));
+	size_t tcounter = 0;
+
+	if (NULL != vector && 0 == FileVectorSize(vector) &&
+	    0 != FileVectorCapacity(vector) &&
+	    sizeof(record_ty) == FileVectorElementSize(vector))
+	{ ++tcounter; }
+
+	FileVectorDestroy(vector);
+
+	vector = FileVectorOpen(FILE_PATH, FILE_VECTOR_READ_ONLY);
+
+	if (NULL != vector && 0 == FileVectorSize(vector))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create / Open");
+
+	FileVectorDestroy(vector);
+}
+
+
+void TestFileVectorPushGet(void)
+{
+	file_vector_ty *vector = FileVectorCreate(FILE_PATH, sizeof(record_ty));
+	record_ty record = {0, 0};
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < ELEMENTS_NUM; ++i)
+	{
+		record.m_offset = i * 10;
+		record.m_length = (int)i;
+
+		if (SUCCESS != FileVectorPushBack(vector, &record))
+		{
+			break;
+		}
+	}
+
+	if (ELEMENTS_NUM == i && ELEMENTS_NUM == FileVectorSize(vector) &&
+	    ELEMENTS_NUM <= FileVectorCapacity(vector))
+	{ ++tcounter; }
+
+	for (i = 0; i < ELEMENTS_NUM; ++i)
+	{
+		FileVectorGet(vector, i, &record);
+
+		if (record.m_offset != i * 10 || record.m_length != (int)i)
+		{
+			break;
+		}
+	}
+
+	if (ELEMENTS_NUM == i &&
+	    (record_ty *)FileVectorData(vector) + 5 == FileVectorAt(vector, 5))
+	{ ++tcounter; }
+
+	record.m_length = -1;
+	FileVectorSet(vector, 7, &record);
+	FileVectorPopBack(vector, &record);
+
+	if ((int)ELEMENTS_NUM - 1 == record.m_length &&
+	    -1 == ((record_ty *)FileVectorAt(vector, 7))->m_length &&
+	    ELEMENTS_NUM - 1 == FileVectorSize(vector))
+	{ ++tcounter; }
+
+	if (SUCCESS == FileVectorSync(vector))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "PushBack / Get / Set / PopBack / Sync");
+
+	FileVectorDestroy(vector);
+}
+
+
+/* Continues from the file TestFileVectorPushGet left */
+void TestFileVectorReopen(void)
+{
+	file_vector_ty *vector = FileVectorOpen(FILE_PATH, FILE_VECTOR_READ_ONLY);
+	record_ty record = {0, 0};
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == vector)
+	{
+		PrintTestStatusIMP(tcounter, 3, "Reopen");
+		return;
+	}
+
+	for (i = 0; i < FileVectorSize(vector); ++i)
+	{
+		FileVectorGet(vector, i, &record);
+
+		/* Element 7 was overwritten before the file was closed */
+		if (7 != i && (record.m_offset != i * 10 || record.m_length != (int)i))
+		{
+			break;
+		}
+	}
+
+	if (ELEMENTS_NUM - 1 == i && sizeof(record_ty) == FileVectorElementSize(vector))
+	{ ++tcounter; }
+
+	FileVectorDestroy(vector);
+
+	vector = FileVectorOpen(FILE_PATH, FILE_VECTOR_READ_WRITE);
+
+	record.m_offset = 42;
+	if (NULL != vector && SUCCESS == FileVectorPushBack(vector, &record))
+	{ ++tcounter; }
+
+	FileVectorDestroy(vector);
+
+	vector = FileVectorOpen(FILE_PATH, FILE_VECTOR_READ_ONLY);
+
+	if (NULL != vector && ELEMENTS_NUM == FileVectorSize(vector) &&
+	    42 == ((record_ty *)FileVectorAt(vector, ELEMENTS_NUM - 1))->m_offset)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Reopen");
+
+	FileVectorDestroy(vector);
+}
+
+
+void TestFileVectorResize(void)
+{
+	file_vector_ty *vector = FileVectorCreate(FILE_PATH, sizeof(size_t));
+	size_t value = 0;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < 100; ++i)
+	{
+		value = i + 1;
+		FileVectorPushBack(vector, &value);
+	}
+
+	FileVectorResize(vector, 10);
+
+	/* Reused slots and new file pages are both zero */
+	if (SUCCESS == FileVectorResize(vector, 50000) && 50000 == FileVectorSize(vector))
+	{ ++tcounter; }
+
+	for (i = 10; i < 50000 && 0 == *(size_t *)FileVectorAt(vector, i); ++i)
+	{
+		/* empty */
+	}
+
+	if (50000 == i && 10 == *(size_t *)FileVectorAt(vector, 9))
+	{ ++tcounter; }
+
+	if (SUCCESS == FileVectorReserve(vector, 1000000) &&
+	    1000000 <= FileVectorCapacity(vector) && 50000 == FileVectorSize(vector))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Resize / Reserve");
+
+	FileVectorDestroy(vector);
+}
+
+
+void TestFileVectorBadFile(void)
+{
+	FILE *file = fopen(FILE_PATH, "w");
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == FileVectorOpen("no_such_dir/no_such_file.bin", FILE_VECTOR_READ_ONLY))
+	{ ++tcounter; }
+
+	/* Long enough for a header, without the magic */
+	for (i = 0; i < 200 && NULL != file; ++i)
+	{
+		fputc('x', file);
+	}
+
+	if (NULL != file)
+	{
+		fclose(file);
+	}
+
+	if (NULL == FileVectorOpen(FILE_PATH, FILE_VECTOR_READ_ONLY))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Bad File");
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -0,0 +1,239 @@
+/*******************************************************************************
+****************************** - FORK JOIN - ***********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Fork-Join Task Pool
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+
+#include "utilities.h"
+#include "fork_join.h"
+
+#define FIB_N			24LU
+#define RANGE			1000000LU
+#define LEAF			1000LU
+
+typedef struct fib
+{
+	size_t m_n;
+	size_t m_result;
+} fib_ty;
+
+typedef struct range
+{
+	size_t m_from;
+	size_t m_to;
+	size_t m_sum;
+} range_ty;
+
+
+void TestForkJoinCreate(void);
+void TestForkJoinFib(void);
+void TestForkJoinRangeSum(void);
+
+static void FibIMP(fork_join_worker_ty *worker_, void *param_);
+static size_t SerialFibIMP(size_t n_);
+static void RangeSumIMP(fork_join_worker_ty *worker_, void *param_);
+static void CountIMP(fork_join_worker_ty *worker_, void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Fork Join ---\n);
+
+	TestForkJoinCreate();
+	TestForkJoinFib();
+	TestForkJoinRangeSum();
+
+	return 0;
+}
+
+
+void TestForkJoinCreate(void)
+{
+	fork_join_ty *pool = ForkJoinCreate(3);
+	fork_join_ty *per_cpu = ForkJoinCreate(0);
+	size_t count = 0;
+	size_t tcounter = 0;
+
+	if (NULL != pool && 3 == ForkJoinThreads(pool) &&
+	    NULL != per_cpu && 0 < ForkJoinThreads(per_cpu))
+	{ ++tcounter; }
+
+	/* A task without subtasks, several runs on the same pool */
+	ForkJoinRun(pool, CountIMP, &count);
+	ForkJoinRun(pool, CountIMP, &count);
+	ForkJoinRun(per_cpu, CountIMP, &count);
+
+	if (3 == count)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create / Run");
+
+	ForkJoinDestroy(per_cpu);
+	ForkJoinDestroy(pool);
+}
+
+
+void TestForkJoinFib(void)
+{
+	fork_join_ty *pool = ForkJoinCreate(4);
+	fib_ty fib;
+	size_t expected = SerialFibIMP(FIB_N);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == pool)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	/* Tens of thousands of tiny tasks, deep forks, on a reused pool */
+	for (i = 0; i < 5; ++i)
+	{
+		fib.m_n = FIB_N;
+		fib.m_result = 0;
+		ForkJoinRun(pool, FibIMP, &fib);
+
+		if (expected != fib.m_result)
+		{
+			break;
+		}
+	}
+
+	if (5 == i)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 1, "Fibonacci");
+
+	ForkJoinDestroy(pool);
+}
+
+
+void TestForkJoinRangeSum(void)
+{
+	size_t threads[] = { 1, 2, 8 };
+	fork_join_ty *pool = NULL;
+	range_ty range;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i)
+	{
+		pool = ForkJoinCreate(threads[i]);
+
+		if (NULL == pool)
+		{
+			puts("Memory Allocation Failed");
+			return;
+		}
+
+		range.m_from = 1;
+		range.m_to = RANGE + 1;
+		range.m_sum = 0;
+		ForkJoinRun(pool, RangeSumIMP, &range);
+
+		if (RANGE * (RANGE + 1) / 2 == range.m_sum)
+		{ ++tcounter; }
+
+		ForkJoinDestroy(pool);
+	}
+
+	PrintTestStatusIMP(tcounter, 3, "Range Sum");
+}
+
+
+/* Forks fib(n - 1), computes fib(n - 2) itself, then joins */
+static void FibIMP(fork_join_worker_ty *worker_, void *param_)
+{
+	fib_ty *fib = (fib_ty *)param_;
+	fork_join_task_ty task;
+	fib_ty left;
+	fib_ty right;
+
+	if (2 > fib->m_n)
+	{
+		fib->m_result = fib->m_n;
+		return;
+	}
+
+	left.m_n = fib->m_n - 1;
+	right.m_n = fib->m_n - 2;
+
+	ForkJoinFork(worker_, &task, FibIMP, &left);
+	FibIMP(worker_, &right);
+	ForkJoinJoin(worker_, &task);
+
+	fib->m_result = left.m_result + right.m_result;
+}
+
+
+static size_t SerialFibIMP(size_t n_)
+{
+	return (2 > n_) ? n_ : SerialFibIMP(n_ - 1) + SerialFibIMP(n_ - 2);
+}
+
+
+/* Sums [from, to), halving the range down to LEAF numbers */
+static void RangeSumIMP(fork_join_worker_ty *worker_, void *param_)
+{
+	range_ty *range = (range_ty *)param_;
+	fork_join_task_ty task;
+	range_ty halves[2];
+	size_t i = 0;
+
+	if (range->m_to - range->m_from <= LEAF)
+	{
+		for (i = range->m_from; i < range->m_to; ++i)
+		{
+			range->m_sum += i;
+		}
+
+		return;
+	}
+
+	halves[0].m_from = range->m_from;
+	halves[0].m_to = range->m_from + (range->m_to - range->m_from) / 2;
+	halves[0].m_sum = 0;
+	halves[1].m_from = halves[0].m_to;
+	halves[1].m_to = range->m_to;
+	halves[1].m_sum = 0;
+
+	ForkJoinFork(worker_, &task, RangeSumIMP, &halves[0]);
+	RangeSumIMP(worker_, &halves[1]);
+	ForkJoinJoin(worker_, &task);
+
+	range->m_sum += halves[0].m_sum + halves[1].m_sum;
+}
+
+
+static void CountIMP(fork_join_worker_ty *worker_, void *param_)
+{
+	UNUSED(worker_);
+
+	++*(size_t *)param_;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
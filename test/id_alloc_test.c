@@ -0,0 +1,215 @@
+/*******************************************************************************
+****************************** - ID ALLOCATOR - ********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests ID allocator
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+
+#include "utilities.h"
+#include "id_alloc.h"
+
+#define CAPACITY		300000LU	/* three levels, partial last words */
+
+
+void TestIDAllocCreate(void);
+void TestIDAllocAlloc(void);
+void TestIDAllocFree(void);
+void TestIDAllocRange(void);
+void TestIDAllocSmall(void);
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests ID Allocator ---\n);
+
+	TestIDAllocCreate();
+	TestIDAllocAlloc();
+	TestIDAllocFree();
+	TestIDAllocRange();
+	TestIDAllocSmall();
+
+	return 0;
+}
+
+
+void TestIDAllocCreate(void)
+{
+	id_alloc_ty *id_alloc = IDAllocCreate(CAPACITY);
+	size_t tcounter = 0;
+
+	if (NULL == id_alloc)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	if (CAPACITY == IDAllocCapacity(id_alloc) && 0 == IDAllocCount(id_alloc))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 1, "Create");
+
+	IDAllocDestroy(id_alloc);
+}
+
+
+void TestIDAllocAlloc(void)
+{
+	id_alloc_ty *id_alloc = IDAllocCreate(CAPACITY);
+	size_t mismatches = 0;
+	size_t i = 0;
+
+	if (NULL == id_alloc)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	/* IDs are handed out lowest first, until the allocator is full */
+	for (i = 0; i < CAPACITY; ++i)
+	{
+		if (i != IDAllocAlloc(id_alloc))
+		{
+			++mismatches;
+		}
+	}
+
+	if (CAPACITY != IDAllocAlloc(id_alloc) || CAPACITY != IDAllocCount(id_alloc))
+	{
+		++mismatches;
+	}
+
+	PrintTestStatusIMP(0 == mismatches, 1, "Alloc");
+
+	IDAllocDestroy(id_alloc);
+}
+
+
+void TestIDAllocFree(void)
+{
+	id_alloc_ty *id_alloc = IDAllocCreate(CAPACITY);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == id_alloc)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < CAPACITY; ++i)
+	{
+		IDAllocAlloc(id_alloc);
+	}
+
+	IDAllocFree(id_alloc, 250000);
+	IDAllocFree(id_alloc, 4096);
+	IDAllocFree(id_alloc, CAPACITY - 1);
+
+	if (0 == IDAllocIsUsed(id_alloc, 4096) && 1 == IDAllocIsUsed(id_alloc, 4097))
+	{ ++tcounter; }
+
+	if (4096 == IDAllocAlloc(id_alloc) && 250000 == IDAllocAlloc(id_alloc) &&
+		CAPACITY - 1 == IDAllocAlloc(id_alloc) && CAPACITY == IDAllocAlloc(id_alloc))
+	{ ++tcounter; }
+
+	if (CAPACITY == IDAllocCount(id_alloc))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Free");
+
+	IDAllocDestroy(id_alloc);
+}
+
+
+void TestIDAllocRange(void)
+{
+	id_alloc_ty *id_alloc = IDAllocCreate(CAPACITY);
+	size_t tcounter = 0;
+	size_t first = 0;
+
+	if (NULL == id_alloc)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	if (0 == IDAllocAllocRange(id_alloc, 100) && 100 == IDAllocAllocRange(id_alloc, 5000))
+	{ ++tcounter; }
+
+	/* Leave a hole of 50 IDs, too small for 60 */
+	IDAllocFreeRange(id_alloc, 1000, 50);
+	first = IDAllocAllocRange(id_alloc, 60);
+
+	if (5100 == first && 1000 == IDAllocAllocRange(id_alloc, 50))
+	{ ++tcounter; }
+
+	if (5160 == IDAllocAlloc(id_alloc) && 5161 == IDAllocCount(id_alloc))
+	{ ++tcounter; }
+
+	if (CAPACITY == IDAllocAllocRange(id_alloc, CAPACITY) &&
+		5161 == IDAllocAllocRange(id_alloc, CAPACITY - 5161))
+	{ ++tcounter; }
+
+	if (CAPACITY == IDAllocCount(id_alloc) && CAPACITY == IDAllocAlloc(id_alloc))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 5, "Alloc / Free Range");
+
+	IDAllocDestroy(id_alloc);
+}
+
+
+void TestIDAllocSmall(void)
+{
+	id_alloc_ty *id_alloc = IDAllocCreate(10);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == id_alloc)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < 10; ++i)
+	{
+		IDAllocAlloc(id_alloc);
+	}
+
+	if (10 == IDAllocAlloc(id_alloc))
+	{ ++tcounter; }
+
+	IDAllocFree(id_alloc, 7);
+
+	if (7 == IDAllocAlloc(id_alloc))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Single Level");
+
+	IDAllocDestroy(id_alloc);
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -0,0 +1,265 @@
+/*******************************************************************************
+************************** - MULTI PRODUCER QUEUE - ****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Multi Producer / Multi Consumer Queue
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <pthread.h>	/* pthread_create, pthread_join */
+
+#include "utilities.h"
+#include "mpmc_queue.h"
+
+#define PRODUCERS		4LU
+#define CONSUMERS		4LU
+#define PER_PRODUCER	200000LU
+#define ID_SHIFT		32
+
+typedef struct producer
+{
+	mpmc_queue_ty *m_queue;
+	size_t m_id;
+} producer_ty;
+
+typedef struct consumer
+{
+	mpmc_queue_ty *m_queue;
+	size_t m_last[PRODUCERS];		/* Last sequence + 1 seen per producer */
+	size_t m_received;
+	size_t m_out_of_order;
+} consumer_ty;
+
+
+void TestMpmcQueueCreate(void);
+void TestMpmcQueueEnqueueDequeue(void);
+void TestMpmcQueueThreads(void);
+
+static void *ProduceIMP(void *param_);
+static void *ConsumeIMP(void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests MPMC Queue ---\n);
+
+	TestMpmcQueueCreate();
+	TestMpmcQueueEnqueueDequeue();
+	TestMpmcQueueThreads();
+
+	return 0;
+}
+
+
+void TestMpmcQueueCreate(void)
+{
+	mpmc_queue_ty *queue = MpmcQueueCreate(100);
+	mpmc_queue_ty *tiny = MpmcQueueCreate(0);
+	void *element = NULL;
+	size_t tcounter = 0;
+
+	if (NULL != queue && 128 == MpmcQueueCapacity(queue) && 0 == MpmcQueueSize(queue))
+	{ ++tcounter; }
+
+	if (SUCCESS != MpmcQueueTryDequeue(queue, &element) &&
+	    NULL != tiny && 2 == MpmcQueueCapacity(tiny))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create");
+
+	MpmcQueueDestroy(tiny);
+	MpmcQueueDestroy(queue);
+}
+
+
+void TestMpmcQueueEnqueueDequeue(void)
+{
+	mpmc_queue_ty *queue = MpmcQueueCreate(8);
+	void *element = NULL;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < 8 && SUCCESS == MpmcQueueTryEnqueue(queue, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	if (8 == i && 8 == MpmcQueueSize(queue) && SUCCESS != MpmcQueueTryEnqueue(queue, NULL))
+	{ ++tcounter; }
+
+	/* FIFO order, every slot reused many times, try and blocking calls mixed */
+	for (i = 0; i < 100; ++i)
+	{
+		element = (0 == i % 2) ? MpmcQueueDequeue(queue) : NULL;
+
+		if (0 != i % 2 && SUCCESS != MpmcQueueTryDequeue(queue, &element))
+		{
+			break;
+		}
+
+		if ((void *)i != element)
+		{
+			break;
+		}
+
+		MpmcQueueEnqueue(queue, (void *)(i + 8));
+	}
+
+	if (100 == i && 8 == MpmcQueueSize(queue))
+	{ ++tcounter; }
+
+	for (i = 0; i < 8 && SUCCESS == MpmcQueueTryDequeue(queue, &element); ++i)
+	{
+		/* empty */
+	}
+
+	if (8 == i && (void *)107 == element && 0 == MpmcQueueSize(queue) &&
+	    SUCCESS != MpmcQueueTryDequeue(queue, &element))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Enqueue / Dequeue");
+
+	MpmcQueueDestroy(queue);
+}
+
+
+void TestMpmcQueueThreads(void)
+{
+	mpmc_queue_ty *queue = MpmcQueueCreate(64);
+	pthread_t producer_threads[PRODUCERS];
+	pthread_t consumer_threads[CONSUMERS];
+	producer_ty producers[PRODUCERS];
+	consumer_ty consumers[CONSUMERS];
+	size_t received = 0;
+	size_t out_of_order = 0;
+	size_t tcounter = 0;
+	size_t i = 0;
+	size_t j = 0;
+
+	if (NULL == queue)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 0; i < CONSUMERS; ++i)
+	{
+		consumers[i].m_queue = queue;
+		consumers[i].m_received = 0;
+		consumers[i].m_out_of_order = 0;
+
+		for (j = 0; j < PRODUCERS; ++j)
+		{
+			consumers[i].m_last[j] = 0;
+		}
+
+		pthread_create(&consumer_threads[i], NULL, ConsumeIMP, &consumers[i]);
+	}
+
+	for (i = 0; i < PRODUCERS; ++i)
+	{
+		producers[i].m_queue = queue;
+		producers[i].m_id = i;
+		pthread_create(&producer_threads[i], NULL, ProduceIMP, &producers[i]);
+	}
+
+	for (i = 0; i < PRODUCERS; ++i)
+	{
+		pthread_join(producer_threads[i], NULL);
+	}
+
+	/* One NULL per consumer tells it to stop */
+	for (i = 0; i < CONSUMERS; ++i)
+	{
+		MpmcQueueEnqueue(queue, NULL);
+	}
+
+	for (i = 0; i < CONSUMERS; ++i)
+	{
+		pthread_join(consumer_threads[i], NULL);
+		received += consumers[i].m_received;
+		out_of_order += consumers[i].m_out_of_order;
+	}
+
+	if (PRODUCERS * PER_PRODUCER == received && 0 == MpmcQueueSize(queue))
+	{ ++tcounter; }
+
+	/* Each consumer sees every producer's elements in the order sent */
+	if (0 == out_of_order)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Producer / Consumer Threads");
+
+	MpmcQueueDestroy(queue);
+}
+
+
+/* Sends (id << 32 | sequence) + 1 for sequences 0 .. PER_PRODUCER - 1 */
+static void *ProduceIMP(void *param_)
+{
+	producer_ty *producer = (producer_ty *)param_;
+	size_t element = 0;
+	size_t i = 0;
+
+	for (i = 0; i < PER_PRODUCER; ++i)
+	{
+		element = ((producer->m_id << ID_SHIFT) | i) + 1;
+
+		/* Odd sequences try first, falling back to the blocking call */
+		if (0 == i % 2 || SUCCESS != MpmcQueueTryEnqueue(producer->m_queue, (void *)element))
+		{
+			MpmcQueueEnqueue(producer->m_queue, (void *)element);
+		}
+	}
+
+	return NULL;
+}
+
+
+static void *ConsumeIMP(void *param_)
+{
+	consumer_ty *consumer = (consumer_ty *)param_;
+	size_t element = 0;
+	size_t id = 0;
+	size_t sequence = 0;
+
+	while (0 != (element = (size_t)MpmcQueueDequeue(consumer->m_queue)))
+	{
+		--element;
+		id = element >> ID_SHIFT;
+		sequence = element & ((1LU << ID_SHIFT) - 1);
+
+		consumer->m_out_of_order += (PRODUCERS <= id || sequence < consumer->m_last[id]);
+
+		if (PRODUCERS > id)
+		{
+			consumer->m_last[id] = sequence + 1;
+		}
+
+		++consumer->m_received;
+	}
+
+	return NULL;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -19,6 +19,7 @@ void TestQueueEnqueue(void);
 void TestQueueDequeue(void);
 void TestQueueIsEmpty(void);
 void TestQueueAppend(void);
+void TestQueueRing(void);
 
 /*side function*/
 void PrintQueue(queue_ty *queue);
@@ -29,6 +30,7 @@ int main(void)
 	TestQueueEnqueue();
 	TestQueueDequeue();
 	TestQueueIsEmpty();
+	TestQueueRing();
 /*	TestQueueAppend();*/
 	
 	return 0;
@@ -197,6 +199,74 @@ void TestQueueIsEmpty(void)
 	QueueDestroy(new_queue);
 }
 
+
+void TestQueueRing(void)
+{
+	queue_ty *new_queue = QueueCreateRing(5);
+	size_t i = 0;
+	size_t expected = 0;
+	int in_order = 1;
+	
+	if (NULL == new_queue)
+	{
+		RED;
+		puts("- Queu Creation Fail -");
+		DEFAULT;
+		return;
+	}
+	
+	puts("\n ----- Test QueueCreateRing -----");
+	
+	printf("Queu capacity = %lu\n", QueueCapacity(new_queue));
+	
+	/* Wraps around the ring several times before it has to grow */
+	for (i = 0; i < 100; ++i)
+	{
+		QueueEnqueue(new_queue, (void *)i);
+		QueueEnqueue(new_queue, (void *)(i + 1000));
+		
+		in_order = in_order && (void *)expected == QueuePeek(new_queue);
+		QueueDequeue(new_queue);
+		expected = (expected < 1000) ? expected + 1000 : expected - 999;
+	}
+	
+	/* Grows from 8 slots while the front is in the middle of the ring */
+	for (i = 0; i < 100000; ++i)
+	{
+		QueueEnqueue(new_queue, (void *)(i + 2000));
+	}
+	
+	printf("Queu size = %lu capacity = %lu\n", QueueSize(new_queue),
+	       QueueCapacity(new_queue));
+	
+	while (QueueSize(new_queue) > 100000)
+	{
+		in_order = in_order && (void *)expected == QueuePeek(new_queue);
+		QueueDequeue(new_queue);
+		expected = (expected < 1000) ? expected + 1000 : expected - 999;
+	}
+	
+	for (i = 0; i < 100000; ++i)
+	{
+		in_order = in_order && (void *)(i + 2000) == QueuePeek(new_queue);
+		QueueDequeue(new_queue);
+	}
+	
+	if (in_order && QueueIsEmpty(new_queue))
+	{
+		GREEN;
+		puts("\t- Success -");
+	}
+	else
+	{
+		RED;
+		puts("\t- Failure -");
+	}
+	
+	DEFAULT;
+	QueueDestroy(new_queue);
+}
+
 /*
 void TestQueueAppend(void)
 {	
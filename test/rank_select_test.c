@@ -0,0 +1,271 @@
+/*******************************************************************************
+****************************** - RANK SELECT - *********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Rank / Select directory
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <stdlib.h>		/* rand, srand */
+
+#include "utilities.h"
+#include "bitset.h"
+#include "rank_select.h"
+
+#define BITS_NUM		300000LU	/* a few super blocks and a partial one */
+
+
+void TestRankSelectCreate(void);
+void TestRankSelectRank(void);
+void TestRankSelectSelect(void);
+void TestRankSelectRefresh(void);
+
+static void FillBitSetIMP(bitset_ty *bitset_);
+static size_t NaiveSelectIMP(const bitset_ty *bitset_, size_t k_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Rank Select ---\n);
+
+	srand(1234);
+
+	TestRankSelectCreate();
+	TestRankSelectRank();
+	TestRankSelectSelect();
+	TestRankSelectRefresh();
+
+	return 0;
+}
+
+
+void TestRankSelectCreate(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	rank_select_ty *rank_select = NULL;
+	size_t tcounter = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	rank_select = RankSelectCreate(bitset);
+
+	if (NULL != rank_select && 0 == RankSelectCountOn(rank_select) &&
+		BITS_NUM == RankSelectSelect(rank_select, 0))
+	{ ++tcounter; }
+
+	RankSelectDestroy(rank_select);
+
+	FillBitSetIMP(bitset);
+	rank_select = RankSelectCreate(bitset);
+
+	if (NULL != rank_select && BitSetCountOn(bitset) == RankSelectCountOn(rank_select))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create");
+
+	RankSelectDestroy(rank_select);
+	BitSetDestroy(bitset);
+}
+
+
+void TestRankSelectRank(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	rank_select_ty *rank_select = NULL;
+	size_t expected = 0;
+	size_t mismatches = 0;
+	size_t i = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	FillBitSetIMP(bitset);
+	rank_select = RankSelectCreate(bitset);
+
+	/* Compare each rank with a running count, including index == size */
+	for (i = 0; i <= BITS_NUM; ++i)
+	{
+		if (expected != RankSelectRank(rank_select, i) ||
+			i - expected != RankSelectRankOff(rank_select, i))
+		{
+			++mismatches;
+		}
+
+		if (i < BITS_NUM)
+		{
+			expected += BitSetGetVal(bitset, i);
+		}
+	}
+
+	PrintTestStatusIMP(0 == mismatches, 1, "Rank");
+
+	RankSelectDestroy(rank_select);
+	BitSetDestroy(bitset);
+}
+
+
+void TestRankSelectSelect(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	rank_select_ty *rank_select = NULL;
+	size_t k = 0;
+	size_t index = 0;
+	size_t mismatches = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	FillBitSetIMP(bitset);
+	rank_select = RankSelectCreate(bitset);
+
+	/* The k-th set bit is the k-th index with GetVal 1 */
+	for (index = 0; index < BITS_NUM; ++index)
+	{
+		if (BitSetGetVal(bitset, index))
+		{
+			if (index != RankSelectSelect(rank_select, k))
+			{
+				++mismatches;
+			}
+			++k;
+		}
+	}
+
+	if (BITS_NUM != RankSelectSelect(rank_select, k))
+	{
+		++mismatches;
+	}
+
+	PrintTestStatusIMP(0 == mismatches, 1, "Select");
+
+	RankSelectDestroy(rank_select);
+	BitSetDestroy(bitset);
+}
+
+
+void TestRankSelectRefresh(void)
+{
+	bitset_ty *bitset = BitSetCreate(BITS_NUM);
+	rank_select_ty *rank_select = NULL;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == bitset)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	FillBitSetIMP(bitset);
+	rank_select = RankSelectCreate(bitset);
+
+	/* Batch update in the middle of the set */
+	for (i = 70000; i < 90000; ++i)
+	{
+		BitSetSetOn(bitset, i);
+	}
+
+	if (SUCCESS == RankSelectRefresh(rank_select, 70000, 90000))
+	{ ++tcounter; }
+
+	if (BitSetCountOn(bitset) == RankSelectCountOn(rank_select))
+	{ ++tcounter; }
+
+	if (20000 == RankSelectRank(rank_select, 90000) - RankSelectRank(rank_select, 70000))
+	{ ++tcounter; }
+
+	for (i = 0; i < BitSetCountOn(bitset); i += 997)
+	{
+		if (NaiveSelectIMP(bitset, i) != RankSelectSelect(rank_select, i))
+		{
+			break;
+		}
+	}
+
+	if (i >= BitSetCountOn(bitset))
+	{ ++tcounter; }
+
+	/* Clear a whole region */
+	for (i = 0; i < BITS_NUM / 2; ++i)
+	{
+		BitSetSetOff(bitset, i);
+	}
+
+	RankSelectRefresh(rank_select, 0, BITS_NUM / 2);
+
+	if (0 == RankSelectRank(rank_select, BITS_NUM / 2) &&
+		BitSetCountOn(bitset) == RankSelectCountOn(rank_select) &&
+		NaiveSelectIMP(bitset, 0) == RankSelectSelect(rank_select, 0))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 5, "Refresh");
+
+	RankSelectDestroy(rank_select);
+	BitSetDestroy(bitset);
+}
+
+
+/* Dense and sparse regions */
+static void FillBitSetIMP(bitset_ty *bitset_)
+{
+	size_t i = 0;
+
+	for (i = 0; i < BITS_NUM; ++i)
+	{
+		if ((i < 100000 && 0 == rand() % 3) || (i >= 100000 && 0 == rand() % 500))
+		{
+			BitSetSetOn(bitset_, i);
+		}
+	}
+}
+
+static size_t NaiveSelectIMP(const bitset_ty *bitset_, size_t k_)
+{
+	size_t i = 0;
+
+	for (i = 0; i < BitSetSize(bitset_); ++i)
+	{
+		if (BitSetGetVal(bitset_, i))
+		{
+			if (0 == k_)
+			{
+				return i;
+			}
+			--k_;
+		}
+	}
+
+	return BitSetSize(bitset_);
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -0,0 +1,369 @@
+/*******************************************************************************
+***************************** - ROARING BITMAP - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests roaring bitmap
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <stdlib.h>		/* rand, srand */
+
+#include "utilities.h"
+#include "bitset.h"
+#include "roaring.h"
+
+#define UNIVERSE		(8 * 65536LU)	/* eight chunks */
+
+
+void TestRoaringAddRemove(void);
+void TestRoaringConversions(void);
+void TestRoaringRuns(void);
+void TestRoaringSetOperations(void);
+
+static void FillMixedIMP(roaring_ty *roaring_, bitset_ty *reference_);
+static int IsEqualIMP(const roaring_ty *roaring_, const bitset_ty *reference_);
+static int CompareActionIMP(size_t value_, void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+/* Walks the reference bit set along RoaringForEach */
+typedef struct compare_state
+{
+	const bitset_ty *m_reference;
+	size_t m_expected;
+} compare_state_ty;
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Roaring Bitmap ---\n);
+
+	TestRoaringAddRemove();
+	TestRoaringConversions();
+	TestRoaringRuns();
+	TestRoaringSetOperations();
+
+	return 0;
+}
+
+
+void TestRoaringAddRemove(void)
+{
+	roaring_ty *roaring = RoaringCreate();
+	size_t tcounter = 0;
+
+	if (NULL == roaring)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	if (0 == RoaringCardinality(roaring) && 0 == RoaringContains(roaring, 7))
+	{ ++tcounter; }
+
+	RoaringAdd(roaring, 7);
+	RoaringAdd(roaring, 7);
+	RoaringAdd(roaring, 3000000);
+	RoaringAdd(roaring, 65536);
+
+	if (3 == RoaringCardinality(roaring) && RoaringContains(roaring, 7) &&
+		RoaringContains(roaring, 65536) && RoaringContains(roaring, 3000000) &&
+		0 == RoaringContains(roaring, 65537))
+	{ ++tcounter; }
+
+	RoaringRemove(roaring, 65536);
+	RoaringRemove(roaring, 65536);
+	RoaringRemove(roaring, 12345678);
+
+	if (2 == RoaringCardinality(roaring) && 0 == RoaringContains(roaring, 65536))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Add / Remove / Contains");
+
+	RoaringDestroy(roaring);
+}
+
+
+void TestRoaringConversions(void)
+{
+	roaring_ty *roaring = RoaringCreate();
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == roaring)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	/* 4096 values fit an array, the 4097th turns it into a bitset */
+	for (i = 0; i < 100; ++i)
+	{
+		RoaringAdd(roaring, i * 16);
+	}
+
+	if (RoaringMemoryUsage(roaring) < 1024)
+	{ ++tcounter; }
+
+	for (i = 100; i < 4096; ++i)
+	{
+		RoaringAdd(roaring, i * 16);
+	}
+
+	RoaringAdd(roaring, 1);
+
+	if (RoaringMemoryUsage(roaring) >= 8192 && 4097 == RoaringCardinality(roaring) &&
+		RoaringContains(roaring, 1) && RoaringContains(roaring, 16 * 4095))
+	{ ++tcounter; }
+
+	/* And back to an array */
+	RoaringRemove(roaring, 16);
+
+	if (4096 == RoaringCardinality(roaring) && 0 == RoaringContains(roaring, 16) &&
+		RoaringContains(roaring, 1))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Container Conversions");
+
+	RoaringDestroy(roaring);
+}
+
+
+void TestRoaringRuns(void)
+{
+	roaring_ty *roaring = RoaringCreate();
+	bitset_ty *reference = BitSetCreate(UNIVERSE);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == roaring || NULL == reference)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	for (i = 100; i < 60100; ++i)
+	{
+		RoaringAdd(roaring, i);
+		BitSetSetOn(reference, i);
+	}
+
+	RoaringRunOptimize(roaring);
+
+	/* A single run in a single chunk */
+	if (RoaringMemoryUsage(roaring) < 256 && IsEqualIMP(roaring, reference))
+	{ ++tcounter; }
+
+	/* Split, shrink and join runs */
+	RoaringRemove(roaring, 30000);
+	RoaringRemove(roaring, 100);
+	RoaringRemove(roaring, 60099);
+	RoaringAdd(roaring, 60100);
+	RoaringAdd(roaring, 99);
+	BitSetSetOff(reference, 30000);
+	BitSetSetOff(reference, 100);
+	BitSetSetOff(reference, 60099);
+	BitSetSetOn(reference, 60100);
+	BitSetSetOn(reference, 99);
+
+	if (IsEqualIMP(roaring, reference))
+	{ ++tcounter; }
+
+	RoaringAdd(roaring, 30000);
+	BitSetSetOn(reference, 30000);
+
+	if (IsEqualIMP(roaring, reference) && RoaringMemoryUsage(roaring) < 256)
+	{ ++tcounter; }
+
+	/* Many short runs do not stay a run container */
+	for (i = 0; i < 65536; i += 3)
+	{
+		RoaringAdd(roaring, 65536 + i);
+		BitSetSetOn(reference, 65536 + i);
+	}
+
+	RoaringRunOptimize(roaring);
+
+	if (IsEqualIMP(roaring, reference))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "Run Containers");
+
+	RoaringDestroy(roaring);
+	BitSetDestroy(reference);
+}
+
+
+void TestRoaringSetOperations(void)
+{
+	roaring_ty *roaring1 = NULL;
+	roaring_ty *roaring2 = NULL;
+	roaring_ty *result = NULL;
+	bitset_ty *reference1 = BitSetCreate(UNIVERSE);
+	bitset_ty *reference2 = BitSetCreate(UNIVERSE);
+	bitset_ty *expected = BitSetCreate(UNIVERSE);
+	size_t tcounter = 0;
+	size_t round = 0;
+
+	if (NULL == reference1 || NULL == reference2 || NULL == expected)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	srand(7);
+
+	/* Once with arrays / bitsets, once after converting to runs */
+	for (round = 0; round < 2; ++round)
+	{
+		roaring1 = RoaringCreate();
+		roaring2 = RoaringCreate();
+
+		if (NULL == roaring1 || NULL == roaring2)
+		{
+			puts("Memory Allocation Failed");
+			return;
+		}
+
+		BitSetResetAll(reference1);
+		BitSetResetAll(reference2);
+		FillMixedIMP(roaring1, reference1);
+		FillMixedIMP(roaring2, reference2);
+
+		if (1 == round)
+		{
+			RoaringRunOptimize(roaring1);
+			RoaringRunOptimize(roaring2);
+		}
+
+		if (IsEqualIMP(roaring1, reference1) && IsEqualIMP(roaring2, reference2))
+		{ ++tcounter; }
+
+		result = RoaringOr(roaring1, roaring2);
+		BitSetResetAll(expected);
+		BitSetOr(expected, reference1);
+		BitSetOr(expected, reference2);
+
+		if (NULL != result && IsEqualIMP(result, expected))
+		{ ++tcounter; }
+
+		RoaringDestroy(result);
+
+		result = RoaringAnd(roaring1, roaring2);
+		BitSetResetAll(expected);
+		BitSetOr(expected, reference1);
+		BitSetAnd(expected, reference2);
+
+		if (NULL != result && IsEqualIMP(result, expected))
+		{ ++tcounter; }
+
+		RoaringDestroy(result);
+		RoaringDestroy(roaring1);
+		RoaringDestroy(roaring2);
+	}
+
+	PrintTestStatusIMP(tcounter, 6, "Or / And");
+
+	BitSetDestroy(reference1);
+	BitSetDestroy(reference2);
+	BitSetDestroy(expected);
+}
+
+
+/* Chunks of different densities : sparse, dense, long runs and empty */
+static void FillMixedIMP(roaring_ty *roaring_, bitset_ty *reference_)
+{
+	size_t chunk = 0;
+	size_t value = 0;
+	size_t density = 0;
+	size_t i = 0;
+
+	for (chunk = 0; chunk < UNIVERSE / 65536; ++chunk)
+	{
+		density = (size_t)rand() % 4;
+
+		for (i = 0; i < 65536; ++i)
+		{
+			value = chunk * 65536 + i;
+
+			switch (density)
+			{
+				case 0:
+					if (0 == rand() % 200)
+					{
+						RoaringAdd(roaring_, value);
+						BitSetSetOn(reference_, value);
+					}
+					break;
+
+				case 1:
+					if (0 == rand() % 2)
+					{
+						RoaringAdd(roaring_, value);
+						BitSetSetOn(reference_, value);
+					}
+					break;
+
+				case 2:
+					if (0 == (i / 1000) % 2)
+					{
+						RoaringAdd(roaring_, value);
+						BitSetSetOn(reference_, value);
+					}
+					break;
+
+				default:
+					break;
+			}
+		}
+	}
+}
+
+static int IsEqualIMP(const roaring_ty *roaring_, const bitset_ty *reference_)
+{
+	compare_state_ty state;
+
+	state.m_reference = reference_;
+	state.m_expected = BitSetFindFirstSet(reference_);
+
+	if (RoaringCardinality(roaring_) != BitSetCountOn(reference_))
+	{
+		return 0;
+	}
+
+	return (0 == RoaringForEach(roaring_, CompareActionIMP, &state)) &&
+	       (BitSetSize(reference_) == state.m_expected);
+}
+
+static int CompareActionIMP(size_t value_, void *param_)
+{
+	compare_state_ty *state = (compare_state_ty *)param_;
+
+	if (value_ != state->m_expected)
+	{
+		return 1;
+	}
+
+	state->m_expected = BitSetFindNextSet(state->m_reference, value_ + 1);
+
+	return 0;
+}
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
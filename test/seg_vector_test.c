@@ -0,0 +1,300 @@
+/*******************************************************************************
+***************************** - SEGMENTED VECTOR - *****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Segmented Vector
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+
+#include "utilities.h"
+#include "seg_vector.h"
+
+#define ELEMENTS_NUM	100000LU	/* 11 chunks, the last one partial */
+
+typedef struct point
+{
+	int m_x;
+	int m_y;
+} point_ty;
+
+
+void TestSegVectorCreate(void);
+void TestSegVectorPushGet(void);
+void TestSegVectorStableAddress(void);
+void TestSegVectorResize(void);
+void TestSegVectorShrink(void);
+void TestSegVectorTyped(void);
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Segmented Vector ---\n);
+
+	TestSegVectorCreate();
+	TestSegVectorPushGet();
+	TestSegVectorStableAddress();
+	TestSegVectorResize();
+	TestSegVectorShrink();
+	TestSegVectorTyped();
+
+	return 0;
+}
+
+
+void TestSegVectorCreate(void)
+{
+	seg_vector_ty *vector = SegVectorCreate(0, 0);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL != vector && 0 == SegVectorSize(vector) &&
+	    64 == SegVectorCapacity(vector) &&
+	    sizeof(void *) == SegVectorElementSize(vector))
+	{ ++tcounter; }
+
+	SegVectorDestroy(vector);
+
+	/* 64 + 128 + 256 + 512 */
+	vector = SegVectorCreate(500, 300);
+
+	if (NULL != vector && 300 == SegVectorSize(vector) &&
+	    960 == SegVectorCapacity(vector))
+	{ ++tcounter; }
+
+	for (i = 0; i < SegVectorSize(vector) && NULL == SegVectorGet(vector, i); ++i)
+	{
+		/* empty */
+	}
+
+	if (300 == i)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Create");
+
+	SegVectorDestroy(vector);
+}
+
+
+void TestSegVectorPushGet(void)
+{
+	seg_vector_ty *vector = SegVectorCreate(0, 0);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < ELEMENTS_NUM && SUCCESS == SegVectorPushBack(vector, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	if (ELEMENTS_NUM == i && ELEMENTS_NUM == SegVectorSize(vector))
+	{ ++tcounter; }
+
+	for (i = 0; i < ELEMENTS_NUM && (void *)i == SegVectorGet(vector, i); ++i)
+	{
+		/* empty */
+	}
+
+	if (ELEMENTS_NUM == i)
+	{ ++tcounter; }
+
+	/* Chunk edges */
+	SegVectorSet(vector, (void *)1, 63);
+	SegVectorSet(vector, (void *)2, 64);
+	SegVectorSet(vector, (void *)3, 191);
+	SegVectorSet(vector, (void *)4, 192);
+
+	if ((void *)1 == SegVectorGet(vector, 63) && (void *)2 == SegVectorGet(vector, 64) &&
+	    (void *)3 == SegVectorGet(vector, 191) && (void *)4 == SegVectorGet(vector, 192) &&
+	    (void *)62 == SegVectorGet(vector, 62) && (void *)193 == SegVectorGet(vector, 193))
+	{ ++tcounter; }
+
+	/* Pops down to the overwritten elements at the chunk edge */
+	for (i = ELEMENTS_NUM; i > 193 && (void *)(i - 1) == SegVectorPopBack(vector); --i)
+	{
+		/* empty */
+	}
+
+	if (193 == i && (void *)4 == SegVectorPopBack(vector) &&
+	    (void *)3 == SegVectorPopBack(vector) && 191 == SegVectorSize(vector))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "PushBack Get Set PopBack");
+
+	SegVectorDestroy(vector);
+}
+
+
+void TestSegVectorStableAddress(void)
+{
+	seg_vector_ty *vector = SegVectorCreate(0, 0);
+	void **first = NULL;
+	void **middle = NULL;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	SegVectorPushBack(vector, (void *)1);
+	first = (void **)SegVectorAt(vector, 0);
+
+	for (i = 1; i < 1000; ++i)
+	{
+		SegVectorPushBack(vector, (void *)i);
+	}
+	middle = (void **)SegVectorAt(vector, 999);
+
+	for (; i < ELEMENTS_NUM; ++i)
+	{
+		SegVectorPushBack(vector, (void *)i);
+	}
+
+	if (first == (void **)SegVectorAt(vector, 0) && (void *)1 == *first &&
+	    middle == (void **)SegVectorAt(vector, 999) && (void *)999 == *middle)
+	{ ++tcounter; }
+
+	/* Elements of a chunk are contiguous */
+	if ((void **)SegVectorAt(vector, 64) + 127 == (void **)SegVectorAt(vector, 191))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Stable Address");
+
+	SegVectorDestroy(vector);
+}
+
+
+void TestSegVectorResize(void)
+{
+	seg_vector_ty *vector = SegVectorCreate(0, 0);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < 1000; ++i)
+	{
+		SegVectorPushBack(vector, (void *)(i + 1));
+	}
+
+	SegVectorResize(vector, 10);
+
+	if (10 == SegVectorSize(vector) && (void *)10 == SegVectorGet(vector, 9))
+	{ ++tcounter; }
+
+	/* Reused slots and new chunks are both zeroed */
+	if (SUCCESS == SegVectorResize(vector, 5000))
+	{ ++tcounter; }
+
+	for (i = 10; i < 5000 && NULL == SegVectorGet(vector, i); ++i)
+	{
+		/* empty */
+	}
+
+	if (5000 == i && (void *)10 == SegVectorGet(vector, 9) &&
+	    5000 <= SegVectorCapacity(vector))
+	{ ++tcounter; }
+
+	if (SUCCESS == SegVectorReserve(vector, 20000) &&
+	    20000 <= SegVectorCapacity(vector) && 5000 == SegVectorSize(vector))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "Resize Reserve");
+
+	SegVectorDestroy(vector);
+}
+
+
+void TestSegVectorShrink(void)
+{
+	seg_vector_ty *vector = SegVectorCreate(ELEMENTS_NUM, 0);
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < 200; ++i)
+	{
+		SegVectorPushBack(vector, (void *)i);
+	}
+
+	/* 64 + 128 hold 192 elements, 200 need the 256 chunk too */
+	SegVectorShrink(vector);
+
+	if (448 == SegVectorCapacity(vector) && (void *)199 == SegVectorGet(vector, 199))
+	{ ++tcounter; }
+
+	SegVectorResize(vector, 0);
+	SegVectorShrink(vector);
+
+	if (64 == SegVectorCapacity(vector) && 0 == SegVectorSize(vector) &&
+	    SUCCESS == SegVectorPushBack(vector, (void *)7) &&
+	    (void *)7 == SegVectorGet(vector, 0))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Shrink");
+
+	SegVectorDestroy(vector);
+}
+
+
+void TestSegVectorTyped(void)
+{
+	seg_vector_ty *vector = SegVectorCreateTyped(sizeof(point_ty), 0, 0);
+	point_ty point = {0, 0};
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < ELEMENTS_NUM; ++i)
+	{
+		point.m_x = (int)i;
+		point.m_y = -(int)i;
+		SegVectorPushBackValue(vector, &point);
+	}
+
+	for (i = 0; i < ELEMENTS_NUM; ++i)
+	{
+		SegVectorGetValue(vector, i, &point);
+
+		if (point.m_x != (int)i || point.m_y != -(int)i)
+		{
+			break;
+		}
+	}
+
+	if (ELEMENTS_NUM == i && sizeof(point_ty) == SegVectorElementSize(vector))
+	{ ++tcounter; }
+
+	point.m_x = 5;
+	SegVectorSetValue(vector, 77777, &point);
+
+	if (5 == ((point_ty *)SegVectorAt(vector, 77777))->m_x)
+	{ ++tcounter; }
+
+	SegVectorPopBackValue(vector, &point);
+	SegVectorPopBackValue(vector, NULL);
+
+	if ((int)ELEMENTS_NUM - 1 == point.m_x &&
+	    ELEMENTS_NUM - 2 == SegVectorSize(vector))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Typed");
+
+	SegVectorDestroy(vector);
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -0,0 +1,264 @@
+/*******************************************************************************
+************************* - SINGLE PRODUCER QUEUE - ****************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Single Producer / Single Consumer Queue
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <pthread.h>	/* pthread_create, pthread_join */
+
+#include "utilities.h"
+#include "spsc_queue.h"
+
+#define TRANSFERS		1000000LU
+#define BATCH			13LU		/* Not a divisor of the capacity */
+
+typedef struct consumer
+{
+	spsc_queue_ty *m_queue;
+	size_t m_received;
+	size_t m_out_of_order;
+} consumer_ty;
+
+
+void TestSpscQueueCreate(void);
+void TestSpscQueueEnqueueDequeue(void);
+void TestSpscQueueBatch(void);
+void TestSpscQueueTwoThreads(void);
+
+static void *ProduceIMP(void *param_);
+static void *ConsumeIMP(void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests SPSC Queue ---\n);
+
+	TestSpscQueueCreate();
+	TestSpscQueueEnqueueDequeue();
+	TestSpscQueueBatch();
+	TestSpscQueueTwoThreads();
+
+	return 0;
+}
+
+
+void TestSpscQueueCreate(void)
+{
+	spsc_queue_ty *queue = SpscQueueCreate(100);
+	void *element = NULL;
+	size_t tcounter = 0;
+
+	if (NULL != queue && 128 == SpscQueueCapacity(queue) && 0 == SpscQueueSize(queue))
+	{ ++tcounter; }
+
+	if (SUCCESS != SpscQueueDequeue(queue, &element) &&
+	    0 == SpscQueueDequeueN(queue, &element, 1))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create");
+
+	SpscQueueDestroy(queue);
+}
+
+
+void TestSpscQueueEnqueueDequeue(void)
+{
+	spsc_queue_ty *queue = SpscQueueCreate(8);
+	void *element = NULL;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < 8 && SUCCESS == SpscQueueEnqueue(queue, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	if (8 == i && 8 == SpscQueueSize(queue) && SUCCESS != SpscQueueEnqueue(queue, NULL))
+	{ ++tcounter; }
+
+	/* FIFO order, around the end of the ring several times */
+	for (i = 0; i < 100; ++i)
+	{
+		if (SUCCESS != SpscQueueDequeue(queue, &element) || (void *)i != element ||
+		    SUCCESS != SpscQueueEnqueue(queue, (void *)(i + 8)))
+		{
+			break;
+		}
+	}
+
+	if (100 == i && 8 == SpscQueueSize(queue))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Enqueue / Dequeue");
+
+	SpscQueueDestroy(queue);
+}
+
+
+void TestSpscQueueBatch(void)
+{
+	spsc_queue_ty *queue = SpscQueueCreate(16);
+	void *in[BATCH];
+	void *out[BATCH];
+	size_t next_in = 0;
+	size_t next_out = 0;
+	size_t moved = 0;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	/* Batches of 13 in a ring of 16 wrap at a different slot every time.
+		Dequeues take 5 at a time, so the ring fills and EnqueueN is cut short */
+	while (next_out < 1000)
+	{
+		for (i = 0; i < BATCH; ++i)
+		{
+			in[i] = (void *)(next_in + i);
+		}
+
+		next_in += SpscQueueEnqueueN(queue, in, BATCH);
+		moved = SpscQueueDequeueN(queue, out, 5);
+
+		for (i = 0; i < moved && (void *)(next_out + i) == out[i]; ++i)
+		{
+			/* empty */
+		}
+
+		if (i != moved)
+		{
+			break;
+		}
+
+		next_out += moved;
+	}
+
+	if (1000 <= next_out && next_in - next_out == SpscQueueSize(queue))
+	{ ++tcounter; }
+
+	/* Fills up, then a full queue takes none and an empty one gives none */
+	moved = SpscQueueEnqueueN(queue, in, BATCH);
+
+	if (16 == SpscQueueSize(queue) && 0 == SpscQueueEnqueueN(queue, in, BATCH))
+	{ ++tcounter; }
+
+	moved = SpscQueueDequeueN(queue, out, BATCH);
+	moved += SpscQueueDequeueN(queue, out, BATCH);
+
+	if (16 == moved && 0 == SpscQueueDequeueN(queue, out, BATCH))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "EnqueueN / DequeueN");
+
+	SpscQueueDestroy(queue);
+}
+
+
+void TestSpscQueueTwoThreads(void)
+{
+	spsc_queue_ty *queue = SpscQueueCreate(1024);
+	pthread_t producer;
+	pthread_t consumer_thread;
+	consumer_ty consumer;
+	size_t tcounter = 0;
+
+	if (NULL == queue)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	consumer.m_queue = queue;
+	consumer.m_received = 0;
+	consumer.m_out_of_order = 0;
+
+	pthread_create(&consumer_thread, NULL, ConsumeIMP, &consumer);
+	pthread_create(&producer, NULL, ProduceIMP, queue);
+
+	pthread_join(producer, NULL);
+	pthread_join(consumer_thread, NULL);
+
+	if (TRANSFERS == consumer.m_received && 0 == consumer.m_out_of_order &&
+	    0 == SpscQueueSize(queue))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 1, "Producer / Consumer Threads");
+
+	SpscQueueDestroy(queue);
+}
+
+
+/* Sends 0 .. TRANSFERS - 1, alternating single and batched enqueues */
+static void *ProduceIMP(void *param_)
+{
+	spsc_queue_ty *queue = (spsc_queue_ty *)param_;
+	void *batch[BATCH];
+	size_t next = 0;
+	size_t n = 0;
+	size_t i = 0;
+
+	while (next < TRANSFERS)
+	{
+		if (0 == next % 2)
+		{
+			next += (SUCCESS == SpscQueueEnqueue(queue, (void *)next));
+			continue;
+		}
+
+		n = (TRANSFERS - next < BATCH) ? TRANSFERS - next : BATCH;
+
+		for (i = 0; i < n; ++i)
+		{
+			batch[i] = (void *)(next + i);
+		}
+
+		next += SpscQueueEnqueueN(queue, batch, n);
+	}
+
+	return NULL;
+}
+
+
+static void *ConsumeIMP(void *param_)
+{
+	consumer_ty *consumer = (consumer_ty *)param_;
+	void *batch[BATCH];
+	size_t n = 0;
+	size_t i = 0;
+
+	while (consumer->m_received < TRANSFERS)
+	{
+		n = SpscQueueDequeueN(consumer->m_queue, batch,
+		                      1 + consumer->m_received % BATCH);
+
+		for (i = 0; i < n; ++i)
+		{
+			consumer->m_out_of_order += ((void *)consumer->m_received != batch[i]);
+			++consumer->m_received;
+		}
+	}
+
+	return NULL;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
@@ -13,11 +13,15 @@
 #include "stack.h"
 
 void TestStack(void);
+void TestStackGrowth(void);
+void TestStackReserved(void);
 
 int main(void)
 {
 	puts("\n\t~~~~~~~~ Data Structures - Stack ~~~~~~~~\n");
 	TestStack();
+	TestStackGrowth();
+	TestStackReserved();
 	
 	return 0;
 }
@@ -70,3 +74,93 @@ void TestStack(void)
 	StackDestory(stack);
 }
 
+
+void TestStackGrowth(void)
+{
+	size_t elements = 1000000;
+	size_t i = 0;
+	stack_ty *stack = StackCreate(3);
+
+	puts("\n\t -- Push 1000000 elements to a stack of capacity 3 --");
+	for (i = 0; i < elements && 0 == StackPush(stack, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	printf("Amount of elements in Stack => \t%lu\n", StackSize(stack));
+	printf("Capacity of Stack => \t\t%lu\n", StackCapacity(stack));
+
+	/* Going back and forth over a segment boundary reuses the spare segment */
+	while (StackSize(stack) > 3)
+	{
+		StackPop(stack);
+	}
+
+	StackPush(stack, (void *)3);
+	StackPop(stack);
+	StackPush(stack, (void *)3);
+
+	printf("Top Element after crossing a boundary => \t%lu\n",
+	       (size_t)StackPeek(stack));
+
+	puts("\n\t -- Pop all elements, checking their order --");
+	for (i = 4; i > 0 && (size_t)StackPeek(stack) == i - 1; --i)
+	{
+		StackPop(stack);
+	}
+
+	printf("Elements popped in order => \t%s\n", (0 == i) ? "YES" : "NO");
+	printf("Is Stack is empty => \t\t%s\n", (StackIsEmpty(stack)) ? "YES" : "NO");
+
+	StackDestory(stack);
+}
+
+void TestStackReserved(void)
+{
+	size_t elements = 1000000;
+	size_t i = 0;
+	stack_ty *stack = StackCreateReserved(500000000);
+
+	puts("\n\t -- Reserve 500000000 elements, push 1000000 --");
+	for (i = 0; i < elements && 0 == StackPush(stack, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	printf("Amount of elements in Stack => \t%lu\n", StackSize(stack));
+	printf("Capacity of Stack => \t\t%lu\n", StackCapacity(stack));
+
+	/* Popping releases pages, pushing again commits zeroed ones */
+	while (StackSize(stack) > 10)
+	{
+		StackPop(stack);
+	}
+
+	for (i = 10; i < elements && 0 == StackPush(stack, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	puts("\n\t -- Pop all elements, checking their order --");
+	for (i = elements; i > 0 && (size_t)StackPeek(stack) == i - 1; --i)
+	{
+		StackPop(stack);
+	}
+
+	printf("Elements popped in order => \t%s\n", (0 == i) ? "YES" : "NO");
+	printf("Is Stack is empty => \t\t%s\n", (StackIsEmpty(stack)) ? "YES" : "NO");
+
+	StackDestory(stack);
+
+	stack = StackCreateReserved(10);
+
+	puts("\n\t -- Push into a full reserved stack --");
+	for (i = 0; 0 == StackPush(stack, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	printf("Pushes before failing => \t%lu (capacity %lu)\n", i, StackCapacity(stack));
+
+	StackDestory(stack);
+}
@@ -0,0 +1,251 @@
+/*******************************************************************************
+**************************** - PARALLEL VECTOR - *******************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Parallel Vector
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <stdlib.h>		/* rand, srand */
+
+#include "utilities.h"
+#include "vector_parallel.h"
+
+#define ELEMENTS_NUM	100003LU	/* Not a multiple of any thread count */
+#define KEYS_NUM		97
+
+typedef struct item
+{
+	int m_key;
+	size_t m_order;
+} item_ty;
+
+
+void TestVectorParallelSort(void);
+void TestVectorParallelSortValues(void);
+void TestVectorParallelSortSmall(void);
+void TestVectorParallelForEach(void);
+
+static int CmpPointersIMP(const void *data_a_, const void *data_b_, const void *param_);
+static int CmpItemsIMP(const void *data_a_, const void *data_b_, const void *param_);
+static int AddIMP(void *element_, void *param_);
+static int StopAtIMP(void *element_, void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Parallel Vector ---\n);
+
+	srand(5);
+
+	TestVectorParallelSort();
+	TestVectorParallelSortValues();
+	TestVectorParallelSortSmall();
+	TestVectorParallelForEach();
+
+	return 0;
+}
+
+
+void TestVectorParallelSort(void)
+{
+	size_t threads[] = {1, 2, 3, 4, 7, 8, 0};
+	vector_ty *vector = VectorCreate(ELEMENTS_NUM, 0);
+	size_t tcounter = 0;
+	size_t t = 0;
+	size_t i = 0;
+
+	for (t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t)
+	{
+		VectorResize(vector, 0);
+
+		for (i = 0; i < ELEMENTS_NUM; ++i)
+		{
+			VectorPushBack(vector, (void *)(size_t)rand());
+		}
+
+		if (SUCCESS != VectorParallelSort(vector, CmpPointersIMP, NULL, threads[t]))
+		{
+			continue;
+		}
+
+		for (i = 1; i < ELEMENTS_NUM &&
+		     (size_t)VectorGet(vector, i - 1) <= (size_t)VectorGet(vector, i); ++i)
+		{
+			/* empty */
+		}
+
+		if (ELEMENTS_NUM == i && ELEMENTS_NUM == VectorSize(vector))
+		{ ++tcounter; }
+	}
+
+	PrintTestStatusIMP(tcounter, t, "Sort");
+
+	VectorDestroy(vector);
+}
+
+
+/* Few keys, so most elements tie; ties must keep their order */
+void TestVectorParallelSortValues(void)
+{
+	size_t threads[] = {1, 3, 8};
+	vector_ty *vector = VectorCreateTyped(sizeof(item_ty), ELEMENTS_NUM, 0);
+	item_ty item = {0, 0};
+	item_ty *prev = NULL;
+	item_ty *curr = NULL;
+	size_t tcounter = 0;
+	size_t t = 0;
+	size_t i = 0;
+
+	for (t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t)
+	{
+		VectorResize(vector, 0);
+
+		for (i = 0; i < ELEMENTS_NUM; ++i)
+		{
+			item.m_key = rand() % KEYS_NUM;
+			item.m_order = i;
+			VectorPushBackValue(vector, &item);
+		}
+
+		VectorParallelSortValues(vector, CmpItemsIMP, NULL, threads[t]);
+
+		for (i = 1; i < ELEMENTS_NUM; ++i)
+		{
+			prev = (item_ty *)VectorAt(vector, i - 1);
+			curr = (item_ty *)VectorAt(vector, i);
+
+			if (prev->m_key > curr->m_key ||
+			    (prev->m_key == curr->m_key && prev->m_order > curr->m_order))
+			{
+				break;
+			}
+		}
+
+		if (ELEMENTS_NUM == i)
+		{ ++tcounter; }
+	}
+
+	PrintTestStatusIMP(tcounter, t, "Sort Values (stable)");
+
+	VectorDestroy(vector);
+}
+
+
+void TestVectorParallelSortSmall(void)
+{
+	vector_ty *vector = VectorCreate(4, 0);
+	size_t tcounter = 0;
+
+	if (SUCCESS == VectorParallelSort(vector, CmpPointersIMP, NULL, 4))
+	{ ++tcounter; }
+
+	VectorPushBack(vector, (void *)3);
+	VectorPushBack(vector, (void *)1);
+	VectorPushBack(vector, (void *)2);
+
+	if (SUCCESS == VectorParallelSort(vector, CmpPointersIMP, NULL, 4) &&
+	    (void *)1 == VectorGet(vector, 0) && (void *)2 == VectorGet(vector, 1) &&
+	    (void *)3 == VectorGet(vector, 2))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Sort Empty / Small");
+
+	VectorDestroy(vector);
+}
+
+
+void TestVectorParallelForEach(void)
+{
+	vector_ty *vector = VectorCreateTyped(sizeof(size_t), ELEMENTS_NUM, 0);
+	size_t add = 10;
+	size_t stop_at = ELEMENTS_NUM / 2;
+	size_t value = 0;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	for (i = 0; i < ELEMENTS_NUM; ++i)
+	{
+		VectorPushBackValue(vector, &i);
+	}
+
+	if (SUCCESS == VectorParallelForEach(vector, AddIMP, &add, 4))
+	{ ++tcounter; }
+
+	for (i = 0; i < ELEMENTS_NUM && i + add == *(size_t *)VectorAt(vector, i); ++i)
+	{
+		/* empty */
+	}
+
+	if (ELEMENTS_NUM == i)
+	{ ++tcounter; }
+
+	/* Values are now i + 10 */
+	stop_at += add;
+
+	if (SUCCESS != VectorParallelForEach(vector, StopAtIMP, &stop_at, 0))
+	{ ++tcounter; }
+
+	VectorGetValue(vector, ELEMENTS_NUM - 1, &value);
+
+	if (SUCCESS == VectorParallelForEach(vector, AddIMP, &add, 1) &&
+	    ELEMENTS_NUM - 1 + 2 * add == *(size_t *)VectorAt(vector, ELEMENTS_NUM - 1) &&
+	    ELEMENTS_NUM - 1 + add == value)
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 4, "For Each");
+
+	VectorDestroy(vector);
+}
+
+
+static int CmpPointersIMP(const void *data_a_, const void *data_b_, const void *param_)
+{
+	(void)param_;
+
+	return ((size_t)data_a_ > (size_t)data_b_) - ((size_t)data_a_ < (size_t)data_b_);
+}
+
+
+static int CmpItemsIMP(const void *data_a_, const void *data_b_, const void *param_)
+{
+	(void)param_;
+
+	return ((const item_ty *)data_a_)->m_key - ((const item_ty *)data_b_)->m_key;
+}
+
+
+static int AddIMP(void *element_, void *param_)
+{
+	*(size_t *)element_ += *(size_t *)param_;
+
+	return SUCCESS;
+}
+
+
+static int StopAtIMP(void *element_, void *param_)
+{
+	return *(size_t *)element_ == *(size_t *)param_;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}
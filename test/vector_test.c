@@ -20,6 +20,17 @@ void TestVectorReserve(vector_ty *vector);
 void TestVectorPushBack(vector_ty *vector);
 void TestVectorPopBack(vector_ty *vector);
 void TestVectorDestroy(vector_ty *vector);
+void TestVectorTyped(void);
+void TestVectorGrowth(void);
+void TestVectorAutoShrink(void);
+void TestVectorSmall(void);
+void TestVectorBulk(void);
+
+typedef struct point
+{
+	int x;
+	int y;
+} point_ty;
 
 
 int main(void)
@@ -39,6 +50,12 @@ int main(void)
 	TestVectorPopBack(vector);
 	TestVectorDestroy(vector);
 
+	TestVectorTyped();
+	TestVectorGrowth();
+	TestVectorAutoShrink();
+	TestVectorSmall();
+	TestVectorBulk();
+
 	return 0;
 }
 
@@ -178,8 +195,7 @@ void TestVectorPopBack(vector_ty *vector)
 
 		printf("%lu", (i + 1));
 		printf("\t\t%lu", VectorSize(vector));
-/*		printf("\t\t%d\n", popback_ptr);*/
-		printf("\t\t%d\n", *(int *)popback_ptr);
+		printf("\t\t%p\n", popback_ptr);
 	}
 	
 	puts("\nEnd Point");
@@ -195,3 +211,255 @@ void TestVectorDestroy(vector_ty *vector)
 }
 
 
+void TestVectorTyped(void)
+{
+	vector_ty *vector = NULL;
+	point_ty point = {0, 0};
+	point_ty *points = NULL;
+	size_t i = 0;
+	
+	vector = VectorCreateTyped(sizeof(point_ty), 2, 0);
+
+	puts("\n==> Vector Typed");
+	printf("Element Size\t%lu\n", VectorElementSize(vector));
+	
+	for (i = 0; i < 1000; ++i)
+	{
+		point.x = (int)i;
+		point.y = -(int)i;
+		VectorPushBackValue(vector, &point);
+	}
+	
+	printf("Size\t\t%lu\n", VectorSize(vector));
+	printf("Capacity\t%lu\n\n", VectorCapacity(vector));
+	
+	point.x = 5;
+	point.y = 5;
+	VectorSetValue(vector, 500, &point);
+	VectorGetValue(vector, 500, &point);
+	printf("Get 500\t\t(%d, %d)\n", point.x, point.y);
+	printf("At 999\t\t(%d, %d)\n", ((point_ty *)VectorAt(vector, 999))->x, 
+	                                ((point_ty *)VectorAt(vector, 999))->y);
+	
+	/* elements are contiguous in the raw buffer */
+	points = VectorData(vector);
+	printf("Data 10\t\t(%d, %d)\n", points[10].x, points[10].y);
+	
+	VectorPopBackValue(vector, &point);
+	VectorPopBackValue(vector, NULL);
+	printf("PopBack\t\t(%d, %d)\n", point.x, point.y);
+	printf("Size\t\t%lu\n", VectorSize(vector));
+	
+	VectorResize(vector, 1200);
+	printf("Resize 1200\t(%d, %d)\n", ((point_ty *)VectorAt(vector, 1199))->x, 
+	                                  ((point_ty *)VectorAt(vector, 1199))->y);
+	printf("Size\t\t%lu\n", VectorSize(vector));
+	printf("Capacity\t%lu\n", VectorCapacity(vector));
+	
+	VectorDestroy(vector);
+}
+
+
+void TestVectorGrowth(void)
+{
+	vector_ty *vector = NULL;
+	const char *names[] = {"DOUBLE", "HALF", "FIXED", "PAGE"};
+	size_t i = 0;
+	int growth = 0;
+	
+	puts("\n==> Vector Growth");
+	puts("POLICY\t\tCAPACITY AFTER 1..5 GROWTHS");
+	for (growth = VECTOR_GROW_DOUBLE; growth <= VECTOR_GROW_PAGE; ++growth)
+	{
+		vector = VectorCreate(10, 0);
+		VectorSetGrowth(vector, (vector_growth_ty)growth, 10);
+		
+		printf("%s\t", names[growth]);
+		for (i = 0; i < 5; ++i)
+		{
+			while (VectorSize(vector) < VectorCapacity(vector))
+			{
+				VectorPushBack(vector, NULL);
+			}
+			VectorPushBack(vector, NULL);
+			printf("\t%lu", VectorCapacity(vector));
+		}
+		puts("");
+		
+		VectorDestroy(vector);
+	}
+	
+	/* Above 1MB the buffer is remapped, values must move along */
+	vector = VectorCreate(1, 0);
+	for (i = 0; i < 1000000; ++i)
+	{
+		VectorPushBack(vector, (void *)i);
+	}
+	
+	for (i = 0; i < 1000000 && (void *)i == VectorGet(vector, i); ++i)
+	{
+		/* empty */
+	}
+	
+	printf("\nBig Push\t%s\n", (1000000 == i) ? "values kept" : "values LOST");
+	printf("Size\t\t%lu\n", VectorSize(vector));
+	printf("Capacity\t%lu\n", VectorCapacity(vector));
+	
+	VectorShrink(vector);
+	printf("Shrink\t\t%lu\n", VectorCapacity(vector));
+	
+	VectorResize(vector, 10);
+	VectorShrink(vector);
+	printf("Shrink 10\t%lu\t%s\n", VectorCapacity(vector), 
+	       (void *)9 == VectorGet(vector, 9) ? "values kept" : "values LOST");
+	
+	VectorDestroy(vector);
+}
+
+
+void TestVectorAutoShrink(void)
+{
+	vector_ty *vector = NULL;
+	size_t i = 0;
+	size_t reallocs = 0;
+	size_t capacity = 0;
+	
+	vector = VectorCreate(16, 0);
+	
+	puts("\n==> Vector Auto Shrink");
+	puts("SIZE\t\tCAPACITY");
+	for (i = 0; i < 1024; ++i)
+	{
+		VectorPushBack(vector, (void *)i);
+	}
+	printf("%lu\t\t%lu\n", VectorSize(vector), VectorCapacity(vector));
+	
+	while (VectorSize(vector) > 0)
+	{
+		capacity = VectorCapacity(vector);
+		
+		if ((void *)(VectorSize(vector) - 1) != VectorPopBack(vector))
+		{
+			puts("PopBack returned a wrong element");
+		}
+		
+		if (capacity != VectorCapacity(vector))
+		{
+			printf("%lu\t\t%lu\n", VectorSize(vector), VectorCapacity(vector));
+		}
+	}
+	
+	/* Push / Pop on the shrink point does not reallocate each time */
+	for (i = 0; i < 1000; ++i)
+	{
+		capacity = VectorCapacity(vector);
+		VectorPushBack(vector, NULL);
+		VectorPopBack(vector);
+		reallocs += (capacity != VectorCapacity(vector));
+	}
+	printf("Thrash reallocs\t%lu\n", reallocs);
+	
+	VectorDestroy(vector);
+}
+
+
+void TestVectorSmall(void)
+{
+	vector_ty *vector = NULL;
+	point_ty point = {0, 0};
+	size_t i = 0;
+	
+	vector = VectorCreateSmall(8);
+	
+	puts("\n==> Vector Small");
+	puts("SIZE\t\tCAPACITY");
+	printf("%lu\t\t%lu\n", VectorSize(vector), VectorCapacity(vector));
+	
+	for (i = 0; i < 40; ++i)
+	{
+		VectorPushBack(vector, (void *)i);
+		
+		if (8 == i + 1 || 9 == i + 1 || 40 == i + 1)
+		{
+			printf("%lu\t\t%lu\n", VectorSize(vector), VectorCapacity(vector));
+		}
+	}
+	
+	/* Popping down to a quarter moves the elements back inline */
+	while (VectorSize(vector) > 2)
+	{
+		VectorPopBack(vector);
+	}
+	printf("%lu\t\t%lu\n", VectorSize(vector), VectorCapacity(vector));
+	printf("Values\t\t%s\n", ((void *)0 == VectorGet(vector, 0) && 
+	                           (void *)1 == VectorGet(vector, 1)) ? 
+	                           "kept" : "LOST");
+	
+	VectorDestroy(vector);
+	
+	vector = VectorCreateSmallTyped(sizeof(point_ty), 4);
+	for (i = 0; i < 100; ++i)
+	{
+		point.x = (int)i;
+		VectorPushBackValue(vector, &point);
+	}
+	VectorShrink(vector);
+	VectorResize(vector, 3);
+	VectorShrink(vector);
+	VectorGetValue(vector, 2, &point);
+	printf("\nTyped Shrink\t%lu\t(%d)\n", VectorCapacity(vector), point.x);
+	
+	VectorDestroy(vector);
+}
+
+
+void TestVectorBulk(void)
+{
+	vector_ty *vector = NULL;
+	vector_ty *other = NULL;
+	int values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	int inserted[3] = {-1, -2, -3};
+	size_t i = 0;
+	
+	vector = VectorCreateTyped(sizeof(int), 4, 0);
+	other = VectorCreateTyped(sizeof(int), 4, 0);
+	
+	puts("\n==> Vector Bulk");
+	
+	VectorPushBackN(vector, values, 10);
+	printf("PushBackN 10\tSize %lu\tCapacity %lu\tAvailable %lu\n", 
+	       VectorSize(vector), VectorCapacity(vector), VectorAvailable(vector));
+	
+	VectorInsertRange(vector, 2, inserted, 3);
+	VectorInsertRange(vector, VectorSize(vector), inserted, 1);
+	printf("InsertRange\tSize %lu\tCapacity %lu\tAvailable %lu\n", 
+	       VectorSize(vector), VectorCapacity(vector), VectorAvailable(vector));
+	
+	VectorPushBackN(other, values, 2);
+	VectorAppend(other, vector);
+	VectorAppend(other, other);
+	printf("Append\t\tSize %lu\tCapacity %lu\tAvailable %lu\n", 
+	       VectorSize(other), VectorCapacity(other), VectorAvailable(other));
+	
+	VectorEraseRange(vector, 0, 2);
+	VectorEraseRange(vector, 5, 5);
+	VectorEraseRange(vector, 8, VectorSize(vector));
+	printf("EraseRange\tSize %lu\tCapacity %lu\tAvailable %lu\n", 
+	       VectorSize(vector), VectorCapacity(vector), VectorAvailable(vector));
+	
+	printf("Vector\t\t");
+	for (i = 0; i < VectorSize(vector); ++i)
+	{
+		printf("%d ", *(int *)VectorAt(vector, i));
+	}
+	
+	printf("\nOther\t\t");
+	for (i = 0; i < VectorSize(other); ++i)
+	{
+		printf("%d ", *(int *)VectorAt(other, i));
+	}
+	puts("");
+	
+	VectorDestroy(vector);
+	VectorDestroy(other);
+}
@@ -0,0 +1,247 @@
+/*******************************************************************************
+***************************** - WORK DEQUE - **********************************
+***************************** DATA STRUCTURES **********************************
+*
+*	DESCRIPTION		Tests Work-Stealing Deque
+*	AUTHOR 			Liad Raz
+*
+*******************************************************************************/
+
+#include <stdio.h>		/* printf, puts, size_t */
+#include <pthread.h>	/* pthread_create, pthread_join */
+
+#include "utilities.h"
+#include "work_deque.h"
+
+#define THIEVES			3LU
+#define TOTAL			300000LU
+#define BURST			64LU
+
+typedef struct taker
+{
+	work_deque_ty *m_deque;
+	int *m_owner_done;
+	size_t m_taken;
+	size_t m_checksum;
+} taker_ty;
+
+
+void TestWorkDequeCreate(void);
+void TestWorkDequePushPopSteal(void);
+void TestWorkDequeThieves(void);
+
+static void *StealIMP(void *param_);
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_);
+
+
+int main(void)
+{
+	PRINT_MSG(\n\t--- Tests Work Deque ---\n);
+
+	TestWorkDequeCreate();
+	TestWorkDequePushPopSteal();
+	TestWorkDequeThieves();
+
+	return 0;
+}
+
+
+void TestWorkDequeCreate(void)
+{
+	work_deque_ty *deque = WorkDequeCreate(0);
+	void *element = NULL;
+	size_t tcounter = 0;
+
+	if (NULL != deque && 0 == WorkDequeSize(deque))
+	{ ++tcounter; }
+
+	if (SUCCESS != WorkDequePop(deque, &element) &&
+	    SUCCESS != WorkDequeSteal(deque, &element) && 0 == WorkDequeSize(deque))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Create");
+
+	WorkDequeDestroy(deque);
+}
+
+
+void TestWorkDequePushPopSteal(void)
+{
+	work_deque_ty *deque = WorkDequeCreate(2);
+	void *element = NULL;
+	size_t low = 0;
+	size_t high = 99;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	/* Grows from 2 slots to 128 */
+	for (i = 0; i < 100 && SUCCESS == WorkDequePush(deque, (void *)i); ++i)
+	{
+		/* empty */
+	}
+
+	if (100 == i && 100 == WorkDequeSize(deque))
+	{ ++tcounter; }
+
+	/* Steal takes the oldest, Pop the newest */
+	for (i = 0; i < 100; ++i)
+	{
+		if (0 == i % 2)
+		{
+			if (SUCCESS != WorkDequeSteal(deque, &element) || (void *)low != element)
+			{
+				break;
+			}
+
+			++low;
+		}
+		else
+		{
+			if (SUCCESS != WorkDequePop(deque, &element) || (void *)high != element)
+			{
+				break;
+			}
+
+			--high;
+		}
+	}
+
+	if (100 == i && 0 == WorkDequeSize(deque) && SUCCESS != WorkDequePop(deque, &element))
+	{ ++tcounter; }
+
+	/* Positions keep growing past the ring size after the deque empties */
+	for (i = 0; i < 1000; ++i)
+	{
+		WorkDequePush(deque, (void *)i);
+
+		if (SUCCESS != WorkDequePop(deque, &element) || (void *)i != element)
+		{
+			break;
+		}
+	}
+
+	if (1000 == i && 0 == WorkDequeSize(deque))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 3, "Push / Pop / Steal");
+
+	WorkDequeDestroy(deque);
+}
+
+
+void TestWorkDequeThieves(void)
+{
+	work_deque_ty *deque = WorkDequeCreate(2);
+	pthread_t threads[THIEVES];
+	taker_ty thieves[THIEVES];
+	taker_ty owner;
+	int owner_done = 0;
+	void *element = NULL;
+	size_t next = 1;
+	size_t taken = 0;
+	size_t checksum = 0;
+	size_t tcounter = 0;
+	size_t i = 0;
+
+	if (NULL == deque)
+	{
+		puts("Memory Allocation Failed");
+		return;
+	}
+
+	owner.m_taken = 0;
+	owner.m_checksum = 0;
+
+	for (i = 0; i < THIEVES; ++i)
+	{
+		thieves[i].m_deque = deque;
+		thieves[i].m_owner_done = &owner_done;
+		thieves[i].m_taken = 0;
+		thieves[i].m_checksum = 0;
+		pthread_create(&threads[i], NULL, StealIMP, &thieves[i]);
+	}
+
+	/* The owner pushes bursts, growing the ring while thieves read it, and
+		pops half of each burst back */
+	while (next <= TOTAL)
+	{
+		for (i = 0; i < BURST && next <= TOTAL; ++i, ++next)
+		{
+			WorkDequePush(deque, (void *)next);
+		}
+
+		for (i = 0; i < BURST / 2 && SUCCESS == WorkDequePop(deque, &element); ++i)
+		{
+			++owner.m_taken;
+			owner.m_checksum += (size_t)element;
+		}
+	}
+
+	while (SUCCESS == WorkDequePop(deque, &element))
+	{
+		++owner.m_taken;
+		owner.m_checksum += (size_t)element;
+	}
+
+	__atomic_store_n(&owner_done, 1, __ATOMIC_RELEASE);
+
+	taken = owner.m_taken;
+	checksum = owner.m_checksum;
+
+	for (i = 0; i < THIEVES; ++i)
+	{
+		pthread_join(threads[i], NULL);
+		taken += thieves[i].m_taken;
+		checksum += thieves[i].m_checksum;
+	}
+
+	/* Every element taken exactly once */
+	if (TOTAL == taken && TOTAL * (TOTAL + 1) / 2 == checksum)
+	{ ++tcounter; }
+
+	if (0 == WorkDequeSize(deque))
+	{ ++tcounter; }
+
+	PrintTestStatusIMP(tcounter, 2, "Owner / Thieves Threads");
+
+	WorkDequeDestroy(deque);
+}
+
+
+/* Steals until the owner is done and the deque is empty */
+static void *StealIMP(void *param_)
+{
+	taker_ty *thief = (taker_ty *)param_;
+	void *element = NULL;
+
+	while (!__atomic_load_n(thief->m_owner_done, __ATOMIC_ACQUIRE) ||
+	       0 != WorkDequeSize(thief->m_deque))
+	{
+		if (SUCCESS == WorkDequeSteal(thief->m_deque, &element))
+		{
+			++thief->m_taken;
+			thief->m_checksum += (size_t)element;
+		}
+	}
+
+	return NULL;
+}
+
+
+static void PrintTestStatusIMP(size_t tcounter_, size_t num_of_tests_, char *test_name_)
+{
+	if (tcounter_ == num_of_tests_)
+	{
+		GREEN;
+		printf("\tTest %s: SUCCESS", test_name_);
+		DEFAULT;
+	}
+	else
+	{
+		RED;
+		printf("\tTest %s: FAILED", test_name_);
+		DEFAULT;
+	}
+
+	NEW_LINE;
+}